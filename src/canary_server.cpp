@@ -20,10 +20,12 @@
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/events_scheduler.hpp"
 #include "io/iomarket.hpp"
+#include "kv/kv.hpp"
 #include "lib/thread/thread_pool.hpp"
 #include "lua/creature/events.hpp"
 #include "lua/modules/modules.hpp"
 #include "lua/scripts/lua_environment.hpp"
+#include "lua/scripts/lua_worker_pool.hpp"
 #include "lua/scripts/scripts.hpp"
 #include "server/network/protocol/protocollogin.hpp"
 #include "server/network/protocol/protocolstatus.hpp"
@@ -289,6 +291,7 @@ void CanaryServer::loadConfigLua() {
 	g_configManager().setConfigFileLua(configName);
 
 	modulesLoadHelper(g_configManager().load(), g_configManager().getConfigFileLua());
+	g_dispatcher().setWorkStealing(g_configManager().getBoolean(TOGGLE_DISPATCHER_WORK_STEALING, __FUNCTION__));
 
 #ifdef _WIN32
 	const std::string &defaultPriority = g_configManager().getString(DEFAULT_PRIORITY, __FUNCTION__);
@@ -321,6 +324,11 @@ void CanaryServer::initializeDatabase() {
 		&& !DatabaseManager::optimizeTables()) {
 		logger.debug("No tables were optimized");
 	}
+
+	g_kv().setMemoryLimit(static_cast<size_t>(g_configManager().getNumber(KV_MEMORY_LIMIT, __FUNCTION__)) * 1024 * 1024);
+	if (g_configManager().getBoolean(TOGGLE_KV_WRITE_BEHIND, __FUNCTION__)) {
+		g_kv().startWriteBehind(std::chrono::milliseconds(g_configManager().getNumber(KV_FLUSH_INTERVAL, __FUNCTION__)));
+	}
 }
 
 void CanaryServer::loadModules() {
@@ -371,6 +379,8 @@ void CanaryServer::loadModules() {
 	modulesLoadHelper(g_scripts().loadScripts(datapackFolder + "/scripts", false, false), datapackFolder + "/scripts");
 	// Load monsters
 	modulesLoadHelper(g_scripts().loadScripts(datapackFolder + "/monster", false, false), datapackFolder + "/monster");
+	// Pure functions are also loaded by the worker states, on their first call
+	g_luaWorkers().load({ coreFolder + "/scripts/pure", datapackFolder + "/scripts/pure" });
 	modulesLoadHelper((g_npcs().load(false, true)), "npc");
 
 	g_game().loadBoostedCreature();
@@ -386,6 +396,7 @@ void CanaryServer::modulesLoadHelper(bool loaded, std::string moduleName) {
 }
 
 void CanaryServer::shutdown() {
+	g_kv().stopWriteBehind();
 	g_dispatcher().shutdown();
 	g_metrics().shutdown();
 	inject<ThreadPool>().shutdown();
@@ -118,6 +118,8 @@ enum ConfigKey_t : uint16_t {
 	INVENTORY_GLOW,
 	IP,
 	KICK_AFTER_MINUTES,
+	KV_FLUSH_INTERVAL,
+	KV_MEMORY_LIMIT,
 	LOCATION,
 	LOGIN_PORT,
 	LOGLEVEL,
@@ -164,6 +166,7 @@ enum ConfigKey_t : uint16_t {
 	MYSQL_DB,
 	MYSQL_HOST,
 	MYSQL_PASS,
+	MYSQL_POOL_SIZE,
 	MYSQL_SOCK,
 	MYSQL_USER,
 	OLD_PROTOCOL,
@@ -281,17 +284,23 @@ enum ConfigKey_t : uint16_t {
 	TIBIADROME_CONCOCTION_TICK_TYPE,
 	TOGGLE_ATTACK_SPEED_ONFIST,
 	TOGGLE_CHAIN_SYSTEM,
+	TOGGLE_COMPRESSION_STREAMING,
+	TOGGLE_DISPATCHER_WORK_STEALING,
 	TOGGLE_DOWNLOAD_MAP,
 	TOGGLE_FREE_QUEST,
 	TOGGLE_GOLD_POUCH_ALLOW_ANYTHING,
 	TOGGLE_GOLD_POUCH_QUICKLOOT_ONLY,
 	TOGGLE_HAZARDSYSTEM,
+	TOGGLE_HIERARCHICAL_PATHFINDING,
 	TOGGLE_HOUSE_TRANSFER_ON_SERVER_RESTART,
 	TOGGLE_IMBUEMENT_NON_AGGRESSIVE_FIGHT_ONLY,
 	TOGGLE_IMBUEMENT_SHRINE_STORAGE,
+	TOGGLE_KV_WRITE_BEHIND,
 	TOGGLE_MAINTAIN_MODE,
 	TOGGLE_MAP_CUSTOM,
+	TOGGLE_MONSTER_SLEEP,
 	TOGGLE_MOUNT_IN_PZ,
+	TOGGLE_PARALLEL_MONSTER_THINK,
 	TOGGLE_RECEIVE_REWARD,
 	TOGGLE_SAVE_ASYNC,
 	TOGGLE_SAVE_INTERVAL_CLEAN_MAP,
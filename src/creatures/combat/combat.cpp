@@ -102,7 +102,7 @@ CombatDamage Combat::getCombatDamage(std::shared_ptr<Creature> creature, std::sh
 	return damage;
 }
 
-void Combat::getCombatArea(const Position &centerPos, const Position &targetPos, const std::unique_ptr<AreaCombat> &area, std::forward_list<std::shared_ptr<Tile>> &list) {
+void Combat::getCombatArea(const Position &centerPos, const Position &targetPos, const std::unique_ptr<AreaCombat> &area, CombatTileList &list) {
 	if (targetPos.z >= MAP_MAX_LAYERS) {
 		return;
 	}
@@ -110,7 +110,7 @@ void Combat::getCombatArea(const Position &centerPos, const Position &targetPos,
 	if (area) {
 		area->getList(centerPos, targetPos, list);
 	} else {
-		list.push_front(g_game().map.getOrCreateTile(targetPos));
+		list.emplace_back(g_game().map.getOrCreateTile(targetPos));
 	}
 }
 
@@ -1102,7 +1102,7 @@ bool Combat::doCombat(std::shared_ptr<Creature> caster, const Position &position
 }
 
 void Combat::CombatFunc(std::shared_ptr<Creature> caster, const Position &origin, const Position &pos, const std::unique_ptr<AreaCombat> &area, const CombatParams &params, CombatFunction func, CombatDamage* data) {
-	std::forward_list<std::shared_ptr<Tile>> tileList;
+	CombatTileList tileList;
 
 	if (caster) {
 		getCombatArea(caster->getPosition(), pos, area, tileList);
@@ -1114,7 +1114,7 @@ void Combat::CombatFunc(std::shared_ptr<Creature> caster, const Position &origin
 	uint32_t maxY = 0;
 
 	// calculate the max viewable range
-	for (std::shared_ptr<Tile> tile : tileList) {
+	for (const auto &tile : tileList) {
 		const Position &tilePos = tile->getPosition();
 
 		uint32_t diff = Position::getDistanceX(tilePos, pos);
@@ -1132,7 +1132,7 @@ void Combat::CombatFunc(std::shared_ptr<Creature> caster, const Position &origin
 	const int32_t rangeY = maxY + MAP_MAX_VIEW_PORT_Y;
 
 	int affected = 0;
-	for (std::shared_ptr<Tile> tile : tileList) {
+	for (const auto &tile : tileList) {
 		if (canDoCombat(caster, tile, params.aggressive) != RETURNVALUE_NOERROR) {
 			continue;
 		}
@@ -1181,13 +1181,13 @@ void Combat::CombatFunc(std::shared_ptr<Creature> caster, const Position &origin
 	}
 
 	// Wheel of destiny get beam affected total
-	auto spectators = Spectators().find<Player>(pos, true, rangeX, rangeX, rangeY, rangeY);
+	CombatBatch batch(pos, rangeX, rangeY);
 	std::shared_ptr<Player> casterPlayer = caster ? caster->getPlayer() : nullptr;
 	uint8_t beamAffectedTotal = casterPlayer ? casterPlayer->wheel()->getBeamAffectedTotal(tmpDamage) : 0;
 	uint8_t beamAffectedCurrent = 0;
 
 	tmpDamage.affected = affected;
-	for (std::shared_ptr<Tile> tile : tileList) {
+	for (const auto &tile : tileList) {
 		if (canDoCombat(caster, tile, params.aggressive) != RETURNVALUE_NOERROR) {
 			continue;
 		}
@@ -1221,7 +1221,7 @@ void Combat::CombatFunc(std::shared_ptr<Creature> caster, const Position &origin
 				}
 			}
 		}
-		combatTileEffects(spectators.data(), caster, tile, params);
+		combatTileEffects(batch.getSpectators(), caster, tile, params);
 	}
 
 	// Wheel of destiny update beam mastery damage
@@ -1229,6 +1229,7 @@ void Combat::CombatFunc(std::shared_ptr<Creature> caster, const Position &origin
 		casterPlayer->wheel()->updateBeamMasteryDamage(tmpDamage, beamAffectedTotal, beamAffectedCurrent);
 	}
 
+	batch.flush();
 	postCombatEffects(caster, origin, pos, params);
 }
 
@@ -1797,8 +1798,96 @@ bool ChainPickerCallback::onChainCombat(std::shared_ptr<Creature> creature, std:
 
 //**********************************************************//
 
+thread_local CombatBatch* CombatBatch::active = nullptr;
+
+CombatBatch::CombatBatch(const Position &centerPos, int32_t rangeX, int32_t rangeY) :
+	previous(active), centerPos(centerPos), rangeX(rangeX), rangeY(rangeY), spectators(Spectators().find<Player>(centerPos, true, rangeX, rangeX, rangeY, rangeY)) {
+	active = this;
+}
+
+CombatBatch::~CombatBatch() {
+	flush();
+	active = previous;
+}
+
+bool CombatBatch::covers(const Position &pos) const {
+	// The floors seen depend only on z, so on the floor of the cast the view of pos is covered when it fits in the range
+	return pos.z == centerPos.z
+		&& std::abs(pos.x - centerPos.x) + MAP_MAX_VIEW_PORT_X <= rangeX
+		&& std::abs(pos.y - centerPos.y) + MAP_MAX_VIEW_PORT_Y <= rangeY;
+}
+
+Spectators CombatBatch::findSpectators(const Position &pos, bool multifloor) {
+	// Leech, reflect and script heals can land outside of the area
+	if (!covers(pos)) {
+		return Spectators().find<Player>(pos, multifloor);
+	}
+
+	// Same bounds as Spectators::collect with the default view port
+	Spectators result;
+	for (const auto &spectator : spectators) {
+		const Position &specPos = spectator->getPosition();
+		if (!multifloor && specPos.z != pos.z) {
+			continue;
+		}
+
+		const int32_t offsetZ = specPos.z - pos.z;
+		const int32_t offsetX = specPos.x - pos.x + offsetZ;
+		const int32_t offsetY = specPos.y - pos.y + offsetZ;
+		if (std::abs(offsetX) <= MAP_MAX_VIEW_PORT_X && std::abs(offsetY) <= MAP_MAX_VIEW_PORT_Y) {
+			result.insert(spectator);
+		}
+	}
+	return result;
+}
+
+void CombatBatch::addTextMessage(const std::shared_ptr<Player> &player, const TextMessage &message) {
+	auto it = std::ranges::find(messages, player, &decltype(messages)::value_type::first);
+	if (it == messages.end()) {
+		it = messages.emplace(messages.end(), player, std::vector<TextMessage> {});
+	}
+
+	auto &playerMessages = it->second;
+	const auto sameKind = [&message](const TextMessage &queued) {
+		return queued.type == message.type && queued.position == message.position
+			&& queued.primary.color == message.primary.color && queued.secondary.color == message.secondary.color;
+	};
+	if (const auto queued = std::ranges::find_if(playerMessages, sameKind); queued != playerMessages.end()) {
+		// e.g. the leech of every target hit, shown as a single number
+		queued->primary.value += message.primary.value;
+		queued->secondary.value += message.secondary.value;
+		queued->text += '\n';
+		queued->text += message.text;
+		return;
+	}
+	playerMessages.emplace_back(message);
+}
+
+void CombatBatch::addHealthUpdate(const std::shared_ptr<Creature> &target) {
+	healthUpdates.insert(target);
+}
+
+void CombatBatch::flush() {
+	for (const auto &target : healthUpdates) {
+		if (!target->isRemoved()) {
+			Game::addCreatureHealth(findSpectators(target->getPosition()).data(), target);
+		}
+	}
+	healthUpdates.clear();
+
+	for (const auto &[player, playerMessages] : messages) {
+		for (const auto &message : playerMessages) {
+			player->sendTextMessage(message);
+		}
+	}
+	messages.clear();
+}
+
 void AreaCombat::clear() {
 	std::ranges::fill(areas, nullptr);
+	for (auto &dirOffsets : offsets) {
+		dirOffsets.clear();
+	}
 }
 
 AreaCombat::AreaCombat(const AreaCombat &rhs) {
@@ -1808,28 +1897,76 @@ AreaCombat::AreaCombat(const AreaCombat &rhs) {
 			areas[i] = area->clone();
 		}
 	}
+	offsets = rhs.offsets;
 }
 
-void AreaCombat::getList(const Position &centerPos, const Position &targetPos, std::forward_list<std::shared_ptr<Tile>> &list) const {
-	const std::unique_ptr<MatrixArea> &area = getArea(centerPos, targetPos);
-	if (!area) {
+void AreaCombat::getList(const Position &centerPos, const Position &targetPos, CombatTileList &list) const {
+	const auto &areaOffsets = offsets[getDirection(centerPos, targetPos)];
+	if (areaOffsets.empty()) {
 		return;
 	}
 
-	uint32_t centerY, centerX;
-	area->getCenter(centerY, centerX);
-
-	Position tmpPos(targetPos.x - centerX, targetPos.y - centerY, targetPos.z);
-	uint32_t cols = area->getCols();
-	for (uint32_t y = 0, rows = area->getRows(); y < rows; ++y) {
-		for (uint32_t x = 0; x < cols; ++x) {
-			if (area->getValue(y, x) != 0 && g_game().isSightClear(targetPos, tmpPos, true)) {
-				list.push_front(g_game().map.getOrCreateTile(tmpPos));
+	auto &map = g_game().map;
+	list.reserve(list.size() + areaOffsets.size());
+
+	// Consecutive offsets mostly share a floor block, so the quadtree is only walked when the block changes
+	const Floor* floor = nullptr;
+	int32_t blockX = -1;
+	int32_t blockY = -1;
+	for (const auto &[dx, dy] : areaOffsets) {
+		const int32_t x = targetPos.x + dx;
+		const int32_t y = targetPos.y + dy;
+		if (x < 0 || y < 0 || x > std::numeric_limits<uint16_t>::max() || y > std::numeric_limits<uint16_t>::max()) {
+			continue;
+		}
+
+		const Position tilePos(x, y, targetPos.z);
+		if (!g_game().isSightClear(targetPos, tilePos, true)) {
+			continue;
+		}
+
+		if ((x >> FLOOR_BITS) != blockX || (y >> FLOOR_BITS) != blockY) {
+			blockX = x >> FLOOR_BITS;
+			blockY = y >> FLOOR_BITS;
+			const auto leaf = map.getQTNode(tilePos.x, tilePos.y);
+			floor = leaf ? leaf->getFloor(tilePos.z).get() : nullptr;
+		}
+
+		auto tile = floor ? floor->getTile(tilePos.x, tilePos.y) : nullptr;
+		if (!tile) {
+			// Cached or missing tiles are created by the map, which may also create the floor
+			tile = map.getOrCreateTile(tilePos);
+			blockX = -1;
+		}
+		list.emplace_back(std::move(tile));
+	}
+}
+
+void AreaCombat::compileOffsets() {
+	for (uint_fast8_t i = 0; i <= Direction::DIRECTION_LAST; ++i) {
+		auto &dirOffsets = offsets[i];
+		dirOffsets.clear();
+
+		const auto &area = areas[i];
+		if (!area) {
+			continue;
+		}
+
+		uint32_t centerY, centerX;
+		area->getCenter(centerY, centerX);
+
+		// Walked backwards to keep the tile order of the former list, which was built with push_front
+		for (uint32_t y = area->getRows(); y-- > 0;) {
+			for (uint32_t x = area->getCols(); x-- > 0;) {
+				if (area->getValue(y, x)) {
+					dirOffsets.push_back({
+						static_cast<int16_t>(static_cast<int32_t>(x) - static_cast<int32_t>(centerX)),
+						static_cast<int16_t>(static_cast<int32_t>(y) - static_cast<int32_t>(centerY)),
+					});
+				}
 			}
-			tmpPos.x++;
 		}
-		tmpPos.x -= cols;
-		tmpPos.y++;
+		dirOffsets.shrink_to_fit();
 	}
 }
 
@@ -1964,6 +2101,7 @@ void AreaCombat::setupArea(const std::list<uint32_t> &list, uint32_t rows) {
 	areas[DIRECTION_SOUTH] = std::move(southArea);
 	areas[DIRECTION_EAST] = std::move(eastArea);
 	areas[DIRECTION_WEST] = std::move(westArea);
+	compileOffsets();
 }
 
 void AreaCombat::setupArea(int32_t length, int32_t spread) {
@@ -2062,6 +2200,7 @@ void AreaCombat::setupExtArea(const std::list<uint32_t> &list, uint32_t rows) {
 	areas[DIRECTION_SOUTHWEST] = std::move(swArea);
 	areas[DIRECTION_NORTHEAST] = std::move(neArea);
 	areas[DIRECTION_SOUTHEAST] = std::move(seArea);
+	compileOffsets();
 }
 
 //**********************************************************//
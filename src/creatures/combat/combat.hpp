@@ -13,6 +13,7 @@
 #include "creatures/combat/condition.hpp"
 #include "declarations.hpp"
 #include "map/map.hpp"
+#include "map/spectators.hpp"
 
 class Condition;
 class Creature;
@@ -21,6 +22,7 @@ class Spell;
 class Player;
 class MatrixArea;
 class Weapon;
+struct TextMessage;
 
 // for luascript callback
 class ValueCallback final : public CallBack {
@@ -114,6 +116,8 @@ struct CombatParams {
 };
 
 using CombatFunction = std::function<void(std::shared_ptr<Creature>, std::shared_ptr<Creature>, const CombatParams &, CombatDamage*)>;
+// Tiles hit by a single cast, inline storage covers the usual spell areas without touching the heap.
+using CombatTileList = absl::InlinedVector<std::shared_ptr<Tile>, 64>;
 
 class MatrixArea {
 public:
@@ -218,7 +222,7 @@ public:
 	// non-assignable
 	AreaCombat &operator=(const AreaCombat &) = delete;
 
-	void getList(const Position &centerPos, const Position &targetPos, std::forward_list<std::shared_ptr<Tile>> &list) const;
+	void getList(const Position &centerPos, const Position &targetPos, CombatTileList &list) const;
 
 	void setupArea(const std::list<uint32_t> &list, uint32_t rows);
 	void setupArea(int32_t length, int32_t spread);
@@ -232,9 +236,10 @@ public:
 
 private:
 	std::unique_ptr<MatrixArea> createArea(const std::list<uint32_t> &list, uint32_t rows);
+	void compileOffsets();
 	void copyArea(const std::unique_ptr<MatrixArea> &input, const std::unique_ptr<MatrixArea> &output, MatrixOperation_t op) const;
 
-	const std::unique_ptr<MatrixArea> &getArea(const Position &centerPos, const Position &targetPos) const {
+	Direction getDirection(const Position &centerPos, const Position &targetPos) const {
 		int32_t dx = Position::getOffsetX(targetPos, centerPos);
 		int32_t dy = Position::getOffsetY(targetPos, centerPos);
 
@@ -261,13 +266,67 @@ private:
 			}
 		}
 
-		return areas[dir];
+		return dir;
 	}
 
+	struct AreaOffset {
+		int16_t dx;
+		int16_t dy;
+	};
+
 	std::array<std::unique_ptr<MatrixArea>, Direction::DIRECTION_LAST + 1> areas {};
+	// Affected cells of each area relative to the target, compiled once when the area is set up.
+	std::array<std::vector<AreaOffset>, Direction::DIRECTION_LAST + 1> offsets {};
 	bool hasExtArea = false;
 };
 
+/**
+ * Client updates of a single cast.
+ *
+ * While a batch is active, Game::combatChangeHealth takes its spectators from the set
+ * found once for the whole area and queues text messages and health bars. flush()
+ * then sends each target's health only once, and merges the messages a player got
+ * for the same position and kind: the values add up and the texts are joined.
+ */
+class CombatBatch {
+public:
+	CombatBatch(const Position &centerPos, int32_t rangeX, int32_t rangeY);
+	~CombatBatch();
+
+	// non-copyable
+	CombatBatch(const CombatBatch &) = delete;
+	CombatBatch &operator=(const CombatBatch &) = delete;
+
+	static CombatBatch* getActive() {
+		return active;
+	}
+
+	const CreatureVector &getSpectators() {
+		return spectators.data();
+	}
+
+	// Same players as Spectators().find<Player>(pos, multifloor), taken from the batch when its area covers the view of pos.
+	Spectators findSpectators(const Position &pos, bool multifloor = true);
+
+	void addTextMessage(const std::shared_ptr<Player> &player, const TextMessage &message);
+	void addHealthUpdate(const std::shared_ptr<Creature> &target);
+	void flush();
+
+private:
+	static thread_local CombatBatch* active;
+
+	bool covers(const Position &pos) const;
+
+	CombatBatch* previous = nullptr;
+	Position centerPos;
+	int32_t rangeX;
+	int32_t rangeY;
+	Spectators spectators;
+
+	std::vector<std::pair<std::shared_ptr<Player>, std::vector<TextMessage>>> messages;
+	stdext::vector_set<std::shared_ptr<Creature>> healthUpdates;
+};
+
 class Combat {
 public:
 	Combat() = default;
@@ -290,7 +349,7 @@ public:
 	static void doCombatDispel(std::shared_ptr<Creature> caster, std::shared_ptr<Creature> target, const CombatParams &params);
 	static void doCombatDispel(std::shared_ptr<Creature> caster, const Position &position, const std::unique_ptr<AreaCombat> &area, const CombatParams &params);
 
-	static void getCombatArea(const Position &centerPos, const Position &targetPos, const std::unique_ptr<AreaCombat> &area, std::forward_list<std::shared_ptr<Tile>> &list);
+	static void getCombatArea(const Position &centerPos, const Position &targetPos, const std::unique_ptr<AreaCombat> &area, CombatTileList &list);
 
 	static bool isInPvpZone(std::shared_ptr<Creature> attacker, std::shared_ptr<Creature> target);
 	static bool isProtected(std::shared_ptr<Player> attacker, std::shared_ptr<Player> target);
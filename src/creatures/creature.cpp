@@ -1048,32 +1048,34 @@ void Creature::goToFollowCreature_async(std::function<void()> &&onComplete) {
 		return;
 	}
 
-	pathfinderRunning.store(true);
-	g_dispatcher().asyncEvent([self = getCreature()] {
-		self->goToFollowCreature();
-		self->pathfinderRunning.store(false);
-	});
+	if (canUpdateFollowPath()) {
+		pathfinderRunning.store(true);
+		g_pathfinder().request(getCreature());
+	}
 
 	if (onComplete) {
 		g_dispatcher().context().addEvent(std::move(onComplete));
 	}
 }
 
-void Creature::goToFollowCreature() {
-	metrics::method_latency measure(__METHOD_NAME__);
+FollowPath Creature::findFollowPath() {
+	FollowPath path;
+	path.from = getPosition();
+
 	const auto &followCreature = getFollowCreature();
 	if (!followCreature) {
-		return;
+		return path;
 	}
 
+	path.target = followCreature;
+
 	const auto &monster = getMonster();
 
 	if (isSummon() && !monster->isFamiliar() && !canFollowMaster()) {
-		listWalkDir.clear();
-		return;
+		path.cancelWalk = true;
+		return path;
 	}
 
-	bool executeOnFollow = true;
 	stdext::arraylist<Direction> listDir(128);
 
 	FindPathParams fpp;
@@ -1086,20 +1088,53 @@ void Creature::goToFollowCreature() {
 			monster->getDistanceStep(followCreature->getPosition(), dir, true);
 		} else if (!monster->getDistanceStep(followCreature->getPosition(), dir)) { // maxTargetDist > 1
 			// if we can't get anything then let the A* calculate
-			executeOnFollow = false;
+			path.executeOnFollow = false;
 		} else if (dir != DIRECTION_NONE) {
 			listDir.push_back(dir);
-			hasFollowPath = true;
+			path.hasPath = true;
 		}
 	}
 
 	if (listDir.empty()) {
-		hasFollowPath = getPathTo(followCreature->getPosition(), listDir, fpp);
+		path.hasPath = getPathTo(followCreature->getPosition(), listDir, fpp);
+	}
+
+	path.directions = listDir.data();
+	return path;
+}
+
+void Creature::onFollowPathFound(const FollowPath &path) {
+	pathfinderRunning.store(false);
+	if (isRemoved()) {
+		return;
+	}
+
+	if (path.from != getPosition()) {
+		// moved while the path was searched, it no longer starts here
+		goToFollowCreature_async();
+		return;
+	}
+
+	if (canUpdateFollowPath()) {
+		applyFollowPath(path);
+	}
+}
+
+void Creature::applyFollowPath(const FollowPath &path) {
+	const auto &followCreature = getFollowCreature();
+	if (!followCreature || followCreature != path.target.lock()) {
+		return;
+	}
+
+	if (path.cancelWalk) {
+		listWalkDir.clear();
+		return;
 	}
 
-	startAutoWalk(listDir.data());
+	hasFollowPath = path.hasPath;
+	startAutoWalk(path.directions);
 
-	if (executeOnFollow) {
+	if (path.executeOnFollow) {
 		onFollowCreatureComplete(followCreature);
 	}
 }
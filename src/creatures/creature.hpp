@@ -16,6 +16,7 @@
 #include "map/map.hpp"
 #include "game/movement/position.hpp"
 #include "items/tile.hpp"
+#include "game/scheduling/pathfinder.hpp"
 
 using ConditionList = std::list<std::shared_ptr<Condition>>;
 using CreatureEventList = std::list<std::shared_ptr<CreatureEvent>>;
@@ -298,7 +299,10 @@ public:
 	void stopEventWalk();
 
 	void goToFollowCreature_async(std::function<void()> &&onComplete = nullptr);
-	virtual void goToFollowCreature();
+
+	// Only reads the map, so it can run on the pathfinder workers.
+	FollowPath findFollowPath();
+	void onFollowPathFound(const FollowPath &path);
 
 	// walk events
 	virtual void onWalk(Direction &dir);
@@ -774,6 +778,8 @@ protected:
 	bool isUpdatingPath = false;
 	bool creatureCheck = false;
 	bool inCheckCreaturesVector = false;
+	// Skips onThink and onAttacking in Game::checkCreatures until addCreatureCheck wakes the creature.
+	bool creatureSleeping = false;
 	bool skillLoss = true;
 	bool lootDrop = true;
 	bool cancelNextWalk = false;
@@ -816,6 +822,10 @@ protected:
 		return 0;
 	}
 	virtual void getPathSearchParams(const std::shared_ptr<Creature> &, FindPathParams &fpp);
+	virtual bool canUpdateFollowPath() const {
+		return true;
+	}
+	virtual void applyFollowPath(const FollowPath &path);
 	virtual void death(std::shared_ptr<Creature>) { }
 	virtual bool dropCorpse(std::shared_ptr<Creature> lastHitCreature, std::shared_ptr<Creature> mostDamageCreature, bool lastHitUnjustified, bool mostDamageUnjustified);
 	virtual std::shared_ptr<Item> getCorpse(std::shared_ptr<Creature> lastHitCreature, std::shared_ptr<Creature> mostDamageCreature);
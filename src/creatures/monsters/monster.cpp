@@ -447,6 +447,58 @@ void Monster::onCreatureLeave(std::shared_ptr<Creature> creature) {
 	}
 }
 
+void Monster::decideThink() {
+	thinkDecision.sightChecks.clear();
+	thinkDecision.from = getPosition();
+	thinkDecision.ready = true;
+
+	if (!needsThinkDecision()) {
+		return;
+	}
+
+	// Same conditions as onThink, so only the checks it is going to make are run
+	const auto &attackedCreature = getAttackedCreature();
+	const auto &followCreature = getFollowCreature();
+	if (attackedCreature) {
+		decideSightCheck(attackedCreature);
+	}
+
+	const bool attackedCreatureIsDisconnected = attackedCreature && attackedCreature->getPlayer() && attackedCreature->getPlayer()->isDisconnected();
+	const bool attackedCreatureIsUnattackable = attackedCreature && !thinkDecision.sightChecks.back().canUseAttack;
+	const bool attackedCreatureIsUnreachable = targetDistance <= 1 && attackedCreature && followCreature && !hasFollowPath;
+	if (attackedCreature && !attackedCreatureIsDisconnected && !attackedCreatureIsUnattackable && !attackedCreatureIsUnreachable) {
+		return;
+	}
+
+	const bool searchesNearest = !followCreature || !hasFollowPath || attackedCreatureIsDisconnected;
+	const bool searchesFleeing = attackedCreature && isFleeing() && attackedCreatureIsUnattackable;
+	if ((!searchesNearest && !searchesFleeing) || targetDistance == 1) {
+		return;
+	}
+
+	for (const auto &cref : targetList) {
+		const auto &creature = cref.lock();
+		if (creature && creature != attackedCreature && isTarget(creature)) {
+			decideSightCheck(creature);
+		}
+	}
+}
+
+void Monster::decideSightCheck(const std::shared_ptr<Creature> &target) {
+	thinkDecision.sightChecks.push_back({ target->getID(), target->getPosition(), canUseAttack(thinkDecision.from, target) });
+}
+
+bool Monster::canUseAttackFromHere(const std::shared_ptr<Creature> &target) {
+	const Position &myPos = getPosition();
+	if (thinkDecision.ready && thinkDecision.from == myPos) {
+		const auto it = std::ranges::find(thinkDecision.sightChecks, target->getID(), &SightCheck::creatureId);
+		if (it != thinkDecision.sightChecks.end() && it->targetPos == target->getPosition()) {
+			return it->canUseAttack;
+		}
+	}
+	return canUseAttack(myPos, target);
+}
+
 bool Monster::searchTarget(TargetSearchType_t searchType /*= TARGETSEARCH_DEFAULT*/) {
 	if (searchType == TARGETSEARCH_DEFAULT) {
 		int32_t rnd = uniform_random(1, 100);
@@ -474,7 +526,7 @@ bool Monster::searchTarget(TargetSearchType_t searchType /*= TARGETSEARCH_DEFAUL
 	for (const auto &cref : targetList) {
 		const auto &creature = cref.lock();
 		if (creature && isTarget(creature)) {
-			if ((static_self_cast<Monster>()->targetDistance == 1) || canUseAttack(myPos, creature)) {
+			if ((static_self_cast<Monster>()->targetDistance == 1) || canUseAttackFromHere(creature)) {
 				resultList.push_back(creature);
 			}
 		}
@@ -710,6 +762,51 @@ void Monster::updateIdleStatus() {
 	setIdle(idle);
 }
 
+bool Monster::canSleep() {
+	if (!g_configManager().getBoolean(TOGGLE_MONSTER_SLEEP, __FUNCTION__)) {
+		return false;
+	}
+
+	// Scripted thinks, player summons and the walk back to the spawn must keep running unobserved
+	if (mType->info.thinkEvent != -1 || isWalkingBack) {
+		return false;
+	}
+
+	if (const auto &master = getMaster(); master && master->getPlayer()) {
+		return false;
+	}
+
+	if (g_game().map.hasPlayersAround(position)) {
+		return false;
+	}
+
+	// Fights between monsters go on unobserved, it only sleeps with nothing around to fight or to help
+	if (getAttackedCreature()) {
+		return false;
+	}
+
+	for (const auto &targetRef : targetList) {
+		if (const auto &target = targetRef.lock(); target && isTarget(target) && canSee(target->getPosition())) {
+			return false;
+		}
+	}
+
+	for (const auto &[friendId, friendRef] : friendList) {
+		if (const auto &creature = friendRef.lock(); creature && !creature->isRemoved() && creature->getAttackedCreature()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void Monster::sleep() {
+	// Any addCreatureCheck wakes it again: an opponent coming into view, a condition being added or ending
+	creatureSleeping = true;
+	if (conditions.empty()) {
+		Game::removeCreatureCheck(static_self_cast<Monster>());
+	}
+}
+
 bool Monster::isInSpawnLocation() const {
 	if (!spawnMonster) {
 		return true;
@@ -786,6 +883,11 @@ void Monster::onThink(uint32_t interval) {
 		return;
 	}
 
+	if (canSleep()) {
+		sleep();
+		return;
+	}
+
 	addEventWalk();
 
 	const auto &attackedCreature = getAttackedCreature();
@@ -805,12 +907,12 @@ void Monster::onThink(uint32_t interval) {
 		}
 	} else if (!targetList.empty()) {
 		const bool attackedCreatureIsDisconnected = attackedCreature && attackedCreature->getPlayer() && attackedCreature->getPlayer()->isDisconnected();
-		const bool attackedCreatureIsUnattackable = attackedCreature && !canUseAttack(getPosition(), attackedCreature);
+		const bool attackedCreatureIsUnattackable = attackedCreature && !canUseAttackFromHere(attackedCreature);
 		const bool attackedCreatureIsUnreachable = targetDistance <= 1 && attackedCreature && followCreature && !hasFollowPath;
 		if (!attackedCreature || attackedCreatureIsDisconnected || attackedCreatureIsUnattackable || attackedCreatureIsUnreachable) {
 			if (!followCreature || !hasFollowPath || attackedCreatureIsDisconnected) {
 				searchTarget(TARGETSEARCH_NEAREST);
-			} else if (attackedCreature && isFleeing() && !canUseAttack(getPosition(), attackedCreature)) {
+			} else if (attackedCreature && isFleeing() && attackedCreatureIsUnattackable) {
 				searchTarget(TARGETSEARCH_DEFAULT);
 			}
 		}
@@ -347,7 +347,40 @@ public:
 		return multiplier * std::pow(1.02f, getForgeStack());
 	}
 
+	// Whether onThink may check sight lines to its targets, only those monsters get a decideThink.
+	bool needsThinkDecision() const {
+		return !isSummon() && !targetList.empty();
+	}
+
+	/**
+	 * Read-only part of onThink, run by Game::checkCreatures on the thread pool.
+	 * Runs the canUseAttack checks onThink and searchTarget are going to make, which
+	 * then reuse each result while neither the monster nor the target has moved.
+	 */
+	void decideThink();
+	void clearThinkDecision() {
+		thinkDecision.sightChecks.clear();
+		thinkDecision.ready = false;
+	}
+
 private:
+	struct SightCheck {
+		uint32_t creatureId;
+		Position targetPos;
+		bool canUseAttack;
+	};
+
+	struct ThinkDecision {
+		// Position the sight lines were checked from
+		Position from;
+		std::vector<SightCheck> sightChecks;
+		bool ready = false;
+	};
+
+	// canUseAttack from the current position, answered by decideThink when it checked the same positions.
+	bool canUseAttackFromHere(const std::shared_ptr<Creature> &target);
+	void decideSightCheck(const std::shared_ptr<Creature> &target);
+
 	auto getTargetIterator(const std::shared_ptr<Creature> &creature) {
 		return std::ranges::find_if(targetList.begin(), targetList.end(), [id = creature->getID()](const std::weak_ptr<Creature> &ref) {
 			const auto &target = ref.lock();
@@ -357,6 +390,7 @@ private:
 
 	std::unordered_map<uint32_t, std::weak_ptr<Creature>> friendList;
 	std::deque<std::weak_ptr<Creature>> targetList;
+	ThinkDecision thinkDecision;
 
 	time_t timeToChangeFiendish = 0;
 
@@ -417,6 +451,8 @@ private:
 
 	void setIdle(bool idle);
 	void updateIdleStatus();
+	bool canSleep();
+	void sleep();
 	bool getIdleStatus() const {
 		return isIdle;
 	}
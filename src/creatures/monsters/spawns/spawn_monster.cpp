@@ -20,6 +20,8 @@
 #include "utils/pugicast.hpp"
 #include "game/zones/zone.hpp"
 #include "map/spectators.hpp"
+#include "lib/di/container.hpp"
+#include "lib/metrics/metrics.hpp"
 
 static constexpr int32_t MONSTER_MINSPAWN_INTERVAL = 1000; // 1 second
 static constexpr int32_t MONSTER_MAXSPAWN_INTERVAL = 86400000; // 1 day
@@ -140,39 +142,58 @@ bool SpawnsMonster::isInZone(const Position &centerPos, int32_t radius, const Po
 }
 
 void SpawnMonster::startSpawnMonsterCheck() {
-	if (checkSpawnMonsterEvent == 0) {
-		checkSpawnMonsterEvent = g_dispatcher().scheduleEvent(
-			getInterval(), [this] { checkSpawnMonster(); }, "SpawnMonster::checkSpawnMonster"
-		);
+	if (!checking) {
+		nextCheck = OTSYS_TIME() + getInterval();
+		g_spawnMonsterManager().add(this);
 	}
 }
 
 SpawnMonster::~SpawnMonster() {
-	for (const auto &[_, monster] : spawnedMonsterMap) {
-		monster->setSpawnMonster(nullptr);
+	for (const auto &monster : spawnedMonsters) {
+		if (monster) {
+			monster->setSpawnMonster(nullptr);
+		}
 	}
 	stopEvent();
-	spawnMonsterMap.clear();
+	spawnBlocks.clear();
 }
 
-bool SpawnMonster::findPlayer(const Position &pos) {
-	auto spectators = Spectators().find<Player>(pos);
-	for (const auto &spectator : spectators) {
-		if (!spectator->getPlayer()->hasFlag(PlayerFlags_t::IgnoredByMonsters)) {
-			return true;
+void SpawnMonster::findPlayers() {
+	nearPlayers.clear();
+	for (const auto &area : spawnAreas) {
+		// One lookup covering the view range of every slot of the area
+		const Position center((area.minX + area.maxX) / 2, (area.minY + area.maxY) / 2, area.z);
+		auto spectators = Spectators().find<Player>(
+			center, false,
+			center.x - area.minX + MAP_MAX_VIEW_PORT_X, area.maxX - center.x + MAP_MAX_VIEW_PORT_X,
+			center.y - area.minY + MAP_MAX_VIEW_PORT_Y, area.maxY - center.y + MAP_MAX_VIEW_PORT_Y
+		);
+		for (const auto &spectator : spectators) {
+			if (!spectator->getPlayer()->hasFlag(PlayerFlags_t::IgnoredByMonsters)) {
+				nearPlayers.emplace_back(spectator->getPosition());
+			}
 		}
 	}
-	return false;
+}
+
+bool SpawnMonster::findPlayer(const Position &pos) const {
+	return std::ranges::any_of(nearPlayers, [&pos](const Position &playerPos) {
+		return playerPos.z == pos.z
+			&& std::abs(Position::getOffsetX(playerPos, pos)) <= MAP_MAX_VIEW_PORT_X
+			&& std::abs(Position::getOffsetY(playerPos, pos)) <= MAP_MAX_VIEW_PORT_Y;
+	});
 }
 
 bool SpawnMonster::isInSpawnMonsterZone(const Position &pos) {
 	return SpawnsMonster::isInZone(centerPos, radius, pos);
 }
 
-bool SpawnMonster::spawnMonster(uint32_t spawnMonsterId, spawnBlock_t &sb, const std::shared_ptr<MonsterType> monsterType, bool startup /*= false*/) {
-	if (spawnedMonsterMap.contains(spawnMonsterId)) {
+bool SpawnMonster::spawnMonster(uint32_t slot, const std::shared_ptr<MonsterType> monsterType, bool startup /*= false*/) {
+	if (spawnedMonsters[slot]) {
 		return false;
 	}
+
+	auto &sb = spawnBlocks[slot];
 	auto monster = std::make_shared<Monster>(monsterType);
 	if (startup) {
 		// No need to send out events to the surrounding since there is no one out there to listen!
@@ -190,7 +211,8 @@ bool SpawnMonster::spawnMonster(uint32_t spawnMonsterId, spawnBlock_t &sb, const
 	monster->setSpawnMonster(this);
 	monster->setMasterPos(sb.pos);
 
-	spawnedMonsterMap[spawnMonsterId] = monster;
+	spawnedMonsters[slot] = monster;
+	++spawnedCount;
 	sb.lastSpawn = OTSYS_TIME();
 	g_events().eventMonsterOnSpawn(monster, sb.pos);
 	g_callbacks().executeCallback(EventCallback_t::monsterOnSpawn, &EventCallback::monsterOnSpawn, monster, sb.pos);
@@ -199,17 +221,14 @@ bool SpawnMonster::spawnMonster(uint32_t spawnMonsterId, spawnBlock_t &sb, const
 
 void SpawnMonster::startup(bool delayed) {
 	if (g_configManager().getBoolean(RANDOM_MONSTER_SPAWN, __FUNCTION__)) {
-		for (auto it = spawnMonsterMap.begin(); it != spawnMonsterMap.end(); ++it) {
-			auto &[spawnMonsterId, sb] = *it;
+		for (auto it = spawnBlocks.begin(); it != spawnBlocks.end(); ++it) {
+			auto &sb = *it;
 			for (auto &[monsterType, weight] : sb.monsterTypes) {
 				if (monsterType->isBoss()) {
 					continue;
 				}
-				for (auto otherIt = std::next(it); otherIt != spawnMonsterMap.end(); ++otherIt) {
-					auto &[id, otherSb] = *otherIt;
-					if (id == spawnMonsterId) {
-						continue;
-					}
+				for (auto otherIt = std::next(it); otherIt != spawnBlocks.end(); ++otherIt) {
+					auto &otherSb = *otherIt;
 					if (otherSb.hasBoss()) {
 						continue;
 					}
@@ -221,30 +240,45 @@ void SpawnMonster::startup(bool delayed) {
 				}
 			}
 		}
-	}
-	for (auto &[spawnMonsterId, sb] : spawnMonsterMap) {
-		const auto &mType = sb.getMonsterType();
-		if (!mType) {
-			continue;
+		for (auto &sb : spawnBlocks) {
+			sb.prepare();
 		}
-		if (delayed) {
-			g_dispatcher().addEvent([this, spawnMonsterId, &sb, mType] { scheduleSpawn(spawnMonsterId, sb, mType, 0, true); }, "SpawnMonster::startup");
-		} else {
-			scheduleSpawn(spawnMonsterId, sb, mType, 0, true);
+	}
+
+	const auto spawnAll = [this] {
+		for (uint32_t slot = 0; slot < spawnBlocks.size(); ++slot) {
+			const auto &mType = spawnBlocks[slot].getMonsterType();
+			if (!mType) {
+				continue;
+			}
+			scheduleSpawn(slot, mType, 0, true);
 		}
+	};
+
+	if (delayed) {
+		g_dispatcher().addEvent(spawnAll, "SpawnMonster::startup");
+	} else {
+		spawnAll();
 	}
 }
 
-void SpawnMonster::checkSpawnMonster() {
-	if (checkSpawnMonsterEvent == 0) {
-		return;
+bool SpawnMonster::think(int64_t now) {
+	if (now >= nextCheck) {
+		checkSpawnMonster(now);
+		nextCheck = now + getInterval();
 	}
 
-	checkSpawnMonsterEvent = 0;
+	checkPendingSpawns(now);
+	return spawnedCount < spawnBlocks.size();
+}
+
+void SpawnMonster::checkSpawnMonster(int64_t now) {
 	cleanup();
 
-	for (auto &[spawnMonsterId, sb] : spawnMonsterMap) {
-		if (spawnedMonsterMap.contains(spawnMonsterId)) {
+	bool playersFound = false;
+	for (uint32_t slot = 0; slot < spawnBlocks.size(); ++slot) {
+		auto &sb = spawnBlocks[slot];
+		if (spawnedMonsters[slot] || sb.pendingSpawn) {
 			continue;
 		}
 
@@ -252,50 +286,68 @@ void SpawnMonster::checkSpawnMonster() {
 		if (!mType) {
 			continue;
 		}
+		if (mType->info.isBlockable && !playersFound) {
+			findPlayers();
+			playersFound = true;
+		}
 		if (!mType->canSpawn(sb.pos) || (mType->info.isBlockable && findPlayer(sb.pos))) {
-			sb.lastSpawn = OTSYS_TIME();
+			sb.lastSpawn = now;
 			continue;
 		}
-		if (OTSYS_TIME() < sb.lastSpawn + sb.interval) {
+		if (now < sb.lastSpawn + sb.interval) {
 			continue;
 		}
 
 		if (mType->info.isBlockable) {
-			spawnMonster(spawnMonsterId, sb, mType);
+			spawnMonster(slot, mType);
 		} else {
-			scheduleSpawn(spawnMonsterId, sb, mType, 3 * NONBLOCKABLE_SPAWN_MONSTER_INTERVAL);
+			scheduleSpawn(slot, mType, 3 * NONBLOCKABLE_SPAWN_MONSTER_INTERVAL);
 		}
 	}
+}
 
-	if (spawnedMonsterMap.size() < spawnMonsterMap.size()) {
-		checkSpawnMonsterEvent = g_dispatcher().scheduleEvent(
-			getInterval(), [this] { checkSpawnMonster(); }, "SpawnMonster::checkSpawnMonster"
-		);
+void SpawnMonster::checkPendingSpawns(int64_t now) {
+	if (pendingSpawns.empty()) {
+		return;
+	}
+
+	// scheduleSpawn can queue the next step, so the due ones are taken out first
+	std::vector<PendingSpawn> dueSpawns;
+	std::erase_if(pendingSpawns, [&](PendingSpawn &pending) {
+		if (now < pending.nextStep) {
+			return false;
+		}
+		dueSpawns.emplace_back(std::move(pending));
+		return true;
+	});
+
+	for (auto &pending : dueSpawns) {
+		spawnBlocks[pending.slot].pendingSpawn = false;
+		scheduleSpawn(pending.slot, pending.monsterType, pending.remaining, pending.startup);
 	}
 }
 
-void SpawnMonster::scheduleSpawn(uint32_t spawnMonsterId, spawnBlock_t &sb, const std::shared_ptr<MonsterType> mType, uint16_t interval, bool startup /*= false*/) {
+void SpawnMonster::scheduleSpawn(uint32_t slot, const std::shared_ptr<MonsterType> mType, int32_t interval, bool startup /*= false*/) {
 	if (interval <= 0) {
-		spawnMonster(spawnMonsterId, sb, mType, startup);
+		spawnMonster(slot, mType, startup);
 	} else {
+		auto &sb = spawnBlocks[slot];
 		g_game().addMagicEffect(sb.pos, CONST_ME_TELEPORT);
-		g_dispatcher().scheduleEvent(
-			NONBLOCKABLE_SPAWN_MONSTER_INTERVAL, [=, this, &sb] { scheduleSpawn(spawnMonsterId, sb, mType, interval - NONBLOCKABLE_SPAWN_MONSTER_INTERVAL, startup); }, "SpawnMonster::scheduleSpawn"
-		);
+		sb.pendingSpawn = true;
+		pendingSpawns.push_back({ slot, mType, OTSYS_TIME() + NONBLOCKABLE_SPAWN_MONSTER_INTERVAL, interval - NONBLOCKABLE_SPAWN_MONSTER_INTERVAL, startup });
+		startSpawnMonsterCheck();
 	}
 }
 
 void SpawnMonster::cleanup() {
-	std::vector<uint32_t> removeList;
-	for (const auto &[spawnMonsterId, monster] : spawnedMonsterMap) {
-		if (monster == nullptr || monster->isRemoved()) {
-			removeList.push_back(spawnMonsterId);
+	for (uint32_t slot = 0; slot < spawnedMonsters.size(); ++slot) {
+		auto &monster = spawnedMonsters[slot];
+		if (monster && monster->isRemoved()) {
+			spawnBlocks[slot].lastSpawn = OTSYS_TIME();
+			monster = nullptr;
+			--spawnedCount;
 		}
 	}
-	for (const auto &spawnMonsterId : removeList) {
-		spawnMonsterMap[spawnMonsterId].lastSpawn = OTSYS_TIME();
-		spawnedMonsterMap.erase(spawnMonsterId);
-	}
 }
 
 bool SpawnMonster::addMonster(const std::string &name, const Position &pos, Direction dir, uint32_t scheduleInterval, uint32_t weight /*= 1*/) {
@@ -330,11 +382,9 @@ bool SpawnMonster::addMonster(const std::string &name, const Position &pos, Dire
 	this->interval = std::gcd(this->interval, scheduleInterval);
 
 	spawnBlock_t* sb = nullptr;
-	uint32_t spawnMonsterId = spawnMonsterMap.size() + 1;
-	for (auto &[id, maybeSb] : spawnMonsterMap) {
+	for (auto &maybeSb : spawnBlocks) {
 		if (maybeSb.pos == pos) {
 			sb = &maybeSb;
-			spawnMonsterId = id;
 			break;
 		}
 	}
@@ -353,36 +403,50 @@ bool SpawnMonster::addMonster(const std::string &name, const Position &pos, Dire
 		}
 	}
 	if (!sb) {
-		sb = &spawnMonsterMap.emplace(spawnMonsterId, spawnBlock_t()).first->second;
+		sb = &spawnBlocks.emplace_back();
+		spawnedMonsters.emplace_back();
+
+		auto areaIt = std::ranges::find_if(spawnAreas, [&pos](const SpawnArea &area) {
+			return area.z == pos.z;
+		});
+		if (areaIt == spawnAreas.end()) {
+			spawnAreas.push_back({ pos.x, pos.x, pos.y, pos.y, pos.z });
+		} else {
+			areaIt->minX = std::min(areaIt->minX, pos.x);
+			areaIt->maxX = std::max(areaIt->maxX, pos.x);
+			areaIt->minY = std::min(areaIt->minY, pos.y);
+			areaIt->maxY = std::max(areaIt->maxY, pos.y);
+		}
 	}
 	sb->monsterTypes.emplace(monsterType, weight);
 	sb->pos = pos;
 	sb->direction = dir;
 	sb->interval = scheduleInterval;
 	sb->lastSpawn = 0;
+	sb->prepare();
 	return true;
 }
 
 void SpawnMonster::removeMonster(std::shared_ptr<Monster> monster) {
-	uint32_t spawnMonsterId = 0;
-	for (const auto &[id, m] : spawnedMonsterMap) {
-		if (m == monster) {
-			spawnMonsterId = id;
-			break;
-		}
+	auto it = std::ranges::find(spawnedMonsters, monster);
+	if (it != spawnedMonsters.end()) {
+		*it = nullptr;
+		--spawnedCount;
 	}
-	spawnedMonsterMap.erase(spawnMonsterId);
 }
 
 void SpawnMonster::removeMonsters() {
-	spawnMonsterMap.clear();
-	spawnedMonsterMap.clear();
+	spawnBlocks.clear();
+	spawnedMonsters.clear();
+	spawnedCount = 0;
+	spawnAreas.clear();
+	pendingSpawns.clear();
 }
 
 void SpawnMonster::setMonsterVariant(const std::string &variant) {
-	for (auto &it : spawnMonsterMap) {
+	for (auto &sb : spawnBlocks) {
 		std::unordered_map<std::shared_ptr<MonsterType>, uint32_t> monsterTypes;
-		for (const auto &[monsterType, weight] : it.second.monsterTypes) {
+		for (const auto &[monsterType, weight] : sb.monsterTypes) {
 			if (!monsterType || monsterType->typeName.empty()) {
 				continue;
 			}
@@ -392,22 +456,91 @@ void SpawnMonster::setMonsterVariant(const std::string &variant) {
 				monsterTypes.emplace(variantType, weight);
 			}
 		}
-		it.second.monsterTypes = monsterTypes;
+		sb.monsterTypes = monsterTypes;
+		sb.prepare();
 	}
 }
 
 void SpawnMonster::stopEvent() {
-	if (checkSpawnMonsterEvent != 0) {
-		g_dispatcher().stopEvent(checkSpawnMonsterEvent);
-		checkSpawnMonsterEvent = 0;
+	if (checking) {
+		g_spawnMonsterManager().remove(this);
+	}
+	for (const auto &pending : pendingSpawns) {
+		spawnBlocks[pending.slot].pendingSpawn = false;
+	}
+	pendingSpawns.clear();
+}
+
+SpawnMonsterManager &SpawnMonsterManager::getInstance() {
+	return inject<SpawnMonsterManager>();
+}
+
+void SpawnMonsterManager::add(SpawnMonster* spawnMonster) {
+	spawnMonster->checking = true;
+	spawns.emplace_back(spawnMonster);
+	++activeCount;
+
+	if (eventId == 0) {
+		eventId = g_dispatcher().cycleEvent(
+			SPAWN_MONSTER_CHECK_TICK, [this] { check(); }, "SpawnMonsterManager::check"
+		);
+	}
+}
+
+void SpawnMonsterManager::remove(SpawnMonster* spawnMonster) {
+	// Only cleared here, the list is compacted by check() so it can be called while checking
+	auto it = std::ranges::find(spawns, spawnMonster);
+	if (it != spawns.end()) {
+		*it = nullptr;
+		--activeCount;
+	}
+	spawnMonster->checking = false;
+}
+
+void SpawnMonsterManager::check() {
+	metrics::method_latency measure(__METHOD_NAME__);
+
+	const int64_t now = OTSYS_TIME();
+	// Spawns added while checking are appended and handled on the next tick
+	const size_t count = spawns.size();
+	for (size_t i = 0; i < count; ++i) {
+		SpawnMonster* spawnMonster = spawns[i];
+		if (spawnMonster && !spawnMonster->think(now)) {
+			remove(spawnMonster);
+		}
+	}
+
+	std::erase(spawns, nullptr);
+
+	if (spawns.empty() && eventId != 0) {
+		g_dispatcher().stopEvent(eventId);
+		eventId = 0;
 	}
 }
 
 std::shared_ptr<MonsterType> spawnBlock_t::getMonsterType() const {
-	if (monsterTypes.empty()) {
+	if (boss) {
+		return boss;
+	}
+	if (totalWeight == 0) {
 		return nullptr;
 	}
-	uint32_t totalWeight = 0;
+
+	uint32_t randomWeight = uniform_random(0, totalWeight - 1);
+	for (const auto &[mType, weight] : orderedMonsterTypes) {
+		if (randomWeight < weight) {
+			return mType;
+		}
+		randomWeight -= weight;
+	}
+	return nullptr;
+}
+
+void spawnBlock_t::prepare() {
+	orderedMonsterTypes.clear();
+	boss = nullptr;
+	totalWeight = 0;
+
 	for (const auto &[mType, weight] : monsterTypes) {
 		if (!mType) {
 			continue;
@@ -416,23 +549,17 @@ std::shared_ptr<MonsterType> spawnBlock_t::getMonsterType() const {
 			if (monsterTypes.size() > 1) {
 				g_logger().warn("[SpawnMonster] Boss monster {} has been added to spawn block with other monsters. This is not allowed.", mType->name);
 			}
-			return mType;
+			boss = mType;
+			return;
 		}
+		orderedMonsterTypes.emplace_back(mType, weight);
 		totalWeight += weight;
 	}
-	uint32_t randomWeight = uniform_random(0, totalWeight - 1);
+
 	// order monsters by weight DESC
-	std::vector<std::pair<std::shared_ptr<MonsterType>, uint32_t>> orderedMonsterTypes(monsterTypes.begin(), monsterTypes.end());
-	std::sort(orderedMonsterTypes.begin(), orderedMonsterTypes.end(), [](const auto &a, const auto &b) {
+	std::ranges::stable_sort(orderedMonsterTypes, [](const auto &a, const auto &b) {
 		return a.second > b.second;
 	});
-	for (const auto &[mType, weight] : orderedMonsterTypes) {
-		if (randomWeight < weight) {
-			return mType;
-		}
-		randomWeight -= weight;
-	}
-	return nullptr;
 }
 
 bool spawnBlock_t::hasBoss() const {
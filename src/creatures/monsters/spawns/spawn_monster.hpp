@@ -24,6 +24,14 @@ struct spawnBlock_t {
 
 	std::shared_ptr<MonsterType> getMonsterType() const;
 	bool hasBoss() const;
+	// Caches the weight table used by getMonsterType, must be called whenever monsterTypes changes.
+	void prepare();
+
+	// Monster types ordered by weight DESC
+	std::vector<std::pair<std::shared_ptr<MonsterType>, uint32_t>> orderedMonsterTypes;
+	std::shared_ptr<MonsterType> boss;
+	uint32_t totalWeight = 0;
+	bool pendingSpawn = false;
 };
 
 class SpawnMonster {
@@ -58,24 +66,84 @@ public:
 	void setMonsterVariant(const std::string &variant);
 
 private:
-	// map of the spawned creatures
-	std::map<uint32_t, std::shared_ptr<Monster>> spawnedMonsterMap;
-
-	// map of creatures in the spawn
-	std::map<uint32_t, spawnBlock_t> spawnMonsterMap;
+	// Bounds of the spawn slots of a floor, players are looked up once per area.
+	struct SpawnArea {
+		uint16_t minX;
+		uint16_t maxX;
+		uint16_t minY;
+		uint16_t maxY;
+		uint8_t z;
+	};
+
+	// A non blockable spawn showing its teleport effect until the monster appears.
+	struct PendingSpawn {
+		uint32_t slot;
+		std::shared_ptr<MonsterType> monsterType;
+		int64_t nextStep;
+		int32_t remaining;
+		bool startup;
+	};
+
+	// Spawn slots and the monster spawned by each of them, both indexed by the slot.
+	std::vector<spawnBlock_t> spawnBlocks;
+	std::vector<std::shared_ptr<Monster>> spawnedMonsters;
+	size_t spawnedCount = 0;
+
+	std::vector<SpawnArea> spawnAreas;
+	std::vector<PendingSpawn> pendingSpawns;
+	// Players not ignored by monsters, filled once per check and only if a slot needs them.
+	std::vector<Position> nearPlayers;
 
 	Position centerPos;
 	int32_t radius;
 
 	uint32_t interval = 30000;
-	uint32_t checkSpawnMonsterEvent = 0;
+	int64_t nextCheck = 0;
+	bool checking = false;
+
+	void findPlayers();
+	bool findPlayer(const Position &pos) const;
+	bool spawnMonster(uint32_t slot, const std::shared_ptr<MonsterType> monsterType, bool startup = false);
+	bool think(int64_t now);
+	void checkSpawnMonster(int64_t now);
+	void checkPendingSpawns(int64_t now);
+	void scheduleSpawn(uint32_t slot, const std::shared_ptr<MonsterType> monsterType, int32_t interval, bool startup = false);
+
+	friend class SpawnMonsterManager;
+};
+
+/**
+ * Runs every active monster spawn from a single dispatcher event, so all the
+ * respawns due in the same tick are checked in one batch instead of each spawn
+ * (and each non blockable respawn) scheduling its own event.
+ */
+class SpawnMonsterManager {
+public:
+	SpawnMonsterManager() = default;
+
+	// non-copyable
+	SpawnMonsterManager(const SpawnMonsterManager &) = delete;
+	void operator=(const SpawnMonsterManager &) = delete;
 
-	static bool findPlayer(const Position &pos);
-	bool spawnMonster(uint32_t spawnMonsterId, spawnBlock_t &sb, const std::shared_ptr<MonsterType> monsterType, bool startup = false);
-	void checkSpawnMonster();
-	void scheduleSpawn(uint32_t spawnMonsterId, spawnBlock_t &sb, const std::shared_ptr<MonsterType> monsterType, uint16_t interval, bool startup = false);
+	static SpawnMonsterManager &getInstance();
+
+	void add(SpawnMonster* spawnMonster);
+	void remove(SpawnMonster* spawnMonster);
+
+	size_t size() const {
+		return activeCount;
+	}
+
+private:
+	void check();
+
+	std::vector<SpawnMonster*> spawns;
+	size_t activeCount = 0;
+	uint64_t eventId = 0;
 };
 
+constexpr auto g_spawnMonsterManager = SpawnMonsterManager::getInstance;
+
 class SpawnsMonster {
 public:
 	static bool isInZone(const Position &centerPos, int32_t radius, const Position &pos);
@@ -106,3 +174,4 @@ private:
 };
 
 static constexpr int32_t NONBLOCKABLE_SPAWN_MONSTER_INTERVAL = 1400;
+static constexpr int32_t SPAWN_MONSTER_CHECK_TICK = 100;
@@ -893,12 +893,16 @@ void Player::addStorageValue(const uint32_t key, const int32_t value, const bool
 		storageMap[key] = value;
 
 		if (!isLogin) {
+			if (oldValue != value) {
+				saveState.setStorageDirty();
+			}
+
 			auto currentFrameTime = g_dispatcher().getDispatcherCycle();
 			g_events().eventOnStorageUpdate(static_self_cast<Player>(), key, value, oldValue, currentFrameTime);
 			g_callbacks().executeCallback(EventCallback_t::playerOnStorageUpdate, &EventCallback::playerOnStorageUpdate, getPlayer(), key, value, oldValue, currentFrameTime);
 		}
-	} else {
-		storageMap.erase(key);
+	} else if (storageMap.erase(key) != 0) {
+		saveState.setStorageDirty();
 	}
 }
 
@@ -4323,17 +4327,15 @@ bool Player::setAttackedCreature(std::shared_ptr<Creature> creature) {
 	return true;
 }
 
-void Player::goToFollowCreature() {
-	if (!walkTask) {
-		if ((OTSYS_TIME() - lastFailedFollow) < 2000) {
-			return;
-		}
+bool Player::canUpdateFollowPath() const {
+	return !walkTask && (OTSYS_TIME() - lastFailedFollow) >= 2000;
+}
 
-		Creature::goToFollowCreature();
+void Player::applyFollowPath(const FollowPath &path) {
+	Creature::applyFollowPath(path);
 
-		if (getFollowCreature() && !hasFollowPath) {
-			lastFailedFollow = OTSYS_TIME();
-		}
+	if (getFollowCreature() && !hasFollowPath) {
+		lastFailedFollow = OTSYS_TIME();
 	}
 }
 
@@ -4931,15 +4933,23 @@ bool Player::canLogout() {
 }
 
 void Player::genReservedStorageRange() {
+	const auto setReservedValue = [this](uint32_t key, int32_t value) {
+		auto [it, inserted] = storageMap.try_emplace(key, value);
+		if (inserted || it->second != value) {
+			it->second = value;
+			saveState.setStorageDirty();
+		}
+	};
+
 	// generate outfits range
 	uint32_t outfits_key = PSTRG_OUTFITS_RANGE_START;
 	for (const OutfitEntry &entry : outfits) {
-		storageMap[++outfits_key] = (entry.lookType << 16) | entry.addons;
+		setReservedValue(++outfits_key, (entry.lookType << 16) | entry.addons);
 	}
 	// generate familiars range
 	uint32_t familiar_key = PSTRG_FAMILIARS_RANGE_START;
 	for (const FamiliarEntry &entry : familiars) {
-		storageMap[++familiar_key] = (entry.lookType << 16);
+		setReservedValue(++familiar_key, (entry.lookType << 16));
 	}
 }
 
@@ -23,6 +23,7 @@
 #include "items/containers/inbox/inbox.hpp"
 #include "io/ioguild.hpp"
 #include "io/ioprey.hpp"
+#include "io/functions/player_save_state.hpp"
 #include "creatures/appearance/mounts/mounts.hpp"
 #include "creatures/appearance/outfit/outfit.hpp"
 #include "grouping/party.hpp"
@@ -825,7 +826,6 @@ public:
 
 	// follow functions
 	bool setFollowCreature(std::shared_ptr<Creature> creature) override;
-	void goToFollowCreature() override;
 
 	// follow events
 	void onFollowCreature(const std::shared_ptr<Creature> &) override;
@@ -1334,11 +1334,21 @@ public:
 			client->sendChangeSpeed(creature, newSpeed);
 		}
 	}
+	void sendChangeSpeed(BroadcastPacket &packet) const {
+		if (client) {
+			client->sendChangeSpeed(packet);
+		}
+	}
 	void sendCreatureHealth(std::shared_ptr<Creature> creature) const {
 		if (client) {
 			client->sendCreatureHealth(creature);
 		}
 	}
+	void sendCreatureHealth(std::shared_ptr<Creature> creature, BroadcastPacket &packet) const {
+		if (client) {
+			client->sendCreatureHealth(creature, packet);
+		}
+	}
 	void sendPartyCreatureUpdate(std::shared_ptr<Creature> creature) const {
 		if (client) {
 			client->sendPartyCreatureUpdate(creature);
@@ -1384,6 +1394,11 @@ public:
 			client->sendDistanceShoot(from, to, type);
 		}
 	}
+	void sendDistanceShoot(const Position &from, const Position &to, uint16_t type, BroadcastPacket &packet) const {
+		if (client) {
+			client->sendDistanceShoot(from, to, type, packet);
+		}
+	}
 	void sendHouseWindow(std::shared_ptr<House> house, uint32_t listId) const;
 	void sendCreatePrivateChannel(uint16_t channelId, const std::string &channelName) {
 		if (client) {
@@ -1411,6 +1426,11 @@ public:
 			client->sendMagicEffect(pos, type);
 		}
 	}
+	void sendMagicEffect(const Position &pos, uint16_t type, BroadcastPacket &packet) const {
+		if (client) {
+			client->sendMagicEffect(pos, type, packet);
+		}
+	}
 	void removeMagicEffect(const Position &pos, uint16_t type) const {
 		if (client) {
 			client->removeMagicEffect(pos, type);
@@ -2685,6 +2705,8 @@ private:
 	std::map<uint32_t, int32_t> storageMap;
 	std::map<uint16_t, uint64_t> itemPriceMap;
 
+	PlayerSaveState saveState;
+
 	std::map<uint8_t, uint16_t> maxValuePerSkill = {
 		{ SKILL_LIFE_LEECH_CHANCE, 100 },
 		{ SKILL_MANA_LEECH_CHANCE, 100 },
@@ -2957,6 +2979,8 @@ private:
 
 	uint16_t getLookCorpse() const override;
 	void getPathSearchParams(const std::shared_ptr<Creature> &creature, FindPathParams &fpp) override;
+	bool canUpdateFollowPath() const override;
+	void applyFollowPath(const FollowPath &path) override;
 
 	void setDead(bool isDead) {
 		dead = isDead;
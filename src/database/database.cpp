@@ -14,9 +14,62 @@
 #include "lib/di/container.hpp"
 #include "lib/metrics/metrics.hpp"
 
+thread_local Database::Connection* Database::transactionConnection = nullptr;
+thread_local uint32_t Database::transactionDepth = 0;
+thread_local bool Database::transactionFailed = false;
+thread_local uint64_t Database::lastInsertId = 0;
+
+/**
+ * Uses the connection of the transaction of the calling thread or checks out one
+ * from the pool, giving it back when destroyed.
+ */
+class Database::ConnectionGuard {
+public:
+	explicit ConnectionGuard(Database &db) :
+		db(db), connection(transactionConnection) {
+		if (!connection) {
+			connection = db.acquire();
+			owned = connection != nullptr;
+		}
+	}
+
+	~ConnectionGuard() {
+		if (owned) {
+			db.release(connection);
+		}
+	}
+
+	// non-copyable
+	ConnectionGuard(const ConnectionGuard &) = delete;
+	ConnectionGuard &operator=(const ConnectionGuard &) = delete;
+
+	explicit operator bool() const {
+		return connection != nullptr;
+	}
+
+	Connection &operator*() const {
+		return *connection;
+	}
+
+	Connection* operator->() const {
+		return connection;
+	}
+
+private:
+	Database &db;
+	Connection* connection;
+	bool owned = false;
+};
+
 Database::~Database() {
-	if (handle != nullptr) {
-		mysql_close(handle);
+	for (const auto &connection : connections) {
+		closeStatements(*connection);
+		if (connection->handle != nullptr) {
+			mysql_close(connection->handle);
+		}
+	}
+	if (escapeConnection.handle != nullptr) {
+		mysql_close(escapeConnection.handle);
 	}
 }
 
@@ -25,31 +78,37 @@ Database &Database::getInstance() {
 }
 
 bool Database::connect() {
-	return connect(&g_configManager().getString(MYSQL_HOST, __FUNCTION__), &g_configManager().getString(MYSQL_USER, __FUNCTION__), &g_configManager().getString(MYSQL_PASS, __FUNCTION__), &g_configManager().getString(MYSQL_DB, __FUNCTION__), g_configManager().getNumber(SQL_PORT, __FUNCTION__), &g_configManager().getString(MYSQL_SOCK, __FUNCTION__));
+	return connect(&g_configManager().getString(MYSQL_HOST, __FUNCTION__), &g_configManager().getString(MYSQL_USER, __FUNCTION__), &g_configManager().getString(MYSQL_PASS, __FUNCTION__), &g_configManager().getString(MYSQL_DB, __FUNCTION__), g_configManager().getNumber(SQL_PORT, __FUNCTION__), &g_configManager().getString(MYSQL_SOCK, __FUNCTION__), std::max<int32_t>(1, g_configManager().getNumber(MYSQL_POOL_SIZE, __FUNCTION__)));
 }
 
-bool Database::connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock) {
-	// connection handle initialization
-	handle = mysql_init(nullptr);
-	if (!handle) {
-		g_logger().error("Failed to initialize MySQL connection handle.");
-		return false;
-	}
-
+bool Database::connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock, uint32_t poolSize /* = 1*/) {
 	if (host->empty() || user->empty() || password->empty() || database->empty() || port <= 0) {
 		g_logger().warn("MySQL host, user, password, database or port not provided");
 	}
 
-	// automatic reconnect
-	bool reconnect = true;
-	mysql_options(handle, MYSQL_OPT_RECONNECT, &reconnect);
+	this->host = *host;
+	this->user = *user;
+	this->password = *password;
+	this->database = *database;
+	this->port = port;
+	this->sock = *sock;
 
-	// connects to database
-	if (!mysql_real_connect(handle, host->c_str(), user->c_str(), password->c_str(), database->c_str(), port, sock->c_str(), 0)) {
-		g_logger().error("MySQL Error Message: {}", mysql_error(handle));
+	if (!openConnection(escapeConnection)) {
 		return false;
 	}
 
+	connections.reserve(poolSize);
+	idleConnections.reserve(poolSize);
+	for (uint32_t i = 0; i < poolSize; ++i) {
+		auto connection = std::make_unique<Connection>();
+		if (!openConnection(*connection)) {
+			return false;
+		}
+		idleConnections.emplace_back(connection.get());
+		connections.emplace_back(std::move(connection));
+	}
+	g_logger().debug("Opened {} database connections", connections.size());
+
 	DBResult_ptr result = storeQuery("SHOW VARIABLES LIKE 'max_allowed_packet'");
 	if (result) {
 		maxPacketSize = result->getNumber<uint64_t>("Value");
@@ -57,60 +116,175 @@ bool Database::connect(const std::string* host, const std::string* user, const s
 	return true;
 }
 
-bool Database::beginTransaction() {
-	if (!executeQuery("BEGIN")) {
+bool Database::openConnection(Connection &connection) const {
+	closeStatements(connection);
+	if (connection.handle != nullptr) {
+		mysql_close(connection.handle);
+	}
+
+	// connection handle initialization
+	connection.handle = mysql_init(nullptr);
+	if (!connection.handle) {
+		g_logger().error("Failed to initialize MySQL connection handle.");
+		return false;
+	}
+
+	// connects to database
+	if (!mysql_real_connect(connection.handle, host.c_str(), user.c_str(), password.c_str(), database.c_str(), port, sock.c_str(), 0)) {
+		g_logger().error("MySQL Error Message: {}", mysql_error(connection.handle));
+		return false;
+	}
+
+	connection.lastUsed = std::chrono::steady_clock::now();
+	return true;
+}
+
+bool Database::checkConnection(Connection &connection) const {
+	if (mysql_ping(connection.handle) == 0) {
+		return true;
+	}
+
+	g_logger().warn("Database connection lost, reconnecting. MySQL error [{}]: {}", mysql_errno(connection.handle), mysql_error(connection.handle));
+	return openConnection(connection);
+}
+
+bool Database::recoverConnection(Connection &connection) {
+	// The open transaction is gone with the session, a new one would run the rest of it in autocommit
+	if (&connection == transactionConnection) {
+		g_logger().error("Database connection lost during a transaction, the transaction fails");
+		transactionFailed = true;
 		return false;
 	}
+
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+	checkConnection(connection);
+	return true;
+}
+
+bool Database::hasFailedTransaction(const Connection &connection) const {
+	return transactionFailed && &connection == transactionConnection;
+}
+
+Database::Connection* Database::acquire() {
+	if (connections.empty()) {
+		return nullptr;
+	}
+
 	metrics::lock_latency measureLock("database");
-	databaseLock.lock();
+	std::unique_lock lock { poolMutex };
+	poolCondition.wait(lock, [this] { return !idleConnections.empty(); });
+	Connection* connection = idleConnections.back();
+	idleConnections.pop_back();
+	lock.unlock();
 	measureLock.stop();
 
-	return true;
+	if (std::chrono::steady_clock::now() - connection->lastUsed > CONNECTION_CHECK_INTERVAL) {
+		checkConnection(*connection);
+	}
+	return connection;
 }
 
-bool Database::rollback() {
-	if (!handle) {
+void Database::release(Connection* connection) {
+	connection->lastUsed = std::chrono::steady_clock::now();
+	{
+		std::scoped_lock lock { poolMutex };
+		idleConnections.emplace_back(connection);
+	}
+	poolCondition.notify_one();
+}
+
+bool Database::beginTransaction() {
+	// Nested transactions join the outer one, recorded queries get their own when executed
+	if (transactionDepth++ > 0 || DBQueryRecorder::current()) {
+		return true;
+	}
+
+	Connection* connection = acquire();
+	if (!connection) {
 		g_logger().error("Database not initialized!");
+		transactionDepth = 0;
 		return false;
 	}
 
-	if (mysql_rollback(handle) != 0) {
-		g_logger().error("Message: {}", mysql_error(handle));
-		databaseLock.unlock();
+	if (!retryQuery(*connection, "BEGIN", 10)) {
+		release(connection);
+		transactionDepth = 0;
 		return false;
 	}
 
-	databaseLock.unlock();
+	transactionConnection = connection;
 	return true;
 }
 
+bool Database::rollback() {
+	if (transactionDepth == 0) {
+		g_logger().error("Database transaction not started!");
+		return false;
+	}
+
+	if (--transactionDepth > 0 || !transactionConnection) {
+		return true;
+	}
+
+	Connection* connection = std::exchange(transactionConnection, nullptr);
+	if (std::exchange(transactionFailed, false)) {
+		// Nothing to roll back on a lost session, it is reopened for the next user
+		checkConnection(*connection);
+		release(connection);
+		return true;
+	}
+
+	const bool success = mysql_rollback(connection->handle) == 0;
+	if (!success) {
+		g_logger().error("Message: {}", mysql_error(connection->handle));
+	}
+
+	release(connection);
+	return success;
+}
+
 bool Database::commit() {
-	if (!handle) {
-		g_logger().error("Database not initialized!");
+	if (transactionDepth == 0) {
+		g_logger().error("Database transaction not started!");
 		return false;
 	}
-	if (mysql_commit(handle) != 0) {
-		g_logger().error("Message: {}", mysql_error(handle));
-		databaseLock.unlock();
+
+	if (--transactionDepth > 0 || !transactionConnection) {
+		return true;
+	}
+
+	Connection* connection = std::exchange(transactionConnection, nullptr);
+	if (std::exchange(transactionFailed, false)) {
+		g_logger().error("Database transaction failed, nothing was committed");
+		checkConnection(*connection);
+		release(connection);
 		return false;
 	}
 
-	databaseLock.unlock();
-	return true;
+	const bool success = mysql_commit(connection->handle) == 0;
+	if (!success) {
+		g_logger().error("Message: {}", mysql_error(connection->handle));
+	}
+
+	release(connection);
+	return success;
 }
 
 bool Database::isRecoverableError(unsigned int error) const {
 	return error == CR_SERVER_LOST || error == CR_SERVER_GONE_ERROR || error == CR_CONN_HOST_ERROR || error == 1053 /*ER_SERVER_SHUTDOWN*/ || error == CR_CONNECTION_ERROR;
 }
 
-bool Database::retryQuery(const std::string_view &query, int retries) {
-	while (retries > 0 && mysql_query(handle, query.data()) != 0) {
+bool Database::retryQuery(Connection &connection, const std::string_view &query, int retries) {
+	if (hasFailedTransaction(connection)) {
+		return false;
+	}
+
+	while (retries > 0 && mysql_query(connection.handle, query.data()) != 0) {
 		g_logger().error("Query: {}", query.substr(0, 256));
-		g_logger().error("MySQL error [{}]: {}", mysql_errno(handle), mysql_error(handle));
-		if (!isRecoverableError(mysql_errno(handle))) {
+		g_logger().error("MySQL error [{}]: {}", mysql_errno(connection.handle), mysql_error(connection.handle));
+		if (!isRecoverableError(mysql_errno(connection.handle)) || !recoverConnection(connection)) {
 			return false;
 		}
-		std::this_thread::sleep_for(std::chrono::seconds(1));
 		retries--;
 	}
 	if (retries == 0) {
@@ -122,49 +296,52 @@ bool Database::retryQuery(const std::string_view &query, int retries) {
 }
 
 bool Database::executeQuery(const std::string_view &query) {
-	if (!handle) {
+	if (auto recorder = DBQueryRecorder::current()) {
+		recorder->record(query);
+		return true;
+	}
+
+	ConnectionGuard connection(*this);
+	if (!connection) {
 		g_logger().error("Database not initialized!");
 		return false;
 	}
 
 	g_logger().trace("Executing Query: {}", query);
 
-	metrics::lock_latency measureLock("database");
-	std::scoped_lock lock { databaseLock };
-	measureLock.stop();
-
 	metrics::query_latency measure(query.substr(0, 50));
-	bool success = retryQuery(query, 10);
-	mysql_free_result(mysql_store_result(handle));
+	bool success = retryQuery(*connection, query, 10);
+	mysql_free_result(mysql_store_result(connection->handle));
+	lastInsertId = static_cast<uint64_t>(mysql_insert_id(connection->handle));
 
 	return success;
 }
 
 DBResult_ptr Database::storeQuery(const std::string_view &query) {
-	if (!handle) {
+	ConnectionGuard connection(*this);
+	if (!connection) {
 		g_logger().error("Database not initialized!");
 		return nullptr;
 	}
 	g_logger().trace("Storing Query: {}", query);
 
-	metrics::lock_latency measureLock("database");
-	std::scoped_lock lock { databaseLock };
-	measureLock.stop();
+	if (hasFailedTransaction(*connection)) {
+		return nullptr;
+	}
 
 	metrics::query_latency measure(query.substr(0, 50));
 retry:
-	if (mysql_query(handle, query.data()) != 0) {
+	if (mysql_query(connection->handle, query.data()) != 0) {
 		g_logger().error("Query: {}", query);
-		g_logger().error("Message: {}", mysql_error(handle));
-		if (!isRecoverableError(mysql_errno(handle))) {
+		g_logger().error("Message: {}", mysql_error(connection->handle));
+		if (!isRecoverableError(mysql_errno(connection->handle)) || !recoverConnection(*connection)) {
 			return nullptr;
 		}
-		std::this_thread::sleep_for(std::chrono::seconds(1));
 		goto retry;
 	}
 
 	// Retrieving results of query
-	MYSQL_RES* res = mysql_store_result(handle);
+	MYSQL_RES* res = mysql_store_result(connection->handle);
 	if (res != nullptr) {
 		DBResult_ptr result = std::make_shared<DBResult>(res);
 		if (!result->hasNext()) {
@@ -175,6 +352,224 @@ retry:
 	return nullptr;
 }
 
+bool Database::executeStatement(const std::string_view &query, const std::vector<DBValue> &params) {
+	if (auto recorder = DBQueryRecorder::current()) {
+		recorder->record(query, params);
+		return true;
+	}
+
+	ConnectionGuard connection(*this);
+	if (!connection) {
+		g_logger().error("Database not initialized!");
+		return false;
+	}
+
+	g_logger().trace("Executing Statement: {}", query);
+
+	metrics::query_latency measure(query.substr(0, 50));
+	return runStatement(*connection, query, params, nullptr);
+}
+
+DBResult_ptr Database::storeStatement(const std::string_view &query, const std::vector<DBValue> &params) {
+	ConnectionGuard connection(*this);
+	if (!connection) {
+		g_logger().error("Database not initialized!");
+		return nullptr;
+	}
+
+	g_logger().trace("Storing Statement: {}", query);
+
+	metrics::query_latency measure(query.substr(0, 50));
+	DBResult_ptr result;
+	if (!runStatement(*connection, query, params, &result) || !result || !result->hasNext()) {
+		return nullptr;
+	}
+	return result;
+}
+
+MYSQL_STMT* Database::getStatement(Connection &connection, const std::string_view &query) {
+	if (auto it = connection.statements.find(query); it != connection.statements.end()) {
+		return it->second;
+	}
+
+	MYSQL_STMT* statement = mysql_stmt_init(connection.handle);
+	if (!statement) {
+		g_logger().error("Failed to initialize MySQL statement: {}", mysql_error(connection.handle));
+		return nullptr;
+	}
+
+	if (mysql_stmt_prepare(statement, query.data(), query.size()) != 0) {
+		g_logger().error("Statement: {}", query.substr(0, 256));
+		g_logger().error("MySQL error [{}]: {}", mysql_stmt_errno(statement), mysql_stmt_error(statement));
+		mysql_stmt_close(statement);
+		return nullptr;
+	}
+
+	// Lets the result buffers be sized from the metadata once the rows are stored
+	my_bool updateMaxLength = 1;
+	mysql_stmt_attr_set(statement, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+	if (connection.statements.size() >= MAX_CACHED_STATEMENTS) {
+		// Queries built with a variable number of placeholders would grow the cache forever
+		closeStatements(connection);
+	}
+	connection.statements.emplace(query, statement);
+	return statement;
+}
+
+void Database::closeStatements(Connection &connection) const {
+	for (const auto &[_, statement] : connection.statements) {
+		mysql_stmt_close(statement);
+	}
+	connection.statements.clear();
+}
+
+bool Database::runStatement(Connection &connection, const std::string_view &query, const std::vector<DBValue> &params, DBResult_ptr* result) {
+	if (hasFailedTransaction(connection)) {
+		return false;
+	}
+
+	std::vector<MYSQL_BIND> binds(params.size());
+	for (size_t i = 0; i < params.size(); ++i) {
+		auto &bind = binds[i];
+		std::visit(
+			[&bind](const auto &value) {
+				using T = std::decay_t<decltype(value)>;
+				if constexpr (std::is_same_v<T, std::nullptr_t>) {
+					bind.buffer_type = MYSQL_TYPE_NULL;
+				} else if constexpr (std::is_same_v<T, std::string>) {
+					bind.buffer_type = MYSQL_TYPE_STRING;
+					bind.buffer = const_cast<char*>(value.data());
+					bind.buffer_length = static_cast<unsigned long>(value.size());
+				} else if constexpr (std::is_same_v<T, DBBlob>) {
+					bind.buffer_type = MYSQL_TYPE_BLOB;
+					bind.buffer = const_cast<char*>(value.data.data());
+					bind.buffer_length = static_cast<unsigned long>(value.data.size());
+				} else if constexpr (std::is_same_v<T, double>) {
+					bind.buffer_type = MYSQL_TYPE_DOUBLE;
+					bind.buffer = const_cast<double*>(&value);
+				} else {
+					bind.buffer_type = MYSQL_TYPE_LONGLONG;
+					bind.buffer = const_cast<T*>(&value);
+					bind.is_unsigned = std::is_unsigned_v<T>;
+				}
+			},
+			params[i]
+		);
+	}
+
+	for (int retries = 10; retries > 0; --retries) {
+		unsigned int error;
+		MYSQL_STMT* statement = getStatement(connection, query);
+		if (!statement) {
+			error = mysql_errno(connection.handle);
+		} else if (mysql_stmt_param_count(statement) != params.size()) {
+			g_logger().error("Statement {} expects {} parameters, {} given", query.substr(0, 256), mysql_stmt_param_count(statement), params.size());
+			return false;
+		} else if ((binds.empty() || mysql_stmt_bind_param(statement, binds.data()) == 0) && mysql_stmt_execute(statement) == 0) {
+			lastInsertId = static_cast<uint64_t>(mysql_stmt_insert_id(statement));
+			if (result) {
+				*result = fetchStatement(statement);
+			}
+			mysql_stmt_free_result(statement);
+			return true;
+		} else {
+			error = mysql_stmt_errno(statement);
+			g_logger().error("Statement: {}", query.substr(0, 256));
+			g_logger().error("MySQL error [{}]: {}", error, mysql_stmt_error(statement));
+		}
+
+		if (!isRecoverableError(error) && error != 1243 /*ER_UNKNOWN_STMT_HANDLER*/) {
+			return false;
+		}
+
+		// The statement is prepared again on the (re)opened session
+		closeStatements(connection);
+		if (!recoverConnection(connection)) {
+			return false;
+		}
+	}
+
+	g_logger().error("Statement {} failed after {} retries.", query.substr(0, 256), 10);
+	return false;
+}
+
+DBResult_ptr Database::fetchStatement(MYSQL_STMT* statement) {
+	MYSQL_RES* metadata = mysql_stmt_result_metadata(statement);
+	if (!metadata) {
+		// Not a query returning rows
+		return nullptr;
+	}
+
+	if (mysql_stmt_store_result(statement) != 0) {
+		g_logger().error("MySQL error [{}]: {}", mysql_stmt_errno(statement), mysql_stmt_error(statement));
+		mysql_free_result(metadata);
+		return nullptr;
+	}
+
+	// The fields belong to the statement, which is closed when its connection is reopened or its cache is full
+	const unsigned int columns = mysql_num_fields(metadata);
+	const MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+	std::vector<std::string> columnNames;
+	columnNames.reserve(columns);
+	for (unsigned int i = 0; i < columns; ++i) {
+		columnNames.emplace_back(fields[i].name);
+	}
+
+	// Every column is fetched as text, except blobs it is what the text protocol would return
+	std::vector<MYSQL_BIND> binds(columns);
+	std::vector<std::string> buffers(columns);
+	std::vector<unsigned long> lengths(columns);
+	const auto nulls = std::make_unique<my_bool[]>(columns);
+	for (unsigned int i = 0; i < columns; ++i) {
+		buffers[i].resize(std::max<unsigned long>(fields[i].max_length, 64));
+		binds[i].buffer_type = MYSQL_TYPE_STRING;
+		binds[i].buffer = buffers[i].data();
+		binds[i].buffer_length = static_cast<unsigned long>(buffers[i].size());
+		binds[i].length = &lengths[i];
+		binds[i].is_null = &nulls[i];
+	}
+
+	std::string data;
+	std::vector<DBResult::Cell> cells;
+	cells.reserve(static_cast<size_t>(mysql_stmt_num_rows(statement)) * columns);
+
+	mysql_stmt_bind_result(statement, binds.data());
+	while (true) {
+		const int status = mysql_stmt_fetch(statement);
+		if (status == MYSQL_NO_DATA) {
+			break;
+		}
+		if (status == 1) {
+			g_logger().error("MySQL error [{}]: {}", mysql_stmt_errno(statement), mysql_stmt_error(statement));
+			break;
+		}
+
+		for (unsigned int i = 0; i < columns; ++i) {
+			if (nulls[i]) {
+				cells.push_back({ data.size(), 0, true });
+				continue;
+			}
+
+			if (lengths[i] > buffers[i].size()) {
+				// Truncated, fetch the column again into a buffer big enough
+				buffers[i].resize(lengths[i]);
+				binds[i].buffer = buffers[i].data();
+				binds[i].buffer_length = lengths[i];
+				mysql_stmt_fetch_column(statement, &binds[i], i, 0);
+				mysql_stmt_bind_result(statement, binds.data());
+			}
+
+			cells.push_back({ data.size(), lengths[i], false });
+			data.append(buffers[i].data(), lengths[i]);
+			data.push_back('\0');
+		}
+	}
+
+	mysql_free_result(metadata);
+	return DBResult_ptr(new DBResult(std::move(columnNames), std::move(data), std::move(cells)));
+}
+
 std::string Database::escapeString(const std::string &s) const {
 	std::string::size_type len = s.length();
 	auto length = static_cast<uint32_t>(len);
@@ -194,7 +589,7 @@ std::string Database::escapeBlob(const char* s, uint32_t length) const {
 
 	if (length != 0) {
 		std::string output(maxLength, '\0');
-		size_t escapedLength = mysql_real_escape_string(handle, &output[0], s, length);
+		size_t escapedLength = mysql_real_escape_string(escapeConnection.handle, &output[0], s, length);
 		output.resize(escapedLength);
 		escaped.append(output);
 	}
@@ -215,8 +610,40 @@ DBResult::DBResult(MYSQL_RES* res) {
 	row = mysql_fetch_row(handle);
 }
 
+DBResult::DBResult(std::vector<std::string> &&columnNames, std::string &&data, std::vector<Cell> &&cells) :
+	handle(nullptr), fetched(true), data(std::move(data)), cells(std::move(cells)) {
+	columnCount = columnNames.size();
+	for (size_t i = 0; i < columnCount; i++) {
+		listNames[std::move(columnNames[i])] = i;
+	}
+	rowCount = columnCount == 0 ? 0 : this->cells.size() / columnCount;
+}
+
 DBResult::~DBResult() {
-	mysql_free_result(handle);
+	if (handle) {
+		mysql_free_result(handle);
+	}
+}
+
+const char* DBResult::getValue(size_t column, unsigned long* length /* = nullptr*/) const {
+	if (fetched) {
+		const Cell &cell = cells[rowIndex * columnCount + column];
+		if (cell.null) {
+			return nullptr;
+		}
+		if (length) {
+			*length = cell.length;
+		}
+		return data.data() + cell.offset;
+	}
+
+	if (row[column] == nullptr) {
+		return nullptr;
+	}
+	if (length) {
+		*length = mysql_fetch_lengths(handle)[column];
+	}
+	return row[column];
 }
 
 std::string DBResult::getString(const std::string &s) const {
@@ -225,10 +652,13 @@ std::string DBResult::getString(const std::string &s) const {
 		g_logger().error("Column '{}' does not exist in result set", s);
 		return std::string();
 	}
-	if (row[it->second] == nullptr) {
+
+	unsigned long length = 0;
+	const char* value = getValue(it->second, &length);
+	if (value == nullptr) {
 		return std::string();
 	}
-	return std::string(row[it->second]);
+	return std::string(value, length);
 }
 
 const char* DBResult::getStream(const std::string &s, unsigned long &size) const {
@@ -239,13 +669,11 @@ const char* DBResult::getStream(const std::string &s, unsigned long &size) const
 		return nullptr;
 	}
 
-	if (row[it->second] == nullptr) {
+	const char* value = getValue(it->second, &size);
+	if (value == nullptr) {
 		size = 0;
-		return nullptr;
 	}
-
-	size = mysql_fetch_lengths(handle)[it->second];
-	return row[it->second];
+	return value;
 }
 
 uint8_t DBResult::getU8FromString(const std::string &string, const std::string &function) const {
@@ -269,14 +697,27 @@ int8_t DBResult::getInt8FromString(const std::string &string, const std::string
 }
 
 size_t DBResult::countResults() const {
+	if (fetched) {
+		return rowCount;
+	}
 	return static_cast<size_t>(mysql_num_rows(handle));
 }
 
 bool DBResult::hasNext() const {
+	if (fetched) {
+		return rowIndex < rowCount;
+	}
 	return row != nullptr;
 }
 
 bool DBResult::next() {
+	if (fetched) {
+		if (rowIndex < rowCount) {
+			++rowIndex;
+		}
+		return rowIndex < rowCount;
+	}
+
 	if (!handle) {
 		g_logger().error("Database not initialized!");
 		return false;
@@ -320,29 +761,107 @@ bool DBInsert::addRow(std::ostringstream &row) {
 	return ret;
 }
 
+bool DBInsert::addRow(std::vector<DBValue> &&row) {
+	if (!values.empty() || (rowSize != 0 && row.size() != rowSize)) {
+		g_logger().error("[DBInsert::addRow] - Row doesn't match the other rows of: {}", query.substr(0, 50));
+		return false;
+	}
+
+	rowSize = row.size();
+	params.insert(params.end(), std::make_move_iterator(row.begin()), std::make_move_iterator(row.end()));
+	return true;
+}
+
 void DBInsert::upsert(const std::vector<std::string> &columns) {
 	upsertColumns = columns;
 }
 
+std::string DBInsert::getUpsertQuery() const {
+	if (upsertColumns.empty()) {
+		return std::string();
+	}
+
+	std::ostringstream upsertStream;
+	upsertStream << " ON DUPLICATE KEY UPDATE ";
+	for (size_t i = 0; i < upsertColumns.size(); ++i) {
+		upsertStream << "`" << upsertColumns[i] << "` = VALUES(`" << upsertColumns[i] << "`)";
+		if (i < upsertColumns.size() - 1) {
+			upsertStream << ", ";
+		}
+	}
+	return upsertStream.str();
+}
+
+bool DBInsert::executeStatements() {
+	const std::string upsertQuery = getUpsertQuery();
+	const size_t maxBatchSize = Database::getInstance().getMaxPacketSize() / 2;
+
+	std::string rowPlaceholders = "(?";
+	for (size_t i = 1; i < rowSize; ++i) {
+		rowPlaceholders.append(",?");
+	}
+	rowPlaceholders.push_back(')');
+
+	const size_t totalRows = params.size() / rowSize;
+	const auto getBatchBytes = [this](size_t firstRow, size_t rows) {
+		size_t bytes = 0;
+		for (auto it = params.begin() + firstRow * rowSize, end = it + rows * rowSize; it != end; ++it) {
+			if (const auto string = std::get_if<std::string>(&*it)) {
+				bytes += string->size();
+			} else if (const auto blob = std::get_if<DBBlob>(&*it)) {
+				bytes += blob->data.size();
+			} else {
+				bytes += sizeof(uint64_t);
+			}
+		}
+		return bytes;
+	};
+
+	size_t firstRow = 0;
+	while (firstRow < totalRows) {
+		// The largest batch size left that fits in the packet, a single row always goes
+		size_t rows = 1;
+		for (const size_t batchRows : STATEMENT_BATCH_ROWS) {
+			if (firstRow + batchRows <= totalRows && getBatchBytes(firstRow, batchRows) <= maxBatchSize) {
+				rows = batchRows;
+				break;
+			}
+		}
+
+		// Only a few batch sizes exist, so every insert shares the same few prepared statements
+		std::string batchQuery = query;
+		batchQuery.push_back(' ');
+		for (size_t row = 0; row < rows; ++row) {
+			if (row > 0) {
+				batchQuery.push_back(',');
+			}
+			batchQuery.append(rowPlaceholders);
+		}
+		batchQuery.append(upsertQuery);
+
+		const auto begin = params.begin() + static_cast<std::ptrdiff_t>(firstRow * rowSize);
+		const std::vector<DBValue> batchParams(begin, begin + static_cast<std::ptrdiff_t>(rows * rowSize));
+		if (!Database::getInstance().executeStatement(batchQuery, batchParams)) {
+			return false;
+		}
+		firstRow += rows;
+	}
+
+	params.clear();
+	return true;
+}
+
 bool DBInsert::execute() {
+	if (!params.empty()) {
+		return executeStatements();
+	}
+
 	if (values.empty()) {
 		return true;
 	}
 
 	std::string baseQuery = this->query;
-	std::string upsertQuery;
-
-	if (!upsertColumns.empty()) {
-		std::ostringstream upsertStream;
-		upsertStream << " ON DUPLICATE KEY UPDATE ";
-		for (size_t i = 0; i < upsertColumns.size(); ++i) {
-			upsertStream << "`" << upsertColumns[i] << "` = VALUES(`" << upsertColumns[i] << "`)";
-			if (i < upsertColumns.size() - 1) {
-				upsertStream << ", ";
-			}
-		}
-		upsertQuery = upsertStream.str();
-	}
+	std::string upsertQuery = getUpsertQuery();
 
 	std::string currentBatch = values;
 	while (!currentBatch.empty()) {
@@ -372,3 +891,31 @@ bool DBInsert::execute() {
 
 	return true;
 }
+
+thread_local DBQueryRecorder* DBQueryRecorder::active = nullptr;
+
+DBQueryRecorder::DBQueryRecorder() :
+	previous(active) {
+	active = this;
+}
+
+DBQueryRecorder::~DBQueryRecorder() {
+	active = previous;
+}
+
+bool DBQueryRecorder::execute(const std::vector<DBQuery> &queries) {
+	if (queries.empty()) {
+		return true;
+	}
+
+	return DBTransaction::executeWithinTransaction([&queries]() {
+		Database &db = Database::getInstance();
+		for (const auto &[query, params] : queries) {
+			const bool success = params.empty() ? db.executeQuery(query) : db.executeStatement(query, params);
+			if (!success) {
+				throw DatabaseException("[DBQueryRecorder::execute] - Failed to execute recorded query: " + query.substr(0, 50));
+			}
+		}
+		return true;
+	});
+}
@@ -14,12 +14,41 @@
 
 #ifndef USE_PRECOMPILED_HEADERS
 	#include <mysql/mysql.h>
+	#include <condition_variable>
 	#include <mutex>
 #endif
 
 class DBResult;
 using DBResult_ptr = std::shared_ptr<DBResult>;
 
+// Binary data bound to a parameter, such as serialized attributes.
+struct DBBlob {
+	std::string data;
+};
+
+/**
+ * Value bound to a parameter of a prepared statement. Strings are sent as they
+ * are through the binary protocol, so they are never escaped nor hex encoded.
+ * A std::string is bound as text and compared with the collation of its column,
+ * binary data must be a DBBlob.
+ */
+using DBValue = std::variant<std::nullptr_t, int64_t, uint64_t, double, std::string, DBBlob>;
+
+// A query and the parameters bound to its placeholders, a plain query has none.
+struct DBQuery {
+	std::string query;
+	std::vector<DBValue> params;
+};
+
+/**
+ * Keeps a pool of MySQL connections, so queries from different threads don't
+ * wait on each other.
+ *
+ * Every query checks out a connection and gives it back once it is done, a
+ * DBTransaction keeps its connection until it is committed or rolled back so all
+ * its queries run on it. Connections idle for a while are pinged before being
+ * used and reopened if the server dropped them.
+ */
 class Database {
 public:
 	static const size_t MAX_QUERY_SIZE = 8 * 1024 * 1024; // 8 Mb -- half the default MySQL max_allowed_packet size
@@ -35,19 +64,26 @@ public:
 
 	bool connect();
 
-	bool connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock);
+	bool connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock, uint32_t poolSize = 1);
 
-	bool retryQuery(const std::string_view &query, int retries);
 	bool executeQuery(const std::string_view &query);
 
 	DBResult_ptr storeQuery(const std::string_view &query);
 
+	/**
+	 * Prepared statements, `query` uses ? as placeholders for `params`.
+	 * Statements are prepared once per connection and cached by their query.
+	 */
+	bool executeStatement(const std::string_view &query, const std::vector<DBValue> &params);
+	DBResult_ptr storeStatement(const std::string_view &query, const std::vector<DBValue> &params);
+
 	std::string escapeString(const std::string &s) const;
 
 	std::string escapeBlob(const char* s, uint32_t length) const;
 
+	// Id generated by the last query executed by the calling thread.
 	uint64_t getLastInsertId() const {
-		return static_cast<uint64_t>(mysql_insert_id(handle));
+		return lastInsertId;
 	}
 
 	static const char* getClientVersion() {
@@ -58,15 +94,68 @@ public:
 		return maxPacketSize;
 	}
 
+	size_t getPoolSize() const {
+		return connections.size();
+	}
+
 private:
+	// Connections idle for longer than this are pinged before being used.
+	static constexpr std::chrono::seconds CONNECTION_CHECK_INTERVAL { 30 };
+	// Prepared statements kept by each connection.
+	static constexpr size_t MAX_CACHED_STATEMENTS = 512;
+
+	struct Connection {
+		MYSQL* handle = nullptr;
+		std::chrono::steady_clock::time_point lastUsed;
+
+		// Prepared statements of the current session, closed when it is reopened.
+		phmap::flat_hash_map<std::string, MYSQL_STMT*> statements;
+	};
+
+	class ConnectionGuard;
+
 	bool beginTransaction();
 	bool rollback();
 	bool commit();
 
 	bool isRecoverableError(unsigned int error) const;
 
-	MYSQL* handle = nullptr;
-	std::recursive_mutex databaseLock;
+	bool openConnection(Connection &connection) const;
+	bool checkConnection(Connection &connection) const;
+	// Reconnects after a lost connection, unless it holds the transaction of the calling thread which then fails.
+	bool recoverConnection(Connection &connection);
+	bool hasFailedTransaction(const Connection &connection) const;
+	Connection* acquire();
+	void release(Connection* connection);
+
+	bool retryQuery(Connection &connection, const std::string_view &query, int retries);
+
+	MYSQL_STMT* getStatement(Connection &connection, const std::string_view &query);
+	void closeStatements(Connection &connection) const;
+	bool runStatement(Connection &connection, const std::string_view &query, const std::vector<DBValue> &params, DBResult_ptr* result);
+	DBResult_ptr fetchStatement(MYSQL_STMT* statement);
+
+	std::string host;
+	std::string user;
+	std::string password;
+	std::string database;
+	std::string sock;
+	uint32_t port = 0;
+
+	std::vector<std::unique_ptr<Connection>> connections;
+	std::vector<Connection*> idleConnections;
+	// Only used to escape strings, it is never reopened so it can be read from any thread.
+	Connection escapeConnection;
+	std::mutex poolMutex;
+	std::condition_variable poolCondition;
+
+	// Connection held by the transaction of the calling thread, if any.
+	thread_local static Connection* transactionConnection;
+	thread_local static uint32_t transactionDepth;
+	// Set when the connection of the transaction was lost, its queries fail until it ends.
+	thread_local static bool transactionFailed;
+	thread_local static uint64_t lastInsertId;
+
 	uint64_t maxPacketSize = 1048576;
 
 	friend class DBTransaction;
@@ -91,7 +180,8 @@ public:
 			return T();
 		}
 
-		if (row[it->second] == nullptr) {
+		const char* value = getValue(it->second);
+		if (value == nullptr) {
 			return T();
 		}
 
@@ -102,33 +192,33 @@ public:
 				// Check if the type T is int8_t or int16_t
 				if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>) {
 					// Use std::stoi to convert string to int8_t
-					data = static_cast<T>(std::stoi(row[it->second]));
+					data = static_cast<T>(std::stoi(value));
 				}
 				// Check if the type T is int32_t
 				else if constexpr (std::is_same_v<T, int32_t>) {
 					// Use std::stol to convert string to int32_t
-					data = static_cast<T>(std::stol(row[it->second]));
+					data = static_cast<T>(std::stol(value));
 				}
 				// Check if the type T is int64_t
 				else if constexpr (std::is_same_v<T, int64_t>) {
 					// Use std::stoll to convert string to int64_t
-					data = static_cast<T>(std::stoll(row[it->second]));
+					data = static_cast<T>(std::stoll(value));
 				} else {
 					// Throws exception indicating that type T is invalid
 					g_logger().error("Invalid signed type T");
 				}
 			} else if (std::is_same<T, bool>::value) {
-				data = static_cast<T>(std::stoi(row[it->second]));
+				data = static_cast<T>(std::stoi(value));
 			} else {
 				// Check if the type T is uint8_t or uint16_t or uint32_t
 				if constexpr (std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, uint32_t>) {
 					// Use std::stoul to convert string to uint8_t
-					data = static_cast<T>(std::stoul(row[it->second]));
+					data = static_cast<T>(std::stoul(value));
 				}
 				// Check if the type T is uint64_t
 				else if constexpr (std::is_same_v<T, uint64_t>) {
 					// Use std::stoull to convert string to uint64_t
-					data = static_cast<T>(std::stoull(row[it->second]));
+					data = static_cast<T>(std::stoull(value));
 				} else {
 					// Send log indicating that type T is invalid
 					g_logger().error("Column '{}' has an invalid unsigned T is invalid", s);
@@ -157,10 +247,30 @@ public:
 	bool next();
 
 private:
+	// A value of a row fetched from a prepared statement, stored in `data` followed by a '\0'.
+	struct Cell {
+		size_t offset;
+		unsigned long length;
+		bool null;
+	};
+
+	DBResult(std::vector<std::string> &&columnNames, std::string &&data, std::vector<Cell> &&cells);
+
+	const char* getValue(size_t column, unsigned long* length = nullptr) const;
+
+	// The result set, nullptr for the rows of a prepared statement.
 	MYSQL_RES* handle;
-	MYSQL_ROW row;
+	MYSQL_ROW row = nullptr;
 
-	std::map<std::string_view, size_t> listNames;
+	std::map<std::string, size_t, std::less<>> listNames;
+
+	// Rows of a prepared statement, fetched when it is executed.
+	bool fetched = false;
+	std::string data;
+	std::vector<Cell> cells;
+	size_t columnCount = 0;
+	size_t rowCount = 0;
+	size_t rowIndex = 0;
 
 	friend class Database;
 };
@@ -174,13 +284,24 @@ public:
 	void upsert(const std::vector<std::string> &columns);
 	bool addRow(const std::string_view row);
 	bool addRow(std::ostringstream &row);
+	// Binds the row to a prepared statement instead, an insert must not mix both kinds of rows.
+	bool addRow(std::vector<DBValue> &&row);
 	bool execute();
 
 private:
+	// Rows sent in a single prepared statement, largest first. A batch must also fit in half the max packet size.
+	static constexpr std::array<size_t, 3> STATEMENT_BATCH_ROWS = { 256, 16, 1 };
+
+	std::string getUpsertQuery() const;
+	bool executeStatements();
+
 	std::vector<std::string> upsertColumns;
 	std::string query;
 	std::string values;
 	size_t length;
+
+	std::vector<DBValue> params;
+	size_t rowSize = 0;
 };
 
 class DBTransaction {
@@ -203,8 +324,7 @@ public:
 		try {
 			transaction.begin();
 			bool result = toBeExecuted();
-			transaction.commit();
-			return result;
+			return transaction.commit() && result;
 		} catch (const std::exception &exception) {
 			transaction.rollback();
 			g_logger().error("[{}] Error occurred committing transaction, error: {}", __FUNCTION__, exception.what());
@@ -247,21 +367,22 @@ private:
 		}
 	}
 
-	void commit() {
+	bool commit() {
 		// Ensure that the transaction has been started
 		if (state != STATE_START) {
 			g_logger().error("Transaction not started");
-			return;
+			return false;
 		}
 
 		try {
 			// Commit the transaction
 			state = STATE_COMMIT;
-			Database::getInstance().commit();
+			return Database::getInstance().commit();
 		} catch (const std::exception &exception) {
 			// An error occurred while committing the transaction
 			state = STATE_NO_START;
 			g_logger().error("[{}] An error occurred while committing the transaction, error: {}", __FUNCTION__, exception.what());
+			return false;
 		}
 	}
 
@@ -290,3 +411,45 @@ public:
 private:
 	std::string message;
 };
+
+/**
+ * Records the queries executed by the current thread instead of sending them,
+ * reads (storeQuery) still go to the database.
+ *
+ * Used to snapshot on the game thread what a save would write, the recorded
+ * queries are then executed by a worker with execute().
+ */
+class DBQueryRecorder {
+public:
+	DBQueryRecorder();
+	~DBQueryRecorder();
+
+	// non-copyable
+	DBQueryRecorder(const DBQueryRecorder &) = delete;
+	DBQueryRecorder &operator=(const DBQueryRecorder &) = delete;
+
+	static DBQueryRecorder* current() {
+		return active;
+	}
+
+	void record(const std::string_view &query) {
+		queries.push_back({ std::string(query), {} });
+	}
+
+	void record(const std::string_view &query, const std::vector<DBValue> &params) {
+		queries.push_back({ std::string(query), params });
+	}
+
+	std::vector<DBQuery> release() {
+		return std::move(queries);
+	}
+
+	// Executes the queries within a single transaction, returns false if any of them failed.
+	static bool execute(const std::vector<DBQuery> &queries);
+
+private:
+	thread_local static DBQueryRecorder* active;
+
+	DBQueryRecorder* previous = nullptr;
+	std::vector<DBQuery> queries;
+};
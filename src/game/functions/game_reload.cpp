@@ -15,9 +15,11 @@
 #include "lua/creature/events.hpp"
 #include "creatures/players/imbuements/imbuements.hpp"
 #include "lua/scripts/lua_environment.hpp"
+#include "lua/scripts/lua_worker_pool.hpp"
 #include "lua/modules/modules.hpp"
 #include "lua/scripts/scripts.hpp"
 #include "game/zones/zone.hpp"
+#include "game/scheduling/dispatcher.hpp"
 
 GameReload::GameReload() = default;
 GameReload::~GameReload() = default;
@@ -101,6 +103,7 @@ bool GameReload::reloadChat() const {
 
 bool GameReload::reloadConfig() const {
 	const bool result = g_configManager().reload();
+	g_dispatcher().setWorkStealing(g_configManager().getBoolean(TOGGLE_DISPATCHER_WORK_STEALING, __FUNCTION__));
 	logReloadStatus("Config", result);
 	return result;
 }
@@ -190,6 +193,7 @@ bool GameReload::reloadScripts() const {
 	g_scripts().loadScripts(coreFolder + "/scripts/lib", true, false);
 	g_scripts().loadScripts(datapackFolder + "/scripts", false, true);
 	g_scripts().loadScripts(coreFolder + "/scripts", false, true);
+	g_luaWorkers().reload();
 
 	// It should come last, after everything else has been cleaned up.
 	reloadMonsters();
@@ -6130,6 +6130,7 @@ void Game::checkCreatureAttack(uint32_t creatureId) {
 
 void Game::addCreatureCheck(const std::shared_ptr<Creature> &creature) {
 	creature->creatureCheck = true;
+	creature->creatureSleeping = false;
 
 	if (creature->inCheckCreaturesVector) {
 		// already in a vector
@@ -6151,15 +6152,27 @@ void Game::checkCreatures() {
 	metrics::method_latency measure(__METHOD_NAME__);
 	static size_t index = 0;
 
+	const bool parallelMonsterThink = g_configManager().getBoolean(TOGGLE_PARALLEL_MONSTER_THINK, __FUNCTION__);
+	std::vector<std::shared_ptr<Monster>> thinkingMonsters;
+
 	auto &checkCreatureList = checkCreatureLists[index];
 	size_t it = 0, end = checkCreatureList.size();
 	while (it < end) {
 		auto creature = checkCreatureList[it];
 		if (creature && creature->creatureCheck) {
 			if (creature->getHealth() > 0) {
-				creature->onThink(EVENT_CREATURE_THINK_INTERVAL);
-				creature->onAttacking(EVENT_CREATURE_THINK_INTERVAL);
-				creature->executeConditions(EVENT_CREATURE_THINK_INTERVAL);
+				const auto &monster = parallelMonsterThink && !creature->creatureSleeping ? creature->getMonster() : nullptr;
+				if (monster && monster->needsThinkDecision()) {
+					// Thinks once the thread pool decided, see decideMonsterThinks
+					thinkingMonsters.emplace_back(monster);
+				} else {
+					// Sleeping creatures stay in the list only while their conditions tick
+					if (!creature->creatureSleeping) {
+						creature->onThink(EVENT_CREATURE_THINK_INTERVAL);
+						creature->onAttacking(EVENT_CREATURE_THINK_INTERVAL);
+					}
+					creature->executeConditions(EVENT_CREATURE_THINK_INTERVAL);
+				}
 			} else {
 				afterCreatureZoneChange(creature, creature->getZones(), {});
 				creature->onDeath();
@@ -6175,9 +6188,50 @@ void Game::checkCreatures() {
 	}
 	cleanup();
 
+	if (!thinkingMonsters.empty()) {
+		decideMonsterThinks(std::move(thinkingMonsters));
+	}
+
 	index = (index + 1) % EVENT_CREATURECOUNT;
 }
 
+void Game::decideMonsterThinks(std::vector<std::shared_ptr<Monster>> &&monsters) {
+	static constexpr size_t CHUNK_SIZE = 64;
+
+	// The decisions run in the dispatcher parallel phase, while no serial event can change the
+	// world. The last chunk to finish posts the commit, which thinks in the order of the list.
+	const auto shared = std::make_shared<std::vector<std::shared_ptr<Monster>>>(std::move(monsters));
+	const size_t chunks = (shared->size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	const auto pendingChunks = std::make_shared<std::atomic_size_t>(chunks);
+
+	for (size_t chunk = 0; chunk < chunks; ++chunk) {
+		g_dispatcher().asyncEvent([shared, pendingChunks, chunk] {
+			const size_t begin = chunk * CHUNK_SIZE;
+			const size_t end = std::min(begin + CHUNK_SIZE, shared->size());
+			for (size_t i = begin; i < end; ++i) {
+				(*shared)[i]->decideThink();
+			}
+
+			if (pendingChunks->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				g_dispatcher().addEvent([shared] { g_game().commitMonsterThinks(*shared); }, "Game::commitMonsterThinks");
+			}
+		});
+	}
+}
+
+void Game::commitMonsterThinks(const std::vector<std::shared_ptr<Monster>> &monsters) {
+	metrics::method_latency measure(__METHOD_NAME__);
+	for (const auto &monster : monsters) {
+		// Removed, killed or put to sleep since the decision
+		if (monster->creatureCheck && !monster->creatureSleeping && monster->getHealth() > 0) {
+			monster->onThink(EVENT_CREATURE_THINK_INTERVAL);
+			monster->onAttacking(EVENT_CREATURE_THINK_INTERVAL);
+			monster->executeConditions(EVENT_CREATURE_THINK_INTERVAL);
+		}
+		monster->clearThinkDecision();
+	}
+}
+
 void Game::changeSpeed(std::shared_ptr<Creature> creature, int32_t varSpeedDelta) {
 	int32_t varSpeed = creature->getSpeed() - creature->getBaseSpeed();
 	varSpeed += varSpeedDelta;
@@ -6185,8 +6239,9 @@ void Game::changeSpeed(std::shared_ptr<Creature> creature, int32_t varSpeedDelta
 	creature->setSpeed(varSpeed);
 
 	// Send to clients
-	for (const auto &spectator : Spectators().find<Player>(creature->getPosition())) {
-		spectator->getPlayer()->sendChangeSpeed(creature, creature->getStepSpeed());
+	auto packet = ProtocolGame::changeSpeedPacket(creature, creature->getStepSpeed());
+	for (const auto &spectator : Spectators::view<Player>(creature->getPosition())) {
+		spectator->getPlayer()->sendChangeSpeed(packet);
 	}
 }
 
@@ -6194,8 +6249,9 @@ void Game::setCreatureSpeed(std::shared_ptr<Creature> creature, int32_t speed) {
 	creature->setBaseSpeed(static_cast<uint16_t>(speed));
 
 	// Send creature speed to client
-	for (const auto &spectator : Spectators().find<Player>(creature->getPosition())) {
-		spectator->getPlayer()->sendChangeSpeed(creature, creature->getStepSpeed());
+	auto packet = ProtocolGame::changeSpeedPacket(creature, creature->getStepSpeed());
+	for (const auto &spectator : Spectators::view<Player>(creature->getPosition())) {
+		spectator->getPlayer()->sendChangeSpeed(packet);
 	}
 }
 
@@ -6206,8 +6262,9 @@ void Game::changePlayerSpeed(const std::shared_ptr<Player> &player, int32_t varS
 	player->setSpeed(varSpeed);
 
 	// Send new player speed to the spectators
-	for (const auto &creatureSpectator : Spectators().find<Player>(player->getPosition())) {
-		creatureSpectator->getPlayer()->sendChangeSpeed(player, player->getStepSpeed());
+	auto packet = ProtocolGame::changeSpeedPacket(player, player->getStepSpeed());
+	for (const auto &creatureSpectator : Spectators::view<Player>(player->getPosition())) {
+		creatureSpectator->getPlayer()->sendChangeSpeed(packet);
 	}
 }
 
@@ -6227,28 +6284,28 @@ void Game::internalCreatureChangeOutfit(std::shared_ptr<Creature> creature, cons
 	}
 
 	// Send to clients
-	for (const auto &spectator : Spectators().find<Player>(creature->getPosition(), true)) {
+	for (const auto &spectator : Spectators::view<Player>(creature->getPosition(), true)) {
 		spectator->getPlayer()->sendCreatureChangeOutfit(creature, outfit);
 	}
 }
 
 void Game::internalCreatureChangeVisible(std::shared_ptr<Creature> creature, bool visible) {
 	// Send to clients
-	for (const auto &spectator : Spectators().find<Player>(creature->getPosition(), true)) {
+	for (const auto &spectator : Spectators::view<Player>(creature->getPosition(), true)) {
 		spectator->getPlayer()->sendCreatureChangeVisible(creature, visible);
 	}
 }
 
 void Game::changeLight(std::shared_ptr<Creature> creature) {
 	// Send to clients
-	for (const auto &spectator : Spectators().find<Player>(creature->getPosition(), true)) {
+	for (const auto &spectator : Spectators::view<Player>(creature->getPosition(), true)) {
 		spectator->getPlayer()->sendCreatureLight(creature);
 	}
 }
 
 void Game::updateCreatureIcon(std::shared_ptr<Creature> creature) {
 	// Send to clients
-	for (const auto &spectator : Spectators().find<Player>(creature->getPosition(), true)) {
+	for (const auto &spectator : Spectators::view<Player>(creature->getPosition(), true)) {
 		spectator->getPlayer()->sendCreatureIcon(creature);
 	}
 }
@@ -6259,7 +6316,7 @@ void Game::reloadCreature(std::shared_ptr<Creature> creature) {
 		return;
 	}
 
-	for (const auto &spectator : Spectators().find<Player>(creature->getPosition())) {
+	for (const auto &spectator : Spectators::view<Player>(creature->getPosition())) {
 		spectator->getPlayer()->reloadCreature(creature);
 	}
 }
@@ -6270,7 +6327,7 @@ void Game::sendSingleSoundEffect(const Position &pos, SoundEffect_t soundId, std
 	}
 
 	using enum SourceEffect_t;
-	for (const auto &spectator : Spectators().find<Player>(pos)) {
+	for (const auto &spectator : Spectators::view<Player>(pos)) {
 		SourceEffect_t source = CREATURES;
 		if (!actor || actor->getNpc()) {
 			source = GLOBAL;
@@ -6291,7 +6348,7 @@ void Game::sendDoubleSoundEffect(const Position &pos, SoundEffect_t mainSoundEff
 	}
 
 	using enum SourceEffect_t;
-	for (const auto &spectator : Spectators().find<Player>(pos)) {
+	for (const auto &spectator : Spectators::view<Player>(pos)) {
 		SourceEffect_t source = CREATURES;
 		if (!actor || actor->getNpc()) {
 			source = GLOBAL;
@@ -6822,7 +6879,8 @@ bool Game::combatChangeHealth(std::shared_ptr<Creature> attacker, std::shared_pt
 			message.primary.value = realHealthChange;
 			message.primary.color = TEXTCOLOR_PASTELRED;
 
-			for (const auto &spectator : Spectators().find<Player>(targetPos)) {
+			const auto batch = CombatBatch::getActive();
+			for (const auto &spectator : batch ? batch->findSpectators(targetPos, false) : Spectators().find<Player>(targetPos)) {
 				const auto &tmpPlayer = spectator->getPlayer();
 				if (!tmpPlayer) {
 					continue;
@@ -6864,7 +6922,7 @@ bool Game::combatChangeHealth(std::shared_ptr<Creature> attacker, std::shared_pt
 					message.type = MESSAGE_HEALED_OTHERS;
 					message.text = spectatorMessage;
 				}
-				tmpPlayer->sendTextMessage(message);
+				sendCombatMessage(tmpPlayer, message);
 			}
 		}
 	} else {
@@ -6954,7 +7012,8 @@ bool Game::combatChangeHealth(std::shared_ptr<Creature> attacker, std::shared_pt
 			return true;
 		}
 
-		auto spectators = Spectators().find<Player>(targetPos, true);
+		const auto batch = CombatBatch::getActive();
+		auto spectators = batch ? batch->findSpectators(targetPos) : Spectators().find<Player>(targetPos, true);
 
 		if (targetPlayer && attackerMonster) {
 			handleHazardSystemAttack(damage, targetPlayer, attackerMonster, false);
@@ -7075,7 +7134,7 @@ bool Game::combatChangeHealth(std::shared_ptr<Creature> attacker, std::shared_pt
 						message.type = MESSAGE_DAMAGE_OTHERS;
 						message.text = spectatorMessage;
 					}
-					tmpPlayer->sendTextMessage(message);
+					sendCombatMessage(tmpPlayer, message);
 				}
 
 				damage.primary.value -= manaDamage;
@@ -7152,11 +7211,15 @@ bool Game::combatChangeHealth(std::shared_ptr<Creature> attacker, std::shared_pt
 			}
 		}
 
-		if (spectators.empty()) {
-			spectators.find<Player>(targetPos, true);
-		}
+		if (batch) {
+			batch->addHealthUpdate(target);
+		} else {
+			if (spectators.empty()) {
+				spectators.find<Player>(targetPos, true);
+			}
 
-		addCreatureHealth(spectators.data(), target);
+			addCreatureHealth(spectators.data(), target);
+		}
 
 		sendDamageMessageAndEffects(
 			attacker,
@@ -7217,6 +7280,14 @@ bool Game::shouldSendMessage(const TextMessage &message) const {
 	return message.primary.color != TEXTCOLOR_NONE || message.secondary.color != TEXTCOLOR_NONE;
 }
 
+void Game::sendCombatMessage(const std::shared_ptr<Player> &player, const TextMessage &message) {
+	if (const auto batch = CombatBatch::getActive()) {
+		batch->addTextMessage(player, message);
+	} else {
+		player->sendTextMessage(message);
+	}
+}
+
 void Game::sendMessages(
 	std::shared_ptr<Creature> attacker, std::shared_ptr<Creature> target, const CombatDamage &damage,
 	const Position &targetPos, std::shared_ptr<Player> attackerPlayer, std::shared_ptr<Player> targetPlayer,
@@ -7261,7 +7332,7 @@ void Game::sendMessages(
 		} else {
 			buildMessageAsSpectator(attacker, target, damage, targetPlayer, message, ss, damageString, spectatorMessage);
 		}
-		tmpPlayer->sendTextMessage(message);
+		sendCombatMessage(tmpPlayer, message);
 	}
 }
 
@@ -7660,9 +7731,10 @@ void Game::addCreatureHealth(const CreatureVector &spectators, std::shared_ptr<C
 			}
 		}
 	}
+	auto packet = ProtocolGame::creatureHealthPacket(target);
 	for (const auto &spectator : spectators) {
 		if (const auto &tmpPlayer = spectator->getPlayer()) {
-			tmpPlayer->sendCreatureHealth(target);
+			tmpPlayer->sendCreatureHealth(target, packet);
 		}
 	}
 }
@@ -7679,27 +7751,35 @@ void Game::addPlayerVocation(std::shared_ptr<Player> target) {
 		party->updatePlayerVocation(target);
 	}
 
-	for (const auto &spectator : Spectators().find<Player>(target->getPosition(), true)) {
+	for (const auto &spectator : Spectators::view<Player>(target->getPosition(), true)) {
 		spectator->getPlayer()->sendPlayerVocation(target);
 	}
 }
 
 void Game::addMagicEffect(const Position &pos, uint16_t effect) {
-	auto spectators = Spectators().find<Player>(pos, true);
-	addMagicEffect(spectators.data(), pos, effect);
+	auto packet = ProtocolGame::magicEffectPacket(pos, effect);
+	for (const auto &spectator : Spectators::view<Player>(pos, true)) {
+		if (const auto &tmpPlayer = spectator->getPlayer()) {
+			tmpPlayer->sendMagicEffect(pos, effect, packet);
+		}
+	}
 }
 
 void Game::addMagicEffect(const CreatureVector &spectators, const Position &pos, uint16_t effect) {
+	auto packet = ProtocolGame::magicEffectPacket(pos, effect);
 	for (const auto &spectator : spectators) {
 		if (const auto &tmpPlayer = spectator->getPlayer()) {
-			tmpPlayer->sendMagicEffect(pos, effect);
+			tmpPlayer->sendMagicEffect(pos, effect, packet);
 		}
 	}
 }
 
 void Game::removeMagicEffect(const Position &pos, uint16_t effect) {
-	auto spectators = Spectators().find<Player>(pos, true);
-	removeMagicEffect(spectators.data(), pos, effect);
+	for (const auto &spectator : Spectators::view<Player>(pos, true)) {
+		if (const auto &tmpPlayer = spectator->getPlayer()) {
+			tmpPlayer->removeMagicEffect(pos, effect);
+		}
+	}
 }
 
 void Game::removeMagicEffect(const CreatureVector &spectators, const Position &pos, uint16_t effect) {
@@ -7716,9 +7796,10 @@ void Game::addDistanceEffect(const Position &fromPos, const Position &toPos, uin
 }
 
 void Game::addDistanceEffect(const CreatureVector &spectators, const Position &fromPos, const Position &toPos, uint16_t effect) {
+	auto packet = ProtocolGame::distanceShootPacket(fromPos, toPos, effect);
 	for (const auto &spectator : spectators) {
 		if (const auto &tmpPlayer = spectator->getPlayer()) {
-			tmpPlayer->sendDistanceShoot(fromPos, toPos, effect);
+			tmpPlayer->sendDistanceShoot(fromPos, toPos, effect, packet);
 		}
 	}
 }
@@ -461,6 +461,8 @@ public:
 	void updateCreatureWalk(uint32_t creatureId);
 	void checkCreatureAttack(uint32_t creatureId);
 	void checkCreatures();
+	void decideMonsterThinks(std::vector<std::shared_ptr<Monster>> &&monsters);
+	void commitMonsterThinks(const std::vector<std::shared_ptr<Monster>> &monsters);
 	void checkLight();
 
 	bool combatBlockHit(CombatDamage &damage, std::shared_ptr<Creature> attacker, std::shared_ptr<Creature> target, bool checkDefense, bool checkArmor, bool field);
@@ -914,6 +916,9 @@ private:
 
 	bool shouldSendMessage(const TextMessage &message) const;
 
+	// Sends right away, or queues in the active CombatBatch of an area cast.
+	static void sendCombatMessage(const std::shared_ptr<Player> &player, const TextMessage &message);
+
 	void buildMessageAsAttacker(
 		std::shared_ptr<Creature> target, const CombatDamage &damage, TextMessage &message,
 		std::stringstream &ss, const std::string &damageString
@@ -25,6 +25,7 @@ void Dispatcher::init() {
 
 	threadPool.addLoad([this] {
 		std::unique_lock asyncLock(dummyMutex);
+		dispatcherThreadId = ThreadPool::getThreadId();
 
 		while (!threadPool.getIoContext().stopped()) {
 			UPDATE_OTSYS_TIME();
@@ -32,6 +33,7 @@ void Dispatcher::init() {
 			executeEvents();
 			executeScheduledEvents();
 			mergeEvents();
+			loopCount.fetch_add(1, std::memory_order_release);
 
 			if (!hasPendingTasks) {
 				signalSchedule.wait_for(asyncLock, timeUntilNextScheduledTask());
@@ -56,6 +58,11 @@ void Dispatcher::executeSerialEvents(std::vector<Task> &tasks) {
 }
 
 void Dispatcher::executeParallelEvents(std::vector<Task> &tasks, const uint8_t groupId) {
+	if (workStealing.load(std::memory_order_relaxed)) {
+		executeParallelEventsWorkStealing(tasks, groupId);
+		return;
+	}
+
 	std::atomic_uint_fast64_t totalTaskSize = tasks.size();
 	std::atomic_bool isTasksCompleted = false;
 
@@ -82,6 +89,63 @@ void Dispatcher::executeParallelEvents(std::vector<Task> &tasks, const uint8_t g
 	tasks.clear();
 }
 
+void Dispatcher::executeParallelEventsWorkStealing(std::vector<Task> &tasks, const uint8_t groupId) {
+	// The dispatcher itself runs on one of the pool threads, so it works as worker 0.
+	const size_t workers = std::min<size_t>(threadPool.getNumberOfThreads(), tasks.size());
+	const size_t chunkSize = tasks.size() / workers;
+	const size_t remainder = tasks.size() % workers;
+
+	size_t begin = 0;
+	for (size_t i = 0; i < workers; ++i) {
+		auto &queue = stealingQueues[i];
+		queue.end = begin + chunkSize + (i < remainder ? 1 : 0);
+		queue.next.store(begin, std::memory_order_relaxed);
+		begin = queue.end;
+	}
+
+	// Helpers that only start once the dispatcher drained every range have nothing left to run,
+	// so it waits just for the helpers still running tasks of this round and lets the late ones leave.
+	const auto round = parallelRound.load();
+	for (size_t workerId = 1; workerId < workers; ++workerId) {
+		threadPool.addLoad([this, &tasks, groupId, workerId, workers, round] {
+			runningWorkers.fetch_add(1);
+			if (parallelRound.load() == round) {
+				drainStealingQueues(tasks, groupId, workerId, workers);
+			}
+
+			if (runningWorkers.fetch_sub(1) == 1) {
+				runningWorkers.notify_one();
+			}
+		});
+	}
+
+	drainStealingQueues(tasks, groupId, 0, workers);
+
+	parallelRound.fetch_add(1);
+	for (size_t running = runningWorkers.load(); running != 0; running = runningWorkers.load()) {
+		runningWorkers.wait(running);
+	}
+
+	tasks.clear();
+}
+
+void Dispatcher::drainStealingQueues(std::vector<Task> &tasks, const uint8_t groupId, size_t workerId, size_t workers) {
+	dispacherContext.type = DispatcherType::AsyncEvent;
+	dispacherContext.group = static_cast<TaskGroup>(groupId);
+
+	// Drain its own range first, then steal from the other workers' ranges.
+	for (size_t offset = 0; offset < workers; ++offset) {
+		auto &queue = stealingQueues[(workerId + offset) % workers];
+		for (size_t index = queue.next.fetch_add(1, std::memory_order_relaxed); index < queue.end; index = queue.next.fetch_add(1, std::memory_order_relaxed)) {
+			const auto &task = tasks[index];
+			dispacherContext.taskName = task.getContext();
+			task.execute();
+		}
+	}
+
+	dispacherContext.reset();
+}
+
 void Dispatcher::executeEvents(const TaskGroup startGroup) {
 	for (uint_fast8_t groupId = static_cast<uint8_t>(startGroup); groupId < static_cast<uint8_t>(TaskGroup::Last); ++groupId) {
 		auto &tasks = m_tasks[groupId];
@@ -99,32 +163,18 @@ void Dispatcher::executeEvents(const TaskGroup startGroup) {
 }
 
 void Dispatcher::executeScheduledEvents() {
-	auto &threadScheduledTasks = getThreadTask()->scheduledTasks;
-
-	auto it = scheduledTasks.begin();
-	while (it != scheduledTasks.end()) {
-		const auto &task = *it;
-		if (task->getTime() > OTSYS_TIME()) {
-			break;
-		}
-
-		dispacherContext.type = task->isCycle() ? DispatcherType::CycleEvent : DispatcherType::ScheduledEvent;
+	scheduledTasks.expire(OTSYS_TIME(), [](Task &task) {
+		dispacherContext.type = task.isCycle() ? DispatcherType::CycleEvent : DispatcherType::ScheduledEvent;
 		dispacherContext.group = TaskGroup::Serial;
-		dispacherContext.taskName = task->getContext();
+		dispacherContext.taskName = task.getContext();
 
-		if (task->execute() && task->isCycle()) {
-			task->updateTime();
-			threadScheduledTasks.emplace_back(task);
-		} else {
-			scheduledTasksRef.erase(task->getId());
+		if (task.execute() && task.isCycle()) {
+			task.updateTime();
+			return true;
 		}
 
-		++it;
-	}
-
-	if (it != scheduledTasks.begin()) {
-		scheduledTasks.erase(scheduledTasks.begin(), it);
-	}
+		return false;
+	});
 
 	dispacherContext.reset();
 
@@ -138,7 +188,31 @@ void Dispatcher::mergeAsyncEvents() {
 	constexpr uint8_t end = static_cast<uint8_t>(TaskGroup::Last);
 
 	for (const auto &thread : threads) {
+		if (auto* node = thread->parallelTasks.exchange(nullptr, std::memory_order_acquire)) {
+			// The stack is newest first, reverse it to keep the order the events were posted in
+			ParallelTaskNode* oldest = nullptr;
+			while (node) {
+				oldest = std::exchange(node, std::exchange(node->next, oldest));
+			}
+
+			auto &tasks = m_tasks[static_cast<uint8_t>(TaskGroup::GenericParallel)];
+			ParallelTaskNode* newest = nullptr;
+			for (auto* it = oldest; it; it = it->next) {
+				tasks.emplace_back(std::move(it->task));
+				newest = it;
+			}
+
+			// Hand the nodes back to the thread that posted them, it reuses them for its next events
+			newest->next = thread->releasedParallelTasks.load(std::memory_order_relaxed);
+			while (!thread->releasedParallelTasks.compare_exchange_weak(newest->next, oldest, std::memory_order_release, std::memory_order_relaxed)) { }
+		}
+
+		if (!thread->hasParallelTasks.load(std::memory_order_acquire)) {
+			continue;
+		}
+
 		std::scoped_lock lock(thread->mutex);
+		thread->hasParallelTasks.store(false, std::memory_order_relaxed);
 		for (uint_fast8_t i = start; i < end; ++i) {
 			if (!thread->tasks[i].empty()) {
 				m_tasks[i].insert(m_tasks[i].end(), make_move_iterator(thread->tasks[i].begin()), make_move_iterator(thread->tasks[i].end()));
@@ -160,7 +234,10 @@ void Dispatcher::mergeEvents() {
 		}
 
 		if (!thread->scheduledTasks.empty()) {
-			scheduledTasks.insert(make_move_iterator(thread->scheduledTasks.begin()), make_move_iterator(thread->scheduledTasks.end()));
+			const auto now = OTSYS_TIME();
+			for (const auto eventId : thread->scheduledTasks) {
+				scheduledTasks.insert(eventId, now);
+			}
 			thread->scheduledTasks.clear();
 		}
 	}
@@ -169,16 +246,7 @@ void Dispatcher::mergeEvents() {
 }
 
 std::chrono::milliseconds Dispatcher::timeUntilNextScheduledTask() const {
-	constexpr auto CHRONO_0 = std::chrono::milliseconds(0);
-	constexpr auto CHRONO_MILI_MAX = std::chrono::milliseconds::max();
-
-	if (scheduledTasks.empty()) {
-		return CHRONO_MILI_MAX;
-	}
-
-	const auto &task = *scheduledTasks.begin();
-	const auto timeRemaining = std::chrono::milliseconds(task->getTime() - OTSYS_TIME());
-	return std::max<std::chrono::milliseconds>(timeRemaining, CHRONO_0);
+	return scheduledTasks.timeUntilNextExpiration(OTSYS_TIME());
 }
 
 void Dispatcher::addEvent(std::function<void(void)> &&f, std::string_view context, uint32_t expiresAfterMs) {
@@ -189,12 +257,15 @@ void Dispatcher::addEvent(std::function<void(void)> &&f, std::string_view contex
 }
 
 uint64_t Dispatcher::scheduleEvent(const std::shared_ptr<Task> &task) {
+	return scheduleEvent(std::move(*task));
+}
+
+uint64_t Dispatcher::scheduleEvent(Task &&task) {
+	const auto eventId = scheduledTasks.create(std::move(task));
+
 	const auto &thread = getThreadTask();
 	std::scoped_lock lock(thread->mutex);
-
-	auto eventId = scheduledTasksRef
-					   .emplace(task->getId(), thread->scheduledTasks.emplace_back(task))
-					   .first->first;
+	thread->scheduledTasks.emplace_back(eventId);
 
 	notify();
 	return eventId;
@@ -202,17 +273,32 @@ uint64_t Dispatcher::scheduleEvent(const std::shared_ptr<Task> &task) {
 
 void Dispatcher::asyncEvent(std::function<void(void)> &&f, TaskGroup group) {
 	const auto &thread = getThreadTask();
+	if (workStealing.load(std::memory_order_relaxed) && group == TaskGroup::GenericParallel) {
+		if (!thread->freeParallelTasks) {
+			thread->freeParallelTasks = thread->releasedParallelTasks.exchange(nullptr, std::memory_order_acquire);
+		}
+
+		auto* node = thread->freeParallelTasks;
+		if (node) {
+			thread->freeParallelTasks = node->next;
+			node->task = Task(0, std::move(f), dispacherContext.taskName);
+		} else {
+			node = new ParallelTaskNode { Task(0, std::move(f), dispacherContext.taskName) };
+		}
+		node->next = thread->parallelTasks.load(std::memory_order_relaxed);
+		while (!thread->parallelTasks.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) { }
+		notify();
+		return;
+	}
+
 	std::scoped_lock lock(thread->mutex);
 	thread->tasks[static_cast<uint8_t>(group)].emplace_back(0, std::move(f), dispacherContext.taskName);
+	thread->hasParallelTasks.store(true, std::memory_order_release);
 	notify();
 }
 
 void Dispatcher::stopEvent(uint64_t eventId) {
-	const auto &it = scheduledTasksRef.find(eventId);
-	if (it != scheduledTasksRef.end()) {
-		it->second->cancel();
-		scheduledTasksRef.erase(it);
-	}
+	scheduledTasks.cancel(eventId, ThreadPool::getThreadId() == dispatcherThreadId);
 }
 
 void DispatcherContext::addEvent(std::function<void(void)> &&f) const {
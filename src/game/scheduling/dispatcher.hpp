@@ -10,6 +10,7 @@
 #pragma once
 
 #include "task.hpp"
+#include "timer_wheel.hpp"
 #include "lib/thread/thread_pool.hpp"
 
 static constexpr uint16_t DISPATCHER_TASK_EXPIRATION = 2000;
@@ -88,6 +89,8 @@ public:
 		for (uint_fast16_t i = 0; i < threads.capacity(); ++i) {
 			threads.emplace_back(std::make_unique<ThreadTask>());
 		}
+
+		stealingQueues = std::make_unique<StealingQueue[]>(threadPool.getNumberOfThreads());
 	};
 
 	// Ensures that we don't accidentally copy it
@@ -125,8 +128,19 @@ public:
 		return dispatcherCycle;
 	}
 
+	// Iterations of the dispatcher loop. It only advances once the parallel tasks of the
+	// iteration are done, so it can tell when nothing from a previous iteration still runs.
+	[[nodiscard]] uint64_t getLoopCount() const {
+		return loopCount.load(std::memory_order_acquire);
+	}
+
 	void stopEvent(uint64_t eventId);
 
+	// Read once the config is loaded or reloaded, see toggleDispatcherWorkStealing.
+	void setWorkStealing(bool enabled) {
+		workStealing.store(enabled, std::memory_order_relaxed);
+	}
+
 	const auto &context() const {
 		return dispacherContext;
 	}
@@ -139,9 +153,11 @@ private:
 	}
 
 	uint64_t scheduleEvent(uint32_t delay, std::function<void(void)> &&f, std::string_view context, bool cycle, bool log = true) {
-		return scheduleEvent(std::make_shared<Task>(std::move(f), context, delay, cycle, log));
+		return scheduleEvent(Task(std::move(f), context, delay, cycle, log));
 	}
 
+	uint64_t scheduleEvent(Task &&task);
+
 	void init();
 	void shutdown() {
 		signalSchedule.notify_all();
@@ -154,6 +170,8 @@ private:
 
 	inline void executeSerialEvents(std::vector<Task> &tasks);
 	inline void executeParallelEvents(std::vector<Task> &tasks, const uint8_t groupId);
+	inline void executeParallelEventsWorkStealing(std::vector<Task> &tasks, const uint8_t groupId);
+	inline void drainStealingQueues(std::vector<Task> &tasks, const uint8_t groupId, size_t workerId, size_t workers);
 	inline std::chrono::milliseconds timeUntilNextScheduledTask() const;
 
 	inline void checkPendingTasks() {
@@ -167,6 +185,12 @@ private:
 	}
 
 	void notify() {
+		// The dispatcher merges the events of its own tasks and of its parallel phase before
+		// deciding to sleep, only events coming from the other threads need to wake it up.
+		if (workStealing.load(std::memory_order_relaxed) && (ThreadPool::getThreadId() == dispatcherThreadId || dispacherContext.isGroup(TaskGroup::GenericParallel))) {
+			return;
+		}
+
 		if (!hasPendingTasks) {
 			hasPendingTasks = true;
 			signalSchedule.notify_one();
@@ -174,12 +198,19 @@ private:
 	}
 
 	uint_fast64_t dispatcherCycle = 0;
+	std::atomic_uint64_t loopCount = 0;
 
 	ThreadPool &threadPool;
 	std::condition_variable signalSchedule;
 	std::atomic_bool hasPendingTasks = false;
 	std::mutex dummyMutex; // This is only used for signaling the condition variable and not as an actual lock.
 
+	// Parallel events posted in work-stealing mode, pushed without lock to a per-thread stack.
+	struct ParallelTaskNode {
+		Task task;
+		ParallelTaskNode* next = nullptr;
+	};
+
 	// Thread Events
 	struct ThreadTask {
 		ThreadTask() {
@@ -189,16 +220,46 @@ private:
 			scheduledTasks.reserve(2000);
 		}
 
+		~ThreadTask() {
+			for (auto* list : { parallelTasks.load(), releasedParallelTasks.load(), freeParallelTasks }) {
+				for (auto* node = list; node != nullptr;) {
+					delete std::exchange(node, node->next);
+				}
+			}
+		}
+
 		std::array<std::vector<Task>, static_cast<uint8_t>(TaskGroup::Last)> tasks;
-		std::vector<std::shared_ptr<Task>> scheduledTasks;
+		// Event ids created by this thread, they are linked to the timer wheel on merge.
+		std::vector<uint64_t> scheduledTasks;
 		std::mutex mutex;
+
+		// Work-stealing mode only: newest first, taken at once by mergeAsyncEvents.
+		std::atomic<ParallelTaskNode*> parallelTasks = nullptr;
+		// Nodes already merged, handed back by mergeAsyncEvents and moved to freeParallelTasks by the owner.
+		std::atomic<ParallelTaskNode*> releasedParallelTasks = nullptr;
+		// Only touched by the thread that owns this ThreadTask.
+		ParallelTaskNode* freeParallelTasks = nullptr;
+		// Set when tasks holds parallel events, so merging doesn't lock threads that posted none.
+		std::atomic_bool hasParallelTasks = false;
 	};
 	std::vector<std::unique_ptr<ThreadTask>> threads;
 
+	// Work-stealing ranges used by executeParallelEventsWorkStealing, one per worker.
+	// Owner and thieves claim task indexes through the same atomic cursor, so no lock is needed.
+	struct alignas(64) StealingQueue {
+		std::atomic_size_t next = 0;
+		size_t end = 0;
+	};
+	std::unique_ptr<StealingQueue[]> stealingQueues;
+	std::atomic_bool workStealing = false;
+	// Bumped once the dispatcher drained a round, helpers of an older round skip draining.
+	std::atomic_uint64_t parallelRound = 0;
+	std::atomic_size_t runningWorkers = 0;
+
 	// Main Events
 	std::array<std::vector<Task>, static_cast<uint8_t>(TaskGroup::Last)> m_tasks;
-	phmap::btree_multiset<std::shared_ptr<Task>, Task::Compare> scheduledTasks;
-	phmap::parallel_flat_hash_map_m<uint64_t, std::shared_ptr<Task>> scheduledTasksRef;
+	TimerWheel scheduledTasks { SCHEDULER_MINTICKS };
+	std::atomic_int16_t dispatcherThreadId = -1;
 
 	friend class CanaryServer;
 };
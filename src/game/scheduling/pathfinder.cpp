@@ -0,0 +1,83 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "game/scheduling/pathfinder.hpp"
+#include "game/scheduling/dispatcher.hpp"
+#include "creatures/creature.hpp"
+#include "lib/metrics/metrics.hpp"
+
+Pathfinder::Pathfinder(ThreadPool &threadPool) :
+	threadPool(threadPool) { }
+
+Pathfinder &Pathfinder::getInstance() {
+	return inject<Pathfinder>();
+}
+
+void Pathfinder::request(const std::shared_ptr<Creature> &creature) {
+	bool dispatchSolver = false;
+	{
+		std::scoped_lock lock(mutex);
+		pending.emplace_back(creature);
+
+		// One solver for each started batch, they keep taking batches until the queue is empty.
+		const size_t maxSolvers = std::max<size_t>(1, threadPool.getNumberOfThreads());
+		if (runningSolvers < maxSolvers && pending.size() > runningSolvers * BATCH_SIZE) {
+			++runningSolvers;
+			dispatchSolver = true;
+		}
+	}
+
+	g_metrics().addUpDownCounter("pathfinder_queue", 1);
+
+	if (dispatchSolver) {
+		g_dispatcher().asyncEvent([this] { solve(); });
+	}
+}
+
+void Pathfinder::solve() {
+	std::vector<std::shared_ptr<Creature>> batch;
+	batch.reserve(BATCH_SIZE);
+
+	while (true) {
+		{
+			std::scoped_lock lock(mutex);
+			if (pending.empty()) {
+				--runningSolvers;
+				return;
+			}
+
+			const size_t size = std::min(BATCH_SIZE, pending.size());
+			std::move(pending.begin(), pending.begin() + size, std::back_inserter(batch));
+			pending.erase(pending.begin(), pending.begin() + size);
+		}
+
+		g_metrics().addUpDownCounter("pathfinder_queue", -static_cast<int>(batch.size()));
+
+		std::vector<std::pair<std::shared_ptr<Creature>, FollowPath>> results;
+		results.reserve(batch.size());
+
+		for (auto &creature : batch) {
+			metrics::pathfinder_latency measure(creature->getPlayer() ? "player" : (creature->getMonster() ? "monster" : "npc"));
+			auto path = creature->findFollowPath();
+			results.emplace_back(std::move(creature), std::move(path));
+		}
+		batch.clear();
+
+		g_dispatcher().addEvent(
+			[results = std::move(results)] {
+				for (const auto &[creature, path] : results) {
+					creature->onFollowPathFound(path);
+				}
+			},
+			"Pathfinder::deliver"
+		);
+	}
+}
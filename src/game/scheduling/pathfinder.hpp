@@ -0,0 +1,70 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "lib/thread/thread_pool.hpp"
+#include "game/movement/position.hpp"
+
+class Creature;
+
+/**
+ * Result of a follow path search, computed on a worker and applied on the dispatcher.
+ */
+struct FollowPath {
+	std::weak_ptr<Creature> target;
+	// Position of the creature when the path was searched, the path is discarded if it moved meanwhile.
+	Position from;
+	std::vector<Direction> directions;
+	bool hasPath = false;
+	bool executeOnFollow = true;
+	// Summons that can't reach their master just stop walking.
+	bool cancelWalk = false;
+};
+
+/**
+ * Solves the follow paths requested by Creature::onThink and Game::checkCreatureWalk in batches.
+ *
+ * Requests made during a dispatcher cycle are queued and drained by a few solver tasks
+ * dispatched with Dispatcher::asyncEvent. They run in the dispatcher parallel phase, while
+ * no serial event can change the map, so the solvers read the tiles as an immutable snapshot
+ * without copying them. Results are posted back with Dispatcher::addEvent and applied by
+ * the dispatcher thread, the only one allowed to start a walk.
+ */
+class Pathfinder {
+public:
+	explicit Pathfinder(ThreadPool &threadPool);
+
+	// Ensures that we don't accidentally copy it
+	Pathfinder(const Pathfinder &) = delete;
+	Pathfinder operator=(const Pathfinder &) = delete;
+
+	static Pathfinder &getInstance();
+
+	void request(const std::shared_ptr<Creature> &creature);
+
+	[[nodiscard]] size_t getQueueSize() {
+		std::scoped_lock lock(mutex);
+		return pending.size();
+	}
+
+private:
+	// Requests taken by a solver at once, results of a batch are delivered in a single event.
+	static constexpr size_t BATCH_SIZE = 32;
+
+	void solve();
+
+	std::mutex mutex;
+	std::deque<std::shared_ptr<Creature>> pending;
+	size_t runningSolvers = 0;
+
+	ThreadPool &threadPool;
+};
+
+constexpr auto g_pathfinder = Pathfinder::getInstance;
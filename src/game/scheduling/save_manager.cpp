@@ -1,8 +1,12 @@
 #include "pch.hpp"
 
 #include "game/game.hpp"
+#include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/save_manager.hpp"
 #include "io/iologindata.hpp"
+#include "io/ioguild.hpp"
+#include "io/iomapserialize.hpp"
+#include "lib/metrics/metrics.hpp"
 
 SaveManager::SaveManager(ThreadPool &threadPool, KVStore &kvStore, Logger &logger, Game &game) :
 	threadPool(threadPool), kv(kvStore), logger(logger), game(game) { }
@@ -14,20 +18,8 @@ SaveManager &SaveManager::getInstance() {
 void SaveManager::saveAll() {
 	Benchmark bm_saveAll;
 	logger.info("Saving server...");
-	const auto players = game.getPlayers();
-
-	for (const auto &[_, player] : players) {
-		player->loginPosition = player->getPosition();
-		doSavePlayer(player);
-	}
-
-	auto guilds = game.getGuilds();
-	for (const auto &[_, guild] : guilds) {
-		saveGuild(guild);
-	}
 
-	saveMap();
-	saveKV();
+	writeAll(snapshotAll());
 	logger.info("Server saved in {} milliseconds.", bm_saveAll.duration());
 }
 
@@ -41,15 +33,203 @@ void SaveManager::scheduleAll() {
 		return;
 	}
 
-	threadPool.addLoad([this, scheduledAt]() {
+	// The snapshot is taken here, on the game thread, only the writes run in background
+	auto batches = std::make_shared<std::vector<SaveBatch>>(snapshotAll());
+	threadPool.addLoad([this, scheduledAt, batches]() {
 		if (m_scheduledAt.load() != scheduledAt) {
 			logger.warn("Skipping save for server because another save has been scheduled.");
+			for (auto &batch : *batches) {
+				skipBatch(batch);
+			}
 			return;
 		}
-		saveAll();
+
+		Benchmark bm_saveAll;
+		writeAll(std::move(*batches));
+		logger.info("Server saved in {} milliseconds.", bm_saveAll.duration());
 	});
 }
 
+std::vector<SaveManager::SaveBatch> SaveManager::snapshotAll() {
+	metrics::save_latency measure("snapshot");
+	Benchmark bm_snapshot;
+	std::vector<SaveBatch> batches;
+
+	const auto players = game.getPlayers();
+	batches.reserve(players.size() + 2);
+
+	{
+		metrics::save_latency measurePlayers("snapshot_players");
+		for (const auto &[_, player] : players) {
+			Player::PlayerLock lock(player);
+			player->loginPosition = player->getPosition();
+
+			if (auto batch = recordPlayer(player)) {
+				batches.emplace_back(std::move(*batch));
+			}
+		}
+	}
+
+	{
+		metrics::save_latency measureGuilds("snapshot_guilds");
+		DBQueryRecorder recorder;
+		for (const auto &[_, guild] : game.getGuilds()) {
+			IOGuild::saveGuild(guild);
+		}
+		batches.emplace_back("write_guilds", "guilds", recorder.release());
+	}
+
+	{
+		metrics::save_latency measureHouses("snapshot_houses");
+		batches.emplace_back("write_houses", "house info", IOMapSerialize::recordHouseInfo(), HOUSE_SAVE_TRIES);
+		batches.emplace_back("write_houses", "house items", IOMapSerialize::recordHouseItems(), HOUSE_SAVE_TRIES);
+	}
+
+	logger.debug("Save snapshot of {} batches taken in {} milliseconds.", batches.size(), bm_snapshot.duration());
+	return batches;
+}
+
+void SaveManager::writeAll(std::vector<SaveBatch> &&batches) {
+	metrics::save_latency measure("write");
+	std::scoped_lock writeLock(writeMutex);
+
+	struct WriteJob {
+		std::vector<SaveBatch> batches;
+		std::atomic_size_t next = 0;
+		std::atomic_size_t pending = 0;
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+
+	// The key-value store has its own transaction, it is written as one more job
+	auto job = std::make_shared<WriteJob>();
+	job->batches = std::move(batches);
+	job->pending = job->batches.size() + 1;
+
+	const auto drain = [this](const std::shared_ptr<WriteJob> &job) {
+		const size_t total = job->batches.size() + 1;
+		for (size_t index = job->next++; index < total; index = job->next++) {
+			if (index == job->batches.size()) {
+				saveKV();
+			} else {
+				writeBatch(job->batches[index]);
+			}
+
+			if (--job->pending == 0) {
+				std::scoped_lock lock(job->mutex);
+				job->finished.notify_all();
+			}
+		}
+	};
+
+	// Writers late to start find nothing left to take, the caller drains the jobs too,
+	// so the save completes even when every thread of the pool is busy.
+	const size_t writers = std::min<size_t>({ MAX_WRITERS, job->pending.load(), threadPool.getNumberOfThreads() });
+	for (size_t i = 1; i < writers; ++i) {
+		threadPool.addLoad([drain, job] { drain(job); });
+	}
+	drain(job);
+
+	std::unique_lock lock(job->mutex);
+	job->finished.wait(lock, [&job] { return job->pending.load() == 0; });
+}
+
+bool SaveManager::writeBatch(SaveBatch &batch) {
+	metrics::save_latency measure(batch.stage);
+	Benchmark bm_write;
+
+	const auto execute = [&batch] {
+		for (uint32_t attempt = 0; attempt < batch.tries; ++attempt) {
+			if (DBQueryRecorder::execute(batch.queries)) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	bool success;
+	if (batch.player) {
+		std::scoped_lock playerWriteLock(m_playerWriteMutexes[batch.player->getGUID() % m_playerWriteMutexes.size()]);
+		if (!releasePlayerSave(batch.player->getGUID(), batch.sequence)) {
+			logger.debug("Skipping save for player {} because a newer save has been recorded.", batch.name);
+			handBackSaveState(batch, WriteResult::Skipped);
+			return true;
+		}
+
+		success = execute();
+		// Still under the write lock, so the results reach the dispatcher in the order they were written
+		handBackSaveState(batch, success ? WriteResult::Written : WriteResult::Failed);
+	} else {
+		success = execute();
+	}
+
+	if (!success) {
+		logger.error("Failed to save {}.", batch.name);
+		return false;
+	}
+
+	logger.debug("Saving {} took {} milliseconds.", batch.name, bm_write.duration());
+	return true;
+}
+
+void SaveManager::skipBatch(SaveBatch &batch) {
+	if (batch.player) {
+		releasePlayerSave(batch.player->getGUID(), batch.sequence);
+		handBackSaveState(batch, WriteResult::Skipped);
+	}
+}
+
+std::optional<SaveManager::SaveBatch> SaveManager::recordPlayer(const std::shared_ptr<Player> &player) {
+	auto queries = IOLoginData::recordSavePlayer(player);
+	if (!queries) {
+		logger.error("Failed to save player {}.", player->getName());
+		return std::nullopt;
+	}
+
+	const uint64_t sequence = ++m_saveSequence;
+	{
+		std::scoped_lock lock(m_playerSavesMutex);
+		auto &saves = m_playerSaves[player->getGUID()];
+		saves.latest = sequence;
+		++saves.pending;
+	}
+
+	return SaveBatch { "write_player", player->getName(), std::move(*queries), 1, player, player->saveState.takeStaged(), sequence };
+}
+
+bool SaveManager::releasePlayerSave(uint32_t guid, uint64_t sequence) {
+	std::scoped_lock lock(m_playerSavesMutex);
+	const auto it = m_playerSaves.find(guid);
+	if (it == m_playerSaves.end()) {
+		return true;
+	}
+
+	const bool latest = it->second.latest == sequence;
+	if (--it->second.pending == 0) {
+		m_playerSaves.erase(it);
+	}
+	return latest;
+}
+
+void SaveManager::handBackSaveState(SaveBatch &batch, WriteResult result) {
+	if (!batch.player) {
+		return;
+	}
+
+	// The save state belongs to the dispatcher, which may be recording the next save meanwhile
+	g_dispatcher().addEvent(
+		[player = batch.player, staged = std::move(batch.saveState), result]() mutable {
+			Player::PlayerLock lock(player);
+			if (result == WriteResult::Skipped) {
+				player->saveState.discard();
+				return;
+			}
+			IOLoginData::onPlayerSaved(player, std::move(staged), result == WriteResult::Written);
+		},
+		"SaveManager::handBackSaveState"
+	);
+}
+
 void SaveManager::schedulePlayer(std::weak_ptr<Player> playerPtr) {
 	auto playerToSave = playerPtr.lock();
 	if (!playerToSave) {
@@ -67,19 +247,20 @@ void SaveManager::schedulePlayer(std::weak_ptr<Player> playerPtr) {
 	}
 
 	logger.debug("Scheduling player {} for saving.", playerToSave->getName());
-	auto scheduledAt = std::chrono::steady_clock::now();
-	m_playerMap[playerToSave->getGUID()] = scheduledAt;
-	threadPool.addLoad([this, playerPtr, scheduledAt]() {
-		auto player = playerPtr.lock();
-		if (!player) {
-			logger.debug("Skipping save for player because player is no longer online.");
+	std::shared_ptr<SaveBatch> batch;
+	{
+		// Recorded here, on the game thread, only the write runs in background
+		Player::PlayerLock lock(playerToSave);
+		auto recorded = recordPlayer(playerToSave);
+		if (!recorded) {
 			return;
 		}
-		if (m_playerMap[player->getGUID()] != scheduledAt) {
-			logger.warn("Skipping save for player because another save has been scheduled.");
-			return;
-		}
-		doSavePlayer(player);
+		batch = std::make_shared<SaveBatch>(std::move(*recorded));
+	}
+
+	// Skipped by writeBatch when another save of the player is recorded before it runs
+	threadPool.addLoad([this, batch]() {
+		writeBatch(*batch);
 	});
 }
 
@@ -91,15 +272,13 @@ bool SaveManager::doSavePlayer(std::shared_ptr<Player> player) {
 
 	Benchmark bm_savePlayer;
 	Player::PlayerLock lock(player);
-	m_playerMap.erase(player->getGUID());
 	if (g_game().getGameState() == GAME_STATE_NORMAL) {
 		logger.debug("Saving player {}.", player->getName());
 	}
 
-	bool saveSuccess = IOLoginData::savePlayer(player);
-	if (!saveSuccess) {
-		logger.error("Failed to save player {}.", player->getName());
-	}
+	// Written right away, but in order with the saves of the player still being written by the pool
+	auto batch = recordPlayer(player);
+	bool saveSuccess = batch && writeBatch(*batch);
 
 	auto duration = bm_savePlayer.duration();
 	logger.debug("Saving player {} took {} milliseconds.", player->getName(), duration);
@@ -128,18 +307,6 @@ void SaveManager::saveGuild(std::shared_ptr<Guild> guild) {
 	logger.debug("Saving guild {} took {} milliseconds.", guild->getName(), duration);
 }
 
-void SaveManager::saveMap() {
-	Benchmark bm_saveMap;
-	logger.debug("Saving map...");
-	bool saveSuccess = Map::save();
-	if (!saveSuccess) {
-		logger.error("Failed to save map.");
-	}
-
-	auto duration = bm_saveMap.duration();
-	logger.debug("Map saved in {} milliseconds.", duration);
-}
-
 void SaveManager::saveKV() {
 	Benchmark bm_saveKV;
 	logger.debug("Saving key-value store...");
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "database/database.hpp"
+#include "io/functions/player_save_state.hpp"
 #include "lib/thread/thread_pool.hpp"
 #include "kv/kv.hpp"
 
@@ -28,14 +30,63 @@ public:
 	void saveGuild(std::shared_ptr<Guild> guild);
 
 private:
-	void saveMap();
+	// Queries recorded on the game thread, executed later by a writer.
+	struct SaveBatch {
+		std::string_view stage;
+		std::string name;
+		std::vector<DBQuery> queries;
+		uint32_t tries = 1;
+		// Player batches hand the rows they staged back to the player save state once written.
+		std::shared_ptr<Player> player;
+		PlayerSaveState::Staged saveState;
+		// Order of the player batch among every recorded save.
+		uint64_t sequence = 0;
+	};
+
+	// Saves of a player recorded and not written yet.
+	struct PlayerSaves {
+		uint64_t latest = 0;
+		uint32_t pending = 0;
+	};
+
+	// Writers running at once, each transaction holds one connection of the database pool.
+	static constexpr size_t MAX_WRITERS = 4;
+	// Attempts of the house batches, as Map::save did.
+	static constexpr uint32_t HOUSE_SAVE_TRIES = 6;
+
+	enum class WriteResult : uint8_t {
+		Written,
+		Failed,
+		Skipped,
+	};
+
+	std::vector<SaveBatch> snapshotAll();
+	void writeAll(std::vector<SaveBatch> &&batches);
+	bool writeBatch(SaveBatch &batch);
+	void skipBatch(SaveBatch &batch);
+
+	// Records the save of a player, the caller holds the player lock.
+	std::optional<SaveBatch> recordPlayer(const std::shared_ptr<Player> &player);
+	// Called once for every recorded player batch, returns false when a newer save of the player was recorded.
+	bool releasePlayerSave(uint32_t guid, uint64_t sequence);
+	// Every recorded player batch must hand its staged rows back, written or not.
+	static void handBackSaveState(SaveBatch &batch, WriteResult result);
+
 	void saveKV();
 
 	void schedulePlayer(std::weak_ptr<Player> player);
 	bool doSavePlayer(std::shared_ptr<Player> player);
 
 	std::atomic<std::chrono::steady_clock::time_point> m_scheduledAt;
-	phmap::parallel_flat_hash_map<uint32_t, std::chrono::steady_clock::time_point> m_playerMap;
+	std::mutex writeMutex;
+
+	// A player batch older than the latest save recorded for the player is dropped, that save
+	// rewrites every table it would have written. Sequences are only taken on the dispatcher.
+	uint64_t m_saveSequence = 0;
+	std::mutex m_playerSavesMutex;
+	phmap::flat_hash_map<uint32_t, PlayerSaves> m_playerSaves;
+	// Writes of the same player never overlap, the mutexes are shared by guid.
+	std::array<std::mutex, 16> m_playerWriteMutexes;
 
 	ThreadPool &threadPool;
 	KVStore &kv;
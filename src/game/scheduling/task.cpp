@@ -14,8 +14,6 @@
 #include "lib/logging/log_with_spd_log.hpp"
 #include "lib/metrics/metrics.hpp"
 
-std::atomic_uint_fast64_t Task::LAST_EVENT_ID = 0;
-
 Task::Task(uint32_t expiresAfterMs, std::function<void(void)> &&f, std::string_view context) :
 	func(std::move(f)), context(context), utime(OTSYS_TIME()), expiration(expiresAfterMs > 0 ? OTSYS_TIME() + expiresAfterMs : 0) {
 	if (this->context.empty()) {
@@ -17,20 +17,6 @@ public:
 
 	Task(std::function<void(void)> &&f, std::string_view context, uint32_t delay, bool cycle = false, bool log = true);
 
-	~Task() = default;
-
-	uint64_t getId() {
-		if (id == 0) {
-			if (++LAST_EVENT_ID == 0) {
-				LAST_EVENT_ID = 1;
-			}
-
-			id = LAST_EVENT_ID;
-		}
-
-		return id;
-	}
-
 	uint32_t getDelay() const {
 		return delay;
 	}
@@ -62,8 +48,6 @@ public:
 	bool execute() const;
 
 private:
-	static std::atomic_uint_fast64_t LAST_EVENT_ID;
-
 	void updateTime() {
 		utime = OTSYS_TIME() + delay;
 	}
@@ -88,9 +72,8 @@ private:
 			"ProtocolGame::addGameTask",
 			"ProtocolGame::parsePacketFromDispatcher",
 			"Raids::checkRaids",
-			"SpawnMonster::checkSpawnMonster",
-			"SpawnMonster::scheduleSpawn",
 			"SpawnMonster::startup",
+			"SpawnMonsterManager::check",
 			"SpawnNpc::checkSpawnNpc",
 			"Webhook::run",
 			"Protocol::sendRecvMessageCallback",
@@ -100,19 +83,12 @@ private:
 		return tasksContext.contains(context);
 	}
 
-	struct Compare {
-		bool operator()(const std::shared_ptr<Task> &a, const std::shared_ptr<Task> &b) const {
-			return a->utime < b->utime;
-		}
-	};
-
 	std::function<void(void)> func = nullptr;
 	std::string context;
 
 	int64_t utime = 0;
 	int64_t expiration = 0;
 
-	uint64_t id = 0;
 	uint32_t delay = 0;
 
 	bool cycle = false;
@@ -0,0 +1,261 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "game/scheduling/timer_wheel.hpp"
+
+TimerWheel::TimerWheel(uint32_t tickMs) :
+	tickMs(tickMs) {
+	levels[0].resize(FIRST_LEVEL_SIZE);
+	for (uint8_t level = 1; level < LEVELS; ++level) {
+		levels[level].resize(LEVEL_SIZE);
+	}
+	due.reserve(2000);
+}
+
+uint64_t TimerWheel::create(Task &&task) {
+	std::scoped_lock lock(poolMutex);
+	if (freeEntries.empty()) {
+		const auto firstIndex = static_cast<uint32_t>(chunks.size() * CHUNK_SIZE);
+		auto &chunk = chunks.emplace_back(std::make_unique<Entry[]>(CHUNK_SIZE));
+
+		freeEntries.reserve(freeEntries.size() + CHUNK_SIZE);
+		for (uint32_t i = CHUNK_SIZE; i > 0; --i) {
+			chunk[i - 1].index = firstIndex + i - 1;
+			freeEntries.emplace_back(firstIndex + i - 1);
+		}
+	}
+
+	Entry &entry = getEntry(freeEntries.back());
+	freeEntries.pop_back();
+
+	entry.task.emplace(std::move(task));
+	entry.cancelled = false;
+	entry.inUse = true;
+	entry.state = EntryState::Created;
+	return makeEventId(entry);
+}
+
+void TimerWheel::insert(uint64_t eventId, int64_t now) {
+	Entry* entry;
+	{
+		std::scoped_lock lock(poolMutex);
+		entry = findEntry(eventId);
+	}
+
+	if (!entry || entry->state != EntryState::Created) {
+		return;
+	}
+
+	if (!started) {
+		currentTick = toTick(now);
+		started = true;
+	}
+
+	if (entry->cancelled) {
+		release(entry);
+		return;
+	}
+
+	++scheduledCount;
+	link(entry);
+}
+
+bool TimerWheel::cancel(uint64_t eventId, bool isOwnerThread) {
+	Entry* entry;
+	{
+		std::scoped_lock lock(poolMutex);
+		entry = findEntry(eventId);
+		if (!entry || entry->cancelled.exchange(true)) {
+			return false;
+		}
+
+		// Entries waiting to be linked, already due or running are released by the owner when reached.
+		if (!isOwnerThread || entry->state != EntryState::Linked) {
+			return true;
+		}
+	}
+
+	unlink(entry);
+	release(entry);
+	return true;
+}
+
+std::chrono::milliseconds TimerWheel::timeUntilNextExpiration(int64_t now) const {
+	constexpr auto CHRONO_0 = std::chrono::milliseconds(0);
+	constexpr auto CHRONO_MILI_MAX = std::chrono::milliseconds::max();
+
+	if (!started || scheduledCount == 0) {
+		return CHRONO_MILI_MAX;
+	}
+
+	if (dueIndex < due.size()) {
+		return std::max(std::chrono::milliseconds(due[dueIndex]->task->getTime() - now), CHRONO_0);
+	}
+
+	// Wakes up on the next occupied tick or, at most, when the upper levels are cascaded.
+	int64_t tick = currentTick + 1;
+	for (; (tick & (FIRST_LEVEL_SIZE - 1)) != 0; ++tick) {
+		if (levels[0][tick & (FIRST_LEVEL_SIZE - 1)].head) {
+			break;
+		}
+	}
+
+	return std::max(std::chrono::milliseconds(tick * tickMs - now), CHRONO_0);
+}
+
+TimerWheel::Entry* TimerWheel::findEntry(uint64_t eventId) const {
+	const auto index = static_cast<uint32_t>(eventId & std::numeric_limits<uint32_t>::max());
+	const auto generation = static_cast<uint32_t>(eventId >> 32);
+	if (index >= chunks.size() * CHUNK_SIZE) {
+		return nullptr;
+	}
+
+	Entry &entry = getEntry(index);
+	if (!entry.inUse || entry.generation != generation) {
+		return nullptr;
+	}
+
+	return &entry;
+}
+
+void TimerWheel::link(Entry* entry) {
+	entry->tick = toTick(entry->task->getTime());
+	if (entry->tick <= currentTick) {
+		pushDue(entry, true);
+		return;
+	}
+
+	const int64_t delta = std::min(entry->tick - currentTick, MAX_TICKS);
+	const int64_t placement = currentTick + delta;
+
+	Slot* slot = nullptr;
+	if (delta < FIRST_LEVEL_SIZE) {
+		slot = &levels[0][placement & (FIRST_LEVEL_SIZE - 1)];
+	} else {
+		for (uint8_t level = 1; level < LEVELS; ++level) {
+			const uint8_t shift = FIRST_LEVEL_BITS + (level - 1) * LEVEL_BITS;
+			if (delta < (int64_t(1) << (shift + LEVEL_BITS)) || level == LEVELS - 1) {
+				slot = &levels[level][(placement >> shift) & (LEVEL_SIZE - 1)];
+				break;
+			}
+		}
+	}
+
+	entry->state = EntryState::Linked;
+	entry->slot = slot;
+	entry->prev = nullptr;
+	entry->next = slot->head;
+	if (slot->head) {
+		slot->head->prev = entry;
+	}
+	slot->head = entry;
+}
+
+void TimerWheel::unlink(Entry* entry) {
+	if (entry->prev) {
+		entry->prev->next = entry->next;
+	} else {
+		entry->slot->head = entry->next;
+	}
+
+	if (entry->next) {
+		entry->next->prev = entry->prev;
+	}
+
+	entry->slot = nullptr;
+	entry->prev = nullptr;
+	entry->next = nullptr;
+}
+
+void TimerWheel::pushDue(Entry* entry, bool keepSorted) {
+	entry->state = EntryState::Due;
+	if (!keepSorted) {
+		due.emplace_back(entry);
+		return;
+	}
+
+	const auto it = std::upper_bound(due.begin() + dueIndex, due.end(), entry, [](const Entry* a, const Entry* b) {
+		return a->task->getTime() < b->task->getTime();
+	});
+	due.insert(it, entry);
+}
+
+void TimerWheel::cascade(uint8_t level, uint32_t index) {
+	Slot &slot = levels[level][index];
+	Entry* entry = slot.head;
+	slot.head = nullptr;
+
+	while (entry) {
+		Entry* next = entry->next;
+		if (entry->cancelled) {
+			release(entry);
+		} else {
+			link(entry);
+		}
+		entry = next;
+	}
+}
+
+void TimerWheel::advanceTick() {
+	++currentTick;
+
+	if ((currentTick & (FIRST_LEVEL_SIZE - 1)) == 0) {
+		for (uint8_t level = 1; level < LEVELS; ++level) {
+			const uint8_t shift = FIRST_LEVEL_BITS + (level - 1) * LEVEL_BITS;
+			const auto index = static_cast<uint32_t>((currentTick >> shift) & (LEVEL_SIZE - 1));
+			cascade(level, index);
+			if (index != 0) {
+				break;
+			}
+		}
+	}
+
+	Slot &slot = levels[0][currentTick & (FIRST_LEVEL_SIZE - 1)];
+	Entry* entry = slot.head;
+	slot.head = nullptr;
+
+	const size_t sortFrom = due.size();
+	while (entry) {
+		Entry* next = entry->next;
+		if (entry->cancelled) {
+			release(entry);
+		} else {
+			pushDue(entry, false);
+		}
+		entry = next;
+	}
+
+	std::stable_sort(due.begin() + sortFrom, due.end(), [](const Entry* a, const Entry* b) {
+		return a->task->getTime() < b->task->getTime();
+	});
+	std::inplace_merge(due.begin() + dueIndex, due.begin() + sortFrom, due.end(), [](const Entry* a, const Entry* b) {
+		return a->task->getTime() < b->task->getTime();
+	});
+}
+
+void TimerWheel::release(Entry* entry) {
+	if (entry->state != EntryState::Created) {
+		--scheduledCount;
+	}
+
+	entry->task.reset();
+	entry->slot = nullptr;
+	entry->prev = nullptr;
+	entry->next = nullptr;
+
+	std::scoped_lock lock(poolMutex);
+	if (++entry->generation == 0) {
+		entry->generation = 1;
+	}
+	entry->inUse = false;
+	entry->state = EntryState::Free;
+	freeEntries.emplace_back(entry->index);
+}
@@ -0,0 +1,193 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "task.hpp"
+
+/**
+ * Hierarchical timing wheel used by the Dispatcher to keep scheduled events.
+ *
+ * Each tick of the first level is `tickMs` wide (SCHEDULER_MINTICKS), with a 50ms
+ * tick the four levels cover 12.8s, 13.6min, 14.5h and 38.8 days. Inserting,
+ * cancelling and expiring an event are O(1); entries of the tick being expired
+ * are kept sorted by time, so events still run in the exact order they are due.
+ *
+ * Tasks are stored in pooled entries instead of shared_ptr's. The event id encodes
+ * the entry index and its generation, so a stale id never cancels a reused entry.
+ *
+ * create() and cancel() can be called from any thread, every other method must be
+ * called from the thread that owns the wheel (the dispatcher thread).
+ */
+class TimerWheel {
+public:
+	explicit TimerWheel(uint32_t tickMs);
+
+	// Ensures that we don't accidentally copy it
+	TimerWheel(const TimerWheel &) = delete;
+	TimerWheel operator=(const TimerWheel &) = delete;
+
+	/**
+	 * Stores the task in a pooled entry and returns its event id.
+	 * The entry is only scheduled when insert() is called by the owner thread.
+	 */
+	uint64_t create(Task &&task);
+
+	// Links a created entry to the wheel, it will be released if it was cancelled meanwhile.
+	void insert(uint64_t eventId, int64_t now);
+
+	// Returns false if the event id is unknown, already executed or cancelled.
+	bool cancel(uint64_t eventId, bool isOwnerThread);
+
+	/**
+	 * Executes every task due until `now`, in time order.
+	 * `execute` receives the task and returns true when it must be scheduled again,
+	 * in that case its time must already be updated. Rescheduled tasks are only
+	 * linked after all due tasks run, so they never execute twice in the same call.
+	 */
+	template <typename Fn>
+	void expire(int64_t now, Fn &&execute);
+
+	[[nodiscard]] std::chrono::milliseconds timeUntilNextExpiration(int64_t now) const;
+
+	[[nodiscard]] size_t size() const {
+		return scheduledCount;
+	}
+
+	[[nodiscard]] bool empty() const {
+		return scheduledCount == 0;
+	}
+
+private:
+	static constexpr uint8_t LEVELS = 4;
+	static constexpr uint8_t FIRST_LEVEL_BITS = 8;
+	static constexpr uint8_t LEVEL_BITS = 6;
+	static constexpr uint32_t FIRST_LEVEL_SIZE = 1 << FIRST_LEVEL_BITS;
+	static constexpr uint32_t LEVEL_SIZE = 1 << LEVEL_BITS;
+	static constexpr int64_t MAX_TICKS = (int64_t(1) << (FIRST_LEVEL_BITS + (LEVELS - 1) * LEVEL_BITS)) - 1;
+
+	static constexpr uint8_t CHUNK_BITS = 10;
+	static constexpr uint32_t CHUNK_SIZE = 1 << CHUNK_BITS;
+
+	enum class EntryState : uint8_t {
+		Free,
+		Created,
+		Linked,
+		Due,
+		Running,
+	};
+
+	struct Slot;
+
+	struct Entry {
+		std::optional<Task> task;
+
+		Slot* slot = nullptr;
+		Entry* prev = nullptr;
+		Entry* next = nullptr;
+
+		int64_t tick = 0;
+		uint32_t index = 0;
+		uint32_t generation = 1;
+
+		std::atomic_bool cancelled = false;
+		// Only changed with poolMutex held, so other threads can validate event ids.
+		bool inUse = false;
+		EntryState state = EntryState::Free;
+	};
+
+	struct Slot {
+		Entry* head = nullptr;
+	};
+
+	static uint64_t makeEventId(const Entry &entry) {
+		return (static_cast<uint64_t>(entry.generation) << 32) | entry.index;
+	}
+
+	Entry &getEntry(uint32_t index) const {
+		return chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+	}
+
+	Entry* findEntry(uint64_t eventId) const;
+
+	int64_t toTick(int64_t time) const {
+		return time / tickMs;
+	}
+
+	void link(Entry* entry);
+	void unlink(Entry* entry);
+	void pushDue(Entry* entry, bool keepSorted);
+	void cascade(uint8_t level, uint32_t index);
+	void advanceTick();
+	void release(Entry* entry);
+
+	const uint32_t tickMs;
+
+	// Guards the entry pool (chunks, freeEntries and the entry generations).
+	mutable std::mutex poolMutex;
+	std::vector<std::unique_ptr<Entry[]>> chunks;
+	std::vector<uint32_t> freeEntries;
+
+	std::array<std::vector<Slot>, LEVELS> levels;
+
+	// Entries whose tick was already reached, sorted by time.
+	std::vector<Entry*> due;
+	size_t dueIndex = 0;
+
+	int64_t currentTick = 0;
+	size_t scheduledCount = 0;
+	bool started = false;
+};
+
+template <typename Fn>
+void TimerWheel::expire(int64_t now, Fn &&execute) {
+	if (!started) {
+		return;
+	}
+
+	std::vector<Entry*> rescheduled;
+	const int64_t nowTick = toTick(now);
+
+	while (true) {
+		while (dueIndex < due.size()) {
+			Entry* entry = due[dueIndex];
+			if (!entry->cancelled && entry->task->getTime() > now) {
+				break;
+			}
+
+			++dueIndex;
+			if (entry->cancelled) {
+				release(entry);
+				continue;
+			}
+
+			entry->state = EntryState::Running;
+			if (execute(*entry->task) && !entry->cancelled) {
+				rescheduled.emplace_back(entry);
+			} else {
+				release(entry);
+			}
+		}
+
+		if (dueIndex == due.size()) {
+			due.clear();
+			dueIndex = 0;
+		}
+
+		if (currentTick >= nowTick) {
+			break;
+		}
+
+		advanceTick();
+	}
+
+	for (Entry* entry : rescheduled) {
+		link(entry);
+	}
+}
@@ -18,39 +18,6 @@
 #include "enums/account_errors.hpp"
 #include "utils/tools.hpp"
 
-void IOLoginDataLoad::loadItems(ItemsMap &itemsMap, DBResult_ptr result, const std::shared_ptr<Player> &player) {
-	try {
-		do {
-			uint32_t sid = result->getNumber<uint32_t>("sid");
-			uint32_t pid = result->getNumber<uint32_t>("pid");
-			uint16_t type = result->getNumber<uint16_t>("itemtype");
-			uint16_t count = result->getNumber<uint16_t>("count");
-			unsigned long attrSize;
-			const char* attr = result->getStream("attributes", attrSize);
-			PropStream propStream;
-			propStream.init(attr, attrSize);
-
-			try {
-				std::shared_ptr<Item> item = Item::CreateItem(type, count);
-				if (item) {
-					if (!item->unserializeAttr(propStream)) {
-						g_logger().warn("[{}] - Failed to deserialize item attributes {}, from player {}, from account id {}", __FUNCTION__, item->getID(), player->getName(), player->getAccountId());
-						continue;
-					}
-					itemsMap[sid] = std::make_pair(item, pid);
-				} else {
-					g_logger().warn("[{}] - Failed to create item of type {} for player {}, from account id {}", __FUNCTION__, type, player->getName(), player->getAccountId());
-				}
-			} catch (const std::exception &e) {
-				g_logger().warn("[{}] - Exception during the creation or deserialization of the item: {}", __FUNCTION__, e.what());
-				continue;
-			}
-		} while (result->next());
-	} catch (const std::exception &e) {
-		g_logger().error("[{}] - General exception during item loading: {}", __FUNCTION__, e.what());
-	}
-}
-
 bool IOLoginDataLoad::preLoadPlayer(std::shared_ptr<Player> player, const std::string &name) {
 	Database &db = Database::getInstance();
 
@@ -316,16 +283,13 @@ void IOLoginDataLoad::loadPlayerSkill(std::shared_ptr<Player> player, DBResult_p
 	}
 }
 
-void IOLoginDataLoad::loadPlayerKills(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerKills(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `player_id`, `time`, `target`, `unavenged` FROM `player_kills` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = data.take(PlayerLoadData::Table::Kills))) {
 		do {
 			time_t killTime = result->getNumber<time_t>("time");
 			if ((time(nullptr) - killTime) <= g_configManager().getNumber(FRAG_TIME, __FUNCTION__)) {
@@ -335,7 +299,7 @@ void IOLoginDataLoad::loadPlayerKills(std::shared_ptr<Player> player, DBResult_p
 	}
 }
 
-void IOLoginDataLoad::loadPlayerGuild(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerGuild(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
@@ -343,8 +307,7 @@ void IOLoginDataLoad::loadPlayerGuild(std::shared_ptr<Player> player, DBResult_p
 
 	Database &db = Database::getInstance();
 	std::ostringstream query;
-	query << "SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = data.take(PlayerLoadData::Table::Guild))) {
 		uint32_t guildId = result->getNumber<uint32_t>("guild_id");
 		uint32_t playerRankId = result->getNumber<uint32_t>("rank_id");
 		player->guildNick = result->getString("nick");
@@ -385,32 +348,26 @@ void IOLoginDataLoad::loadPlayerGuild(std::shared_ptr<Player> player, DBResult_p
 	}
 }
 
-void IOLoginDataLoad::loadPlayerStashItems(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerStashItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `item_count`, `item_id`  FROM `player_stash` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = data.take(PlayerLoadData::Table::Stash))) {
 		do {
 			player->addItemOnStash(result->getNumber<uint16_t>("item_id"), result->getNumber<uint32_t>("item_count"));
 		} while (result->next());
 	}
 }
 
-void IOLoginDataLoad::loadPlayerBestiaryCharms(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerBestiaryCharms(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT * FROM `player_charms` WHERE `player_guid` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = data.take(PlayerLoadData::Table::Charms))) {
 		player->charmPoints = result->getNumber<uint32_t>("charm_points");
 		player->charmExpansion = result->getNumber<bool>("charm_expansion");
 		player->charmRuneWound = result->getNumber<uint16_t>("rune_wound");
@@ -448,88 +405,71 @@ void IOLoginDataLoad::loadPlayerBestiaryCharms(std::shared_ptr<Player> player, D
 			}
 		}
 	} else {
-		query.str("");
+		std::ostringstream query;
 		query << "INSERT INTO `player_charms` (`player_guid`) VALUES (" << player->getGUID() << ')';
 		Database::getInstance().executeQuery(query.str());
 	}
 }
 
-void IOLoginDataLoad::loadPlayerInstantSpellList(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerInstantSpellList(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = data.take(PlayerLoadData::Table::Spells))) {
 		do {
 			player->learnedInstantSpellList.emplace_front(result->getString("name"));
 		} while (result->next());
 	}
 }
 
-void IOLoginDataLoad::loadPlayerInventoryItems(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerInventoryItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
 	bool oldProtocol = g_configManager().getBoolean(OLD_PROTOCOL, __FUNCTION__) && player->getProtocolVersion() < 1200;
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = " << player->getGUID() << " ORDER BY `sid` DESC";
 
-	ItemsMap inventoryItems;
+	auto [inventoryItems, savedRows] = data.takeItems(PlayerLoadData::Table::Inventory);
+	player->saveState.resetItemRows(PlayerSaveState::ItemTable::Inventory) = std::move(savedRows);
 	std::vector<std::pair<uint8_t, std::shared_ptr<Container>>> openContainersList;
 
 	try {
-		if ((result = db.storeQuery(query.str()))) {
-			loadItems(inventoryItems, result, player);
-
-			for (ItemsMap::const_reverse_iterator it = inventoryItems.rbegin(), end = inventoryItems.rend(); it != end; ++it) {
-				const std::pair<std::shared_ptr<Item>, int32_t> &pair = it->second;
-				std::shared_ptr<Item> item = pair.first;
-				if (!item) {
-					continue;
-				}
-
-				int32_t pid = pair.second;
+		// Items stored in containers were already linked to them, only the slots are left
+		for (ItemsMap::const_reverse_iterator it = inventoryItems.rbegin(), end = inventoryItems.rend(); it != end; ++it) {
+			const std::pair<std::shared_ptr<Item>, int32_t> &pair = it->second;
+			std::shared_ptr<Item> item = pair.first;
+			if (!item) {
+				continue;
+			}
 
-				if (pid >= CONST_SLOT_FIRST && pid <= CONST_SLOT_LAST) {
-					player->internalAddThing(pid, item);
-					item->startDecaying();
-				} else {
-					ItemsMap::const_iterator it2 = inventoryItems.find(pid);
-					if (it2 == inventoryItems.end()) {
-						continue;
-					}
+			int32_t pid = pair.second;
 
-					std::shared_ptr<Container> container = it2->second.first->getContainer();
-					if (container) {
-						container->internalAddThing(item);
-						item->startDecaying();
+			if (pid >= CONST_SLOT_FIRST && pid <= CONST_SLOT_LAST) {
+				player->internalAddThing(pid, item);
+			} else if (!item->getParent()) {
+				continue;
+			}
+			item->startDecaying();
+
+			std::shared_ptr<Container> itemContainer = item->getContainer();
+			if (itemContainer) {
+				if (!oldProtocol) {
+					auto cid = item->getAttribute<int64_t>(ItemAttribute_t::OPENCONTAINER);
+					if (cid > 0) {
+						openContainersList.emplace_back(std::make_pair(cid, itemContainer));
 					}
 				}
-
-				std::shared_ptr<Container> itemContainer = item->getContainer();
-				if (itemContainer) {
-					if (!oldProtocol) {
-						auto cid = item->getAttribute<int64_t>(ItemAttribute_t::OPENCONTAINER);
-						if (cid > 0) {
-							openContainersList.emplace_back(std::make_pair(cid, itemContainer));
-						}
-					}
-					for (bool isLootContainer : { true, false }) {
-						auto checkAttribute = isLootContainer ? ItemAttribute_t::QUICKLOOTCONTAINER : ItemAttribute_t::OBTAINCONTAINER;
-						if (item->hasAttribute(checkAttribute)) {
-							auto flags = item->getAttribute<uint32_t>(checkAttribute);
-
-							for (uint8_t category = OBJECTCATEGORY_FIRST; category <= OBJECTCATEGORY_LAST; category++) {
-								if (hasBitSet(1 << category, flags)) {
-									player->refreshManagedContainer(static_cast<ObjectCategory_t>(category), itemContainer, isLootContainer, true);
-								}
+				for (bool isLootContainer : { true, false }) {
+					auto checkAttribute = isLootContainer ? ItemAttribute_t::QUICKLOOTCONTAINER : ItemAttribute_t::OBTAINCONTAINER;
+					if (item->hasAttribute(checkAttribute)) {
+						auto flags = item->getAttribute<uint32_t>(checkAttribute);
+
+						for (uint8_t category = OBJECTCATEGORY_FIRST; category <= OBJECTCATEGORY_LAST; category++) {
+							if (hasBitSet(1 << category, flags)) {
+								player->refreshManagedContainer(static_cast<ObjectCategory_t>(category), itemContainer, isLootContainer, true);
 							}
 						}
 					}
@@ -563,142 +503,105 @@ void IOLoginDataLoad::loadPlayerStoreInbox(std::shared_ptr<Player> player) {
 	}
 }
 
-void IOLoginDataLoad::loadRewardItems(std::shared_ptr<Player> player) {
+void IOLoginDataLoad::loadRewardItems(std::shared_ptr<Player> player, PlayerLoadData &data) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	ItemsMap rewardItems;
-	std::ostringstream query;
-	query.str(std::string());
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_rewards` WHERE `player_id` = "
-		  << player->getGUID() << " ORDER BY `pid`, `sid` ASC";
-	if (auto result = Database::getInstance().storeQuery(query.str())) {
-		loadItems(rewardItems, result, player);
-		bindRewardBag(player, rewardItems);
-		insertItemsIntoRewardBag(rewardItems);
+	auto tree = data.takeItems(PlayerLoadData::Table::Reward);
+	if (!tree.items.empty()) {
+		bindRewardBag(player, tree.items);
+		insertItemsIntoRewardBag(tree.items);
 	}
+	PlayerLoadData::bindSavedItems(tree);
+	player->saveState.resetItemRows(PlayerSaveState::ItemTable::Reward) = std::move(tree.rows);
 }
 
-void IOLoginDataLoad::loadPlayerDepotItems(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerDepotItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	ItemsMap depotItems;
-	std::ostringstream query;
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = " << player->getGUID() << " ORDER BY `sid` DESC";
-	if ((result = db.storeQuery(query.str()))) {
-		loadItems(depotItems, result, player);
-		for (ItemsMap::const_reverse_iterator it = depotItems.rbegin(), end = depotItems.rend(); it != end; ++it) {
-			const std::pair<std::shared_ptr<Item>, int32_t> &pair = it->second;
-			std::shared_ptr<Item> item = pair.first;
-
-			int32_t pid = pair.second;
-			if (pid >= 0 && pid < 100) {
-				std::shared_ptr<DepotChest> depotChest = player->getDepotChest(pid, true);
-				if (depotChest) {
-					depotChest->internalAddThing(item);
-					item->startDecaying();
-				}
-			} else {
-				ItemsMap::const_iterator it2 = depotItems.find(pid);
-				if (it2 == depotItems.end()) {
-					continue;
-				}
+	auto [depotItems, savedRows] = data.takeItems(PlayerLoadData::Table::Depot);
+	player->saveState.resetItemRows(PlayerSaveState::ItemTable::Depot) = std::move(savedRows);
+	for (ItemsMap::const_reverse_iterator it = depotItems.rbegin(), end = depotItems.rend(); it != end; ++it) {
+		const std::pair<std::shared_ptr<Item>, int32_t> &pair = it->second;
+		std::shared_ptr<Item> item = pair.first;
 
-				std::shared_ptr<Container> container = it2->second.first->getContainer();
-				if (container) {
-					container->internalAddThing(item);
-					item->startDecaying();
-				}
+		int32_t pid = pair.second;
+		if (pid >= 0 && pid < 100) {
+			std::shared_ptr<DepotChest> depotChest = player->getDepotChest(pid, true);
+			if (depotChest) {
+				depotChest->internalAddThing(item);
+				item->startDecaying();
 			}
+		} else if (item->getParent()) {
+			item->startDecaying();
 		}
 	}
 }
 
-void IOLoginDataLoad::loadPlayerInboxItems(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerInboxItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = " << player->getGUID() << " ORDER BY `sid` DESC";
-	if ((result = db.storeQuery(query.str()))) {
-		ItemsMap inboxItems;
-		loadItems(inboxItems, result, player);
-
-		for (ItemsMap::const_reverse_iterator it = inboxItems.rbegin(), end = inboxItems.rend(); it != end; ++it) {
-			const std::pair<std::shared_ptr<Item>, int32_t> &pair = it->second;
-			std::shared_ptr<Item> item = pair.first;
-			int32_t pid = pair.second;
-			if (pid >= 0 && pid < 100) {
-				player->getInbox()->internalAddThing(item);
-				item->startDecaying();
-			} else {
-				ItemsMap::const_iterator it2 = inboxItems.find(pid);
-				if (it2 == inboxItems.end()) {
-					continue;
-				}
-
-				std::shared_ptr<Container> container = it2->second.first->getContainer();
-				if (container) {
-					container->internalAddThing(item);
-					item->startDecaying();
-				}
-			}
+	auto [inboxItems, savedRows] = data.takeItems(PlayerLoadData::Table::Inbox);
+	player->saveState.resetItemRows(PlayerSaveState::ItemTable::Inbox) = std::move(savedRows);
+	for (ItemsMap::const_reverse_iterator it = inboxItems.rbegin(), end = inboxItems.rend(); it != end; ++it) {
+		const std::pair<std::shared_ptr<Item>, int32_t> &pair = it->second;
+		std::shared_ptr<Item> item = pair.first;
+		int32_t pid = pair.second;
+		if (pid >= 0 && pid < 100) {
+			player->getInbox()->internalAddThing(item);
+			item->startDecaying();
+		} else if (item->getParent()) {
+			item->startDecaying();
 		}
 	}
 }
 
-void IOLoginDataLoad::loadPlayerStorageMap(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerStorageMap(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	auto &savedStorage = player->saveState.resetStorage();
+	if ((result = data.take(PlayerLoadData::Table::Storage))) {
 		do {
-			player->addStorageValue(result->getNumber<uint32_t>("key"), result->getNumber<int32_t>("value"), true);
+			const auto key = result->getNumber<uint32_t>("key");
+			const auto value = result->getNumber<int32_t>("value");
+			savedStorage[key] = value;
+			player->addStorageValue(key, value, true);
 		} while (result->next());
 	}
 }
 
-void IOLoginDataLoad::loadPlayerVip(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerVip(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `player_id` FROM `account_viplist` WHERE `account_id` = " << player->getAccountId();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = data.take(PlayerLoadData::Table::Vip))) {
 		do {
 			player->addVIPInternal(result->getNumber<uint32_t>("player_id"));
 		} while (result->next());
 	}
 }
 
-void IOLoginDataLoad::loadPlayerPreyClass(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerPreyClass(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
 	if (g_configManager().getBoolean(PREY_ENABLED, __FUNCTION__)) {
-		Database &db = Database::getInstance();
-		std::ostringstream query;
-		query << "SELECT * FROM `player_prey` WHERE `player_id` = " << player->getGUID();
-		if (result = db.storeQuery(query.str())) {
+		if (result = data.take(PlayerLoadData::Table::Prey)) {
 			do {
 				auto slot = std::make_unique<PreySlot>(static_cast<PreySlot_t>(result->getNumber<uint16_t>("slot")));
 				auto state = static_cast<PreyDataState_t>(result->getNumber<uint16_t>("state"));
@@ -735,17 +638,14 @@ void IOLoginDataLoad::loadPlayerPreyClass(std::shared_ptr<Player> player, DBResu
 	}
 }
 
-void IOLoginDataLoad::loadPlayerTaskHuntingClass(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerTaskHuntingClass(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
 	if (g_configManager().getBoolean(TASK_HUNTING_ENABLED, __FUNCTION__)) {
-		Database &db = Database::getInstance();
-		std::ostringstream query;
-		query << "SELECT * FROM `player_taskhunt` WHERE `player_id` = " << player->getGUID();
-		if (result = db.storeQuery(query.str())) {
+		if (result = data.take(PlayerLoadData::Table::TaskHunting)) {
 			do {
 				auto slot = std::make_unique<TaskHuntingSlot>(static_cast<PreySlot_t>(result->getNumber<uint16_t>("slot")));
 				auto state = static_cast<PreyTaskDataState_t>(result->getNumber<uint16_t>("state"));
@@ -785,15 +685,13 @@ void IOLoginDataLoad::loadPlayerTaskHuntingClass(std::shared_ptr<Player> player,
 	}
 }
 
-void IOLoginDataLoad::loadPlayerForgeHistory(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerForgeHistory(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	std::ostringstream query;
-	query << "SELECT * FROM `forge_history` WHERE `player_id` = " << player->getGUID();
-	if (result = Database::getInstance().storeQuery(query.str())) {
+	if (result = data.take(PlayerLoadData::Table::ForgeHistory)) {
 		do {
 			auto actionEnum = magic_enum::enum_value<ForgeAction_t>(result->getNumber<uint16_t>("action_type"));
 			ForgeHistory history;
@@ -806,15 +704,13 @@ void IOLoginDataLoad::loadPlayerForgeHistory(std::shared_ptr<Player> player, DBR
 	}
 }
 
-void IOLoginDataLoad::loadPlayerBosstiary(std::shared_ptr<Player> player, DBResult_ptr result) {
+void IOLoginDataLoad::loadPlayerBosstiary(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Result nullptr: {}", __FUNCTION__);
 		return;
 	}
 
-	std::ostringstream query;
-	query << "SELECT * FROM `player_bosstiary` WHERE `player_id` = " << player->getGUID();
-	if (result = Database::getInstance().storeQuery(query.str())) {
+	if (result = data.take(PlayerLoadData::Table::Bosstiary)) {
 		do {
 			player->setSlotBossId(1, result->getNumber<uint16_t>("bossIdSlotOne"));
 			player->setSlotBossId(2, result->getNumber<uint16_t>("bossIdSlotTwo"));
@@ -849,10 +745,9 @@ void IOLoginDataLoad::bindRewardBag(std::shared_ptr<Player> player, ItemsMap &re
 		if (pid == 0) {
 			auto reward = player->getReward(item->getAttribute<uint64_t>(ItemAttribute_t::DATE), true);
 			if (reward) {
-				itemPair = std::pair<std::shared_ptr<Item>, int32_t>(reward->getItem(), player->getRewardChest()->getID());
+				// The pid stays 0 to tell the bags apart, their sids are not always the lowest ones
+				itemPair.first = reward->getItem();
 			}
-		} else {
-			break;
 		}
 	}
 }
@@ -863,7 +758,7 @@ void IOLoginDataLoad::insertItemsIntoRewardBag(const ItemsMap &rewardItemsMap) {
 		std::shared_ptr<Item> item = pair.first;
 		int32_t pid = pair.second;
 		if (pid == 0) {
-			break;
+			continue;
 		}
 
 		ItemsMap::const_iterator it2 = rewardItemsMap.find(pid);
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "io/iologindata.hpp"
+#include "io/functions/player_load_data.hpp"
 
 class IOLoginDataLoad : public IOLoginData {
 public:
@@ -21,30 +22,28 @@ public:
 	static void loadPlayerDefaultOutfit(std::shared_ptr<Player> player, DBResult_ptr result);
 	static void loadPlayerSkullSystem(std::shared_ptr<Player> player, DBResult_ptr result);
 	static void loadPlayerSkill(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerKills(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerGuild(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerStashItems(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerBestiaryCharms(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerInstantSpellList(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerInventoryItems(std::shared_ptr<Player> player, DBResult_ptr result);
+	static void loadPlayerKills(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerGuild(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerStashItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerBestiaryCharms(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerInstantSpellList(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerInventoryItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
 	static void loadPlayerStoreInbox(std::shared_ptr<Player> player);
-	static void loadPlayerDepotItems(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadRewardItems(std::shared_ptr<Player> player);
-	static void loadPlayerInboxItems(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerStorageMap(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerVip(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerPreyClass(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerTaskHuntingClass(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerForgeHistory(std::shared_ptr<Player> player, DBResult_ptr result);
-	static void loadPlayerBosstiary(std::shared_ptr<Player> player, DBResult_ptr result);
+	static void loadPlayerDepotItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadRewardItems(std::shared_ptr<Player> player, PlayerLoadData &data);
+	static void loadPlayerInboxItems(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerStorageMap(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerVip(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerPreyClass(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerTaskHuntingClass(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerForgeHistory(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
+	static void loadPlayerBosstiary(std::shared_ptr<Player> player, DBResult_ptr result, PlayerLoadData &data);
 	static void loadPlayerInitializeSystem(std::shared_ptr<Player> player);
 	static void loadPlayerUpdateSystem(std::shared_ptr<Player> player);
 
 private:
-	using ItemsMap = std::map<uint32_t, std::pair<std::shared_ptr<Item>, uint32_t>>;
+	using ItemsMap = PlayerLoadData::ItemsMap;
 
 	static void bindRewardBag(std::shared_ptr<Player> player, ItemsMap &rewardItemsMap);
 	static void insertItemsIntoRewardBag(const ItemsMap &rewardItemsMap);
-
-	static void loadItems(ItemsMap &itemsMap, DBResult_ptr result, const std::shared_ptr<Player> &player);
 };
@@ -12,111 +12,113 @@
 #include "io/functions/iologindata_save_player.hpp"
 #include "game/game.hpp"
 
-bool IOLoginDataSave::saveItems(std::shared_ptr<Player> player, const ItemBlockList &itemList, DBInsert &query_insert, PropWriteStream &propWriteStream) {
-	if (!player) {
-		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
-		return false;
+bool IOLoginDataSave::addItemRow(int32_t sid, int32_t pid, const std::shared_ptr<Item> &item, const char* attributes, size_t attributesSize, const PlayerSaveState::ItemRows* savedRows, PlayerSaveState::ItemRows &rows) {
+	const PlayerSaveState::ItemRow row { pid, PlayerSaveState::hashItemRow(pid, item->getID(), item->getSubType(), attributes, attributesSize), item.get() };
+	rows[sid] = row;
+
+	if (!savedRows) {
+		return true;
 	}
 
-	const Database &db = Database::getInstance();
-	std::ostringstream ss;
+	auto it = savedRows->find(sid);
+	return it == savedRows->end() || it->second.pid != row.pid || it->second.hash != row.hash;
+}
 
-	// Initialize variables
-	using ContainerBlock = std::pair<std::shared_ptr<Container>, int32_t>;
-	std::list<ContainerBlock> queue;
-	int32_t runningId = 100;
+bool IOLoginDataSave::saveItemTable(std::shared_ptr<Player> player, PlayerSaveState::ItemTable table, const std::string &tableName, const ItemBlockList &itemList) {
+	Database &db = Database::getInstance();
+	const PlayerSaveState::ItemRows* savedRows = player->saveState.getItemRows(table);
 
-	// Loop through each item in itemList
-	const auto openContainers = player->getOpenContainers();
-	for (const auto &it : itemList) {
-		int32_t pid = it.first;
-		std::shared_ptr<Item> item = it.second;
-		++runningId;
-
-		// Update container attributes if necessary
-		if (std::shared_ptr<Container> container = item->getContainer()) {
-			if (!container) {
-				continue; // Check for null container
-			}
+	// Unknown database content, rewrite the whole table as before
+	if (!savedRows) {
+		if (!db.executeStatement("DELETE FROM `" + tableName + "` WHERE `player_id` = ?", { static_cast<uint64_t>(player->getGUID()) })) {
+			g_logger().warn("[IOLoginData::savePlayer] - Error delete query '{}' from player: {}", tableName, player->getName());
+			return false;
+		}
+	}
 
-			if (container->getAttribute<int64_t>(ItemAttribute_t::OPENCONTAINER) > 0) {
-				container->setAttribute(ItemAttribute_t::OPENCONTAINER, 0);
-			}
+	DBInsert itemsQuery("INSERT INTO `" + tableName + "` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
+	if (savedRows) {
+		itemsQuery.upsert({ "pid", "itemtype", "count", "attributes" });
+	}
 
-			if (!openContainers.empty()) {
-				for (const auto &its : openContainers) {
-					auto openContainer = its.second;
-					auto opcontainer = openContainer.container;
+	PropWriteStream propWriteStream;
+	PlayerSaveState::ItemRows rows;
+	rows.reserve(savedRows ? savedRows->size() : itemList.size());
+	if (!saveItems(player, itemList, itemsQuery, propWriteStream, savedRows, rows)) {
+		return false;
+	}
 
-					if (opcontainer == container) {
-						container->setAttribute(ItemAttribute_t::OPENCONTAINER, ((int)its.first) + 1);
-						break;
-					}
-				}
+	if (savedRows) {
+		// Rows gone or moved to another parent, a moved row was already inserted under its new pid
+		std::vector<DBValue> removed;
+		for (const auto &[sid, savedRow] : *savedRows) {
+			auto it = rows.find(sid);
+			if (it != rows.end() && it->second.pid == savedRow.pid) {
+				continue;
 			}
 
-			// Add container to queue
-			queue.emplace_back(container, runningId);
+			removed.emplace_back(static_cast<int64_t>(savedRow.pid));
+			removed.emplace_back(static_cast<int64_t>(sid));
 		}
 
-		// Serialize item attributes
-		try {
-			propWriteStream.clear();
-			item->serializeAttr(propWriteStream);
-		} catch (...) {
-			g_logger().error("Error serializing item attributes.");
-			return false;
-		}
-
-		size_t attributesSize;
-		const char* attributes = propWriteStream.getStream(attributesSize);
-
-		// Build query string and add row
-		ss << player->getGUID() << ',' << pid << ',' << runningId << ',' << item->getID() << ',' << item->getSubType() << ',' << db.escapeBlob(attributes, static_cast<uint32_t>(attributesSize));
-		if (!query_insert.addRow(ss)) {
-			g_logger().error("Error adding row to query.");
-			return false;
+		// Only a few batch sizes, so the deletes share the same few prepared statements
+		for (size_t first = 0; first < removed.size();) {
+			const size_t remaining = (removed.size() - first) / 2;
+			const size_t batchSize = remaining >= 256 ? 256 : (remaining >= 16 ? 16 : 1);
+			const std::vector<std::string_view> placeholders(batchSize, "(?, ?)");
+			const auto query = fmt::format("DELETE FROM `{}` WHERE `player_id` = ? AND (`pid`, `sid`) IN ({})", tableName, fmt::join(placeholders, ", "));
+
+			std::vector<DBValue> values { static_cast<uint64_t>(player->getGUID()) };
+			const auto begin = removed.begin() + static_cast<std::ptrdiff_t>(first);
+			values.insert(values.end(), begin, begin + static_cast<std::ptrdiff_t>(batchSize * 2));
+			if (!db.executeStatement(query, values)) {
+				g_logger().warn("[IOLoginData::savePlayer] - Error delete query '{}' from player: {}", tableName, player->getName());
+				return false;
+			}
+			first += batchSize * 2;
 		}
 	}
 
-	// Loop through containers in queue
-	while (!queue.empty()) {
-		const ContainerBlock &cb = queue.front();
-		std::shared_ptr<Container> container = cb.first;
-		int32_t parentId = cb.second;
-		queue.pop_front();
-
-		if (!container) {
-			continue; // Check for null container
-		}
+	player->saveState.stageItemRows(table, std::move(rows));
+	return true;
+}
 
-		// Loop through items in container
-		for (std::shared_ptr<Item> item : container->getItemList()) {
-			if (!item) {
-				continue; // Check for null item
-			}
+bool IOLoginDataSave::saveItems(std::shared_ptr<Player> player, const ItemBlockList &itemList, DBInsert &query_insert, PropWriteStream &propWriteStream, const PlayerSaveState::ItemRows* savedRows, PlayerSaveState::ItemRows &rows) {
+	if (!player) {
+		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
+		return false;
+	}
 
-			++runningId;
+	// Initialize variables
+	using ContainerBlock = std::pair<std::shared_ptr<Container>, int32_t>;
+	std::list<ContainerBlock> queue;
+	PlayerSaveState::ItemSids itemSids(savedRows);
+	std::vector<std::shared_ptr<Item>> items;
+	std::vector<int32_t> sids;
 
-			// Update sub-container attributes if necessary
-			std::shared_ptr<Container> subContainer = item->getContainer();
-			if (subContainer) {
-				queue.emplace_back(subContainer, runningId);
-				if (subContainer->getAttribute<int64_t>(ItemAttribute_t::OPENCONTAINER) > 0) {
-					subContainer->setAttribute(ItemAttribute_t::OPENCONTAINER, 0);
+	// Saves the items of a parent, they are gathered in items from front to back
+	const auto openContainers = player->getOpenContainers();
+	const auto saveParentItems = [&](int32_t pid) {
+		itemSids.assign(items, sids);
+		for (size_t i = 0; i < items.size(); ++i) {
+			const auto &item = items[i];
+			const int32_t sid = sids[i];
+
+			// Update container attributes if necessary
+			if (std::shared_ptr<Container> container = item->getContainer()) {
+				if (container->getAttribute<int64_t>(ItemAttribute_t::OPENCONTAINER) > 0) {
+					container->setAttribute(ItemAttribute_t::OPENCONTAINER, 0);
 				}
 
-				if (!openContainers.empty()) {
-					for (const auto &it : openContainers) {
-						auto openContainer = it.second;
-						auto opcontainer = openContainer.container;
-
-						if (opcontainer == subContainer) {
-							subContainer->setAttribute(ItemAttribute_t::OPENCONTAINER, (it.first) + 1);
-							break;
-						}
+				for (const auto &[cid, openContainer] : openContainers) {
+					if (openContainer.container == container) {
+						container->setAttribute(ItemAttribute_t::OPENCONTAINER, cid + 1);
+						break;
 					}
 				}
+
+				// Add container to queue
+				queue.emplace_back(container, sid);
 			}
 
 			// Serialize item attributes
@@ -124,20 +126,57 @@ bool IOLoginDataSave::saveItems(std::shared_ptr<Player> player, const ItemBlockL
 				propWriteStream.clear();
 				item->serializeAttr(propWriteStream);
 			} catch (...) {
-				g_logger().error("Error serializing item attributes in container.");
+				g_logger().error("Error serializing item attributes.");
 				return false;
 			}
 
 			size_t attributesSize;
 			const char* attributes = propWriteStream.getStream(attributesSize);
 
-			// Build query string and add row
-			ss << player->getGUID() << ',' << parentId << ',' << runningId << ',' << item->getID() << ',' << item->getSubType() << ',' << db.escapeBlob(attributes, static_cast<uint32_t>(attributesSize));
-			if (!query_insert.addRow(ss)) {
-				g_logger().error("Error adding row to query for container item.");
+			// Skip the row if the database already has it
+			if (!addItemRow(sid, pid, item, attributes, attributesSize, savedRows, rows)) {
+				continue;
+			}
+
+			// Bind the row, attributes are sent as they are
+			if (!query_insert.addRow({ static_cast<uint64_t>(player->getGUID()), static_cast<int64_t>(pid), static_cast<int64_t>(sid), static_cast<uint64_t>(item->getID()), static_cast<uint64_t>(item->getSubType()), DBBlob { std::string(attributes, attributesSize) } })) {
+				g_logger().error("Error adding row to query.");
 				return false;
 			}
 		}
+
+		items.clear();
+		return true;
+	};
+
+	// Top level items, the ones of the same parent are next to each other
+	for (auto it = itemList.begin(); it != itemList.end();) {
+		const int32_t pid = it->first;
+		for (; it != itemList.end() && it->first == pid; ++it) {
+			if (it->second) {
+				items.emplace_back(it->second);
+			}
+		}
+
+		if (!saveParentItems(pid)) {
+			return false;
+		}
+	}
+
+	// Loop through containers in queue
+	while (!queue.empty()) {
+		const auto [container, parentId] = queue.front();
+		queue.pop_front();
+
+		for (const std::shared_ptr<Item> &item : container->getItemList()) {
+			if (item) {
+				items.emplace_back(item);
+			}
+		}
+
+		if (!saveParentItems(parentId)) {
+			return false;
+		}
 	}
 
 	// Execute query
@@ -457,17 +496,6 @@ bool IOLoginDataSave::savePlayerItem(std::shared_ptr<Player> player) {
 		return false;
 	}
 
-	Database &db = Database::getInstance();
-	PropWriteStream propWriteStream;
-	std::ostringstream query;
-	query << "DELETE FROM `player_items` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		g_logger().warn("[IOLoginData::savePlayer] - Error delete query 'player_items' from player: {}", player->getName());
-		return false;
-	}
-
-	DBInsert itemsQuery("INSERT INTO `player_items` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-
 	ItemBlockList itemList;
 	for (int32_t slotId = CONST_SLOT_FIRST; slotId <= CONST_SLOT_LAST; ++slotId) {
 		std::shared_ptr<Item> item = player->inventory[slotId];
@@ -476,7 +504,7 @@ bool IOLoginDataSave::savePlayerItem(std::shared_ptr<Player> player) {
 		}
 	}
 
-	if (!saveItems(player, itemList, itemsQuery, propWriteStream)) {
+	if (!saveItemTable(player, PlayerSaveState::ItemTable::Inventory, "player_items", itemList)) {
 		g_logger().warn("[IOLoginData::savePlayer] - Failed for save items from player: {}", player->getName());
 		return false;
 	}
@@ -489,31 +517,15 @@ bool IOLoginDataSave::savePlayerDepotItems(std::shared_ptr<Player> player) {
 		return false;
 	}
 
-	Database &db = Database::getInstance();
-	PropWriteStream propWriteStream;
-	ItemDepotList depotList;
 	if (player->lastDepotId != -1) {
-		std::ostringstream query;
-		query << "DELETE FROM `player_depotitems` WHERE `player_id` = " << player->getGUID();
-
-		if (!db.executeQuery(query.str())) {
-			return false;
-		}
-
-		query.str("");
-
-		DBInsert depotQuery("INSERT INTO `player_depotitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-
+		ItemDepotList depotList;
 		for (const auto &[pid, depotChest] : player->depotChests) {
 			for (std::shared_ptr<Item> item : depotChest->getItemList()) {
 				depotList.emplace_back(pid, item);
 			}
 		}
 
-		if (!saveItems(player, depotList, depotQuery, propWriteStream)) {
-			return false;
-		}
-		return true;
+		return saveItemTable(player, PlayerSaveState::ItemTable::Depot, "player_depotitems", depotList);
 	}
 	return true;
 }
@@ -524,32 +536,18 @@ bool IOLoginDataSave::saveRewardItems(std::shared_ptr<Player> player) {
 		return false;
 	}
 
-	std::ostringstream query;
-	query << "DELETE FROM `player_rewards` WHERE `player_id` = " << player->getGUID();
-
-	if (!Database::getInstance().executeQuery(query.str())) {
-		return false;
-	}
-
 	std::vector<uint64_t> rewardList;
 	player->getRewardList(rewardList);
 
 	ItemRewardList rewardListItems;
-	if (!rewardList.empty()) {
-		for (const auto &rewardId : rewardList) {
-			auto reward = player->getReward(rewardId, false);
-			if (!reward->empty() && (getTimeMsNow() - rewardId <= 1000 * 60 * 60 * 24 * 7)) {
-				rewardListItems.emplace_back(0, reward);
-			}
-		}
-
-		DBInsert rewardQuery("INSERT INTO `player_rewards` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-		PropWriteStream propWriteStream;
-		if (!saveItems(player, rewardListItems, rewardQuery, propWriteStream)) {
-			return false;
+	for (const auto &rewardId : rewardList) {
+		auto reward = player->getReward(rewardId, false);
+		if (!reward->empty() && (getTimeMsNow() - rewardId <= 1000 * 60 * 60 * 24 * 7)) {
+			rewardListItems.emplace_back(0, reward);
 		}
 	}
-	return true;
+
+	return saveItemTable(player, PlayerSaveState::ItemTable::Reward, "player_rewards", rewardListItems);
 }
 
 bool IOLoginDataSave::savePlayerInbox(std::shared_ptr<Player> player) {
@@ -558,26 +556,12 @@ bool IOLoginDataSave::savePlayerInbox(std::shared_ptr<Player> player) {
 		return false;
 	}
 
-	Database &db = Database::getInstance();
-	PropWriteStream propWriteStream;
 	ItemInboxList inboxList;
-	std::ostringstream query;
-	query << "DELETE FROM `player_inboxitems` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
-
-	query.str("");
-	DBInsert inboxQuery("INSERT INTO `player_inboxitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-
 	for (const auto &item : player->getInbox()->getItemList()) {
 		inboxList.emplace_back(0, item);
 	}
 
-	if (!saveItems(player, inboxList, inboxQuery, propWriteStream)) {
-		return false;
-	}
-	return true;
+	return saveItemTable(player, PlayerSaveState::ItemTable::Inbox, "player_inboxitems", inboxList);
 }
 
 bool IOLoginDataSave::savePlayerPreyClass(std::shared_ptr<Player> player) {
@@ -770,19 +754,40 @@ bool IOLoginDataSave::savePlayerStorage(std::shared_ptr<Player> player) {
 		return false;
 	}
 
+	player->genReservedStorageRange();
+
+	auto &saveState = player->saveState;
+	const PlayerSaveState::StorageMap* savedStorage = saveState.getStorage();
+	if (savedStorage && !saveState.isStorageDirty()) {
+		return true;
+	}
+
 	Database &db = Database::getInstance();
 	std::ostringstream query;
-	query << "DELETE FROM `player_storage` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
 
-	query.str("");
+	// Unknown database content, rewrite the whole table as before
+	if (!savedStorage) {
+		query << "DELETE FROM `player_storage` WHERE `player_id` = " << player->getGUID();
+		if (!db.executeQuery(query.str())) {
+			return false;
+		}
+
+		query.str("");
+	}
 
 	DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ");
-	player->genReservedStorageRange();
+	if (savedStorage) {
+		storageQuery.upsert({ "value" });
+	}
 
 	for (const auto &[key, value] : player->storageMap) {
+		if (savedStorage) {
+			auto it = savedStorage->find(key);
+			if (it != savedStorage->end() && it->second == value) {
+				continue;
+			}
+		}
+
 		query << player->getGUID() << ',' << key << ',' << value;
 		if (!storageQuery.addRow(query)) {
 			return false;
@@ -792,5 +797,28 @@ bool IOLoginDataSave::savePlayerStorage(std::shared_ptr<Player> player) {
 	if (!storageQuery.execute()) {
 		return false;
 	}
+
+	if (savedStorage) {
+		std::ostringstream removed;
+		for (const auto &[key, value] : *savedStorage) {
+			if (player->storageMap.contains(key)) {
+				continue;
+			}
+
+			if (removed.tellp() > 0) {
+				removed << ',';
+			}
+			removed << key;
+		}
+
+		if (removed.tellp() > 0) {
+			query << "DELETE FROM `player_storage` WHERE `player_id` = " << player->getGUID() << " AND `key` IN (" << removed.str() << ')';
+			if (!db.executeQuery(query.str())) {
+				return false;
+			}
+		}
+	}
+
+	saveState.stageStorage(player->storageMap);
 	return true;
 }
@@ -34,5 +34,10 @@ protected:
 	using ItemRewardList = std::list<std::pair<int32_t, std::shared_ptr<Item>>>;
 	using ItemInboxList = std::list<std::pair<int32_t, std::shared_ptr<Item>>>;
 
-	static bool saveItems(std::shared_ptr<Player> player, const ItemBlockList &itemList, DBInsert &query_insert, PropWriteStream &stream);
+	// The items keep the sids they were saved with, see PlayerSaveState::ItemSids.
+	static bool saveItems(std::shared_ptr<Player> player, const ItemBlockList &itemList, DBInsert &query_insert, PropWriteStream &stream, const PlayerSaveState::ItemRows* savedRows, PlayerSaveState::ItemRows &rows);
+	// Writes only the rows that differ from the saved state, or the whole table when it is unknown.
+	static bool saveItemTable(std::shared_ptr<Player> player, PlayerSaveState::ItemTable table, const std::string &tableName, const ItemBlockList &itemList);
+	// Records the row and returns false when the database already has it.
+	static bool addItemRow(int32_t sid, int32_t pid, const std::shared_ptr<Item> &item, const char* attributes, size_t attributesSize, const PlayerSaveState::ItemRows* savedRows, PlayerSaveState::ItemRows &rows);
 };
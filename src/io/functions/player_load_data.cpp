@@ -0,0 +1,192 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "io/functions/player_load_data.hpp"
+#include "creatures/players/player.hpp"
+#include "items/containers/container.hpp"
+
+PlayerLoadData::PlayerLoadData(const std::shared_ptr<Player> &player) :
+	guid(player->getGUID()), accountId(player->getAccountId()), playerName(player->getName()) { }
+
+std::optional<PlayerSaveState::ItemTable> PlayerLoadData::getItemTable(Table table) {
+	switch (table) {
+		case Table::Inventory:
+			return PlayerSaveState::ItemTable::Inventory;
+		case Table::Depot:
+			return PlayerSaveState::ItemTable::Depot;
+		case Table::Reward:
+			return PlayerSaveState::ItemTable::Reward;
+		case Table::Inbox:
+			return PlayerSaveState::ItemTable::Inbox;
+		default:
+			return std::nullopt;
+	}
+}
+
+void PlayerLoadData::fetch(Table table) {
+	const auto index = static_cast<uint8_t>(table);
+	fetched[index] = true;
+
+	DBResult_ptr result = query(table);
+	const auto itemTable = getItemTable(table);
+	if (!itemTable) {
+		results[index] = std::move(result);
+		return;
+	}
+
+	if (result) {
+		readItemRows(itemRows[static_cast<uint8_t>(itemTable.value())], result);
+	}
+}
+
+DBResult_ptr PlayerLoadData::take(Table table) {
+	const auto index = static_cast<uint8_t>(table);
+	if (!fetched[index]) {
+		fetch(table);
+	}
+	return std::move(results[index]);
+}
+
+PlayerLoadData::ItemTree PlayerLoadData::takeItems(Table table) {
+	const auto itemTable = getItemTable(table);
+	if (!itemTable) {
+		return {};
+	}
+
+	if (!fetched[static_cast<uint8_t>(table)]) {
+		fetch(table);
+	}
+
+	auto rows = std::move(itemRows[static_cast<uint8_t>(itemTable.value())]);
+	ItemTree tree { createItems(rows.items), std::move(rows.saved) };
+
+	// The reward bags only exist once the player is loaded, their items are linked by IOLoginDataLoad::loadRewardItems
+	if (table != Table::Reward) {
+		linkContainers(tree.items);
+		bindSavedItems(tree);
+	}
+	return tree;
+}
+
+void PlayerLoadData::bindSavedItems(ItemTree &tree) {
+	for (const auto &[sid, entry] : tree.items) {
+		if (auto it = tree.rows.find(static_cast<int32_t>(sid)); it != tree.rows.end()) {
+			it->second.item = entry.first.get();
+		}
+	}
+}
+
+DBResult_ptr PlayerLoadData::query(Table table) const {
+	Database &db = Database::getInstance();
+	const std::vector<DBValue> player { static_cast<uint64_t>(guid) };
+
+	switch (table) {
+		case Table::Player:
+			return db.storeStatement("SELECT * FROM `players` WHERE `id` = ?", player);
+		case Table::Kills:
+			return db.storeStatement("SELECT `player_id`, `time`, `target`, `unavenged` FROM `player_kills` WHERE `player_id` = ?", player);
+		case Table::Guild:
+			return db.storeStatement("SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = ?", player);
+		case Table::Stash:
+			return db.storeStatement("SELECT `item_count`, `item_id` FROM `player_stash` WHERE `player_id` = ?", player);
+		case Table::Charms:
+			return db.storeStatement("SELECT * FROM `player_charms` WHERE `player_guid` = ?", player);
+		case Table::Spells:
+			return db.storeStatement("SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = ?", player);
+		case Table::Inventory:
+			return db.storeStatement("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = ? ORDER BY `sid` DESC", player);
+		case Table::Depot:
+			return db.storeStatement("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = ? ORDER BY `sid` DESC", player);
+		case Table::Reward:
+			return db.storeStatement("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_rewards` WHERE `player_id` = ? ORDER BY `pid`, `sid` ASC", player);
+		case Table::Inbox:
+			return db.storeStatement("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = ? ORDER BY `sid` DESC", player);
+		case Table::Storage:
+			return db.storeStatement("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = ?", player);
+		case Table::Vip:
+			return db.storeStatement("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = ?", { static_cast<uint64_t>(accountId) });
+		case Table::Prey:
+			return db.storeStatement("SELECT * FROM `player_prey` WHERE `player_id` = ?", player);
+		case Table::TaskHunting:
+			return db.storeStatement("SELECT * FROM `player_taskhunt` WHERE `player_id` = ?", player);
+		case Table::ForgeHistory:
+			return db.storeStatement("SELECT * FROM `forge_history` WHERE `player_id` = ?", player);
+		case Table::Bosstiary:
+			return db.storeStatement("SELECT * FROM `player_bosstiary` WHERE `player_id` = ?", player);
+		default:
+			return nullptr;
+	}
+}
+
+void PlayerLoadData::readItemRows(ItemRows &rows, DBResult_ptr result) {
+	try {
+		do {
+			ItemRow &row = rows.items.emplace_back();
+			row.sid = result->getNumber<uint32_t>("sid");
+			row.pid = result->getNumber<uint32_t>("pid");
+			row.type = result->getNumber<uint16_t>("itemtype");
+			row.count = result->getNumber<uint16_t>("count");
+			unsigned long attrSize;
+			const char* attr = result->getStream("attributes", attrSize);
+			if (attr) {
+				row.attributes.assign(attr, attrSize);
+			}
+			// rows that fail to load are kept too, the next save deletes them
+			rows.saved[row.sid] = { static_cast<int32_t>(row.pid), PlayerSaveState::hashItemRow(row.pid, row.type, row.count, attr, attrSize) };
+		} while (result->next());
+	} catch (const std::exception &e) {
+		g_logger().error("[{}] - General exception during item loading: {}", __FUNCTION__, e.what());
+	}
+}
+
+PlayerLoadData::ItemsMap PlayerLoadData::createItems(const std::vector<ItemRow> &rows) const {
+	ItemsMap items;
+	for (const auto &row : rows) {
+		PropStream propStream;
+		propStream.init(row.attributes.data(), row.attributes.size());
+
+		try {
+			std::shared_ptr<Item> item = Item::CreateItem(row.type, row.count);
+			if (item) {
+				if (!item->unserializeAttr(propStream)) {
+					g_logger().warn("[{}] - Failed to deserialize item attributes {}, from player {}, from account id {}", __FUNCTION__, item->getID(), playerName, accountId);
+					continue;
+				}
+				items[row.sid] = std::make_pair(item, row.pid);
+			} else {
+				g_logger().warn("[{}] - Failed to create item of type {} for player {}, from account id {}", __FUNCTION__, row.type, playerName, accountId);
+			}
+		} catch (const std::exception &e) {
+			g_logger().warn("[{}] - Exception during the creation or deserialization of the item: {}", __FUNCTION__, e.what());
+		}
+	}
+	return items;
+}
+
+void PlayerLoadData::linkContainers(const ItemsMap &items) {
+	// Items saved in a slot or a depot chest have a pid below the first sid, the loaders attach them.
+	// The sids of the items of a container increase from front to back, going backwards keeps their order.
+	for (const auto &[sid, entry] : std::views::reverse(items)) {
+		const auto &[item, pid] = entry;
+		if (pid < 100) {
+			continue;
+		}
+
+		const auto it = items.find(pid);
+		if (it == items.end()) {
+			continue;
+		}
+
+		if (std::shared_ptr<Container> container = it->second.first->getContainer()) {
+			container->internalAddThing(item);
+		}
+	}
+}
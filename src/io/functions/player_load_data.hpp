@@ -0,0 +1,102 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "database/database.hpp"
+#include "io/functions/player_save_state.hpp"
+
+class Item;
+class Player;
+
+/**
+ * The rows IOLoginDataLoad reads to load a player.
+ *
+ * A table is queried when a loader takes it, unless it was fetched beforehand. The login
+ * fetches every table on the thread pool (see IOLoginData::loadPlayerAsync): the queries
+ * are independent, so they run in parallel on the connections of the database pool.
+ *
+ * Fetching only reads the rows of the item tables into plain data. Creating an item
+ * may register it in the game (unique ids, bed sleepers), so the items are created and
+ * linked to their containers when a loader takes them, on the dispatcher.
+ */
+class PlayerLoadData {
+public:
+	enum class Table : uint8_t {
+		Player,
+		Kills,
+		Guild,
+		Stash,
+		Charms,
+		Spells,
+		Inventory,
+		Depot,
+		Reward,
+		Inbox,
+		Storage,
+		Vip,
+		Prey,
+		TaskHunting,
+		ForgeHistory,
+		Bosstiary,
+		Last
+	};
+
+	// Items by sid, with the pid of their row.
+	using ItemsMap = std::map<uint32_t, std::pair<std::shared_ptr<Item>, uint32_t>>;
+
+	struct ItemTree {
+		ItemsMap items;
+		PlayerSaveState::ItemRows rows;
+	};
+
+	explicit PlayerLoadData(const std::shared_ptr<Player> &player);
+
+	// Queries the table, the rows of the item tables are also read. Can be called from any
+	// thread, as long as each table is fetched by a single one.
+	void fetch(Table table);
+
+	// The rows of the table, queried now if they were not fetched yet.
+	DBResult_ptr take(Table table);
+	// The items of an item table and the rows they were read from, for the save state.
+	// Creates the items, so it must run on the dispatcher.
+	ItemTree takeItems(Table table);
+	// Records the item of every row, so the next save keeps their sids. Done by takeItems,
+	// except for the reward table, whose bags are only known once bound to the player.
+	static void bindSavedItems(ItemTree &tree);
+
+private:
+	struct ItemRow {
+		uint32_t sid;
+		uint32_t pid;
+		uint16_t type;
+		uint16_t count;
+		std::string attributes;
+	};
+
+	struct ItemRows {
+		std::vector<ItemRow> items;
+		PlayerSaveState::ItemRows saved;
+	};
+
+	static std::optional<PlayerSaveState::ItemTable> getItemTable(Table table);
+
+	DBResult_ptr query(Table table) const;
+	static void readItemRows(ItemRows &rows, DBResult_ptr result);
+	ItemsMap createItems(const std::vector<ItemRow> &rows) const;
+	static void linkContainers(const ItemsMap &items);
+
+	uint32_t guid;
+	uint32_t accountId;
+	std::string playerName;
+
+	std::array<DBResult_ptr, static_cast<uint8_t>(Table::Last)> results;
+	std::array<ItemRows, static_cast<uint8_t>(PlayerSaveState::ItemTable::Last)> itemRows;
+	std::array<bool, static_cast<uint8_t>(Table::Last)> fetched {};
+};
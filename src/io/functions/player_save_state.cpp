@@ -0,0 +1,164 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "io/functions/player_save_state.hpp"
+
+uint64_t PlayerSaveState::hashItemRow(int32_t pid, uint16_t itemType, uint16_t count, const char* attributes, size_t attributesSize) {
+	// FNV-1a, the hash must be the same for the row read from the database and the row about to be written
+	uint64_t hash = 14695981039346656037ULL;
+	const auto mix = [&hash](const char* data, size_t size) {
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= static_cast<uint8_t>(data[i]);
+			hash *= 1099511628211ULL;
+		}
+	};
+
+	mix(reinterpret_cast<const char*>(&pid), sizeof(pid));
+	mix(reinterpret_cast<const char*>(&itemType), sizeof(itemType));
+	mix(reinterpret_cast<const char*>(&count), sizeof(count));
+	mix(attributes, attributesSize);
+	return hash;
+}
+
+PlayerSaveState::ItemSids::ItemSids(const ItemRows* savedRows) :
+	savedRows(savedRows) {
+	if (!savedRows) {
+		return;
+	}
+
+	saved.reserve(savedRows->size());
+	for (const auto &[sid, row] : *savedRows) {
+		if (row.item) {
+			saved.try_emplace(row.item, sid);
+		}
+		last = std::max(last, sid);
+	}
+}
+
+void PlayerSaveState::ItemSids::assign(const std::vector<std::shared_ptr<Item>> &items, std::vector<int32_t> &sids) {
+	sids.assign(items.size(), 0);
+	if (items.empty()) {
+		return;
+	}
+
+	for (size_t i = 0; i < items.size(); ++i) {
+		if (auto it = saved.find(items[i].get()); it != saved.end()) {
+			sids[i] = it->second;
+		}
+	}
+
+	// The longest run of saved items still in sid order keeps its sids
+	size_t runBegin = 0;
+	size_t runEnd = 0;
+	for (size_t begin = 0; begin < sids.size();) {
+		if (sids[begin] == 0) {
+			++begin;
+			continue;
+		}
+
+		size_t end = begin + 1;
+		while (end < sids.size() && sids[end] > sids[end - 1]) {
+			++end;
+		}
+		if (end - begin > runEnd - runBegin) {
+			runBegin = begin;
+			runEnd = end;
+		}
+		begin = end;
+	}
+
+	if (runBegin != runEnd && runBegin > 0) {
+		const int32_t first = sids[runBegin] - static_cast<int32_t>(runBegin);
+		bool hasRoom = first >= FIRST_SID;
+		for (int32_t sid = first; hasRoom && sid < sids[runBegin]; ++sid) {
+			hasRoom = !savedRows->contains(sid);
+		}
+
+		if (hasRoom) {
+			for (size_t i = 0; i < runBegin; ++i) {
+				sids[i] = first + static_cast<int32_t>(i);
+			}
+		} else {
+			runBegin = runEnd = 0;
+		}
+	}
+
+	if (runBegin == runEnd) {
+		last += FRONT_ROOM;
+	}
+
+	for (size_t i = runEnd; i < sids.size(); ++i) {
+		sids[i] = ++last;
+	}
+}
+
+PlayerSaveState::ItemRows &PlayerSaveState::resetItemRows(ItemTable table) {
+	staged.itemRows[static_cast<uint8_t>(table)].reset();
+	return itemRows[static_cast<uint8_t>(table)].emplace();
+}
+
+const PlayerSaveState::ItemRows* PlayerSaveState::getItemRows(ItemTable table) const {
+	const auto &rows = itemRows[static_cast<uint8_t>(table)];
+	return rows && pendingSaves == 0 ? &rows.value() : nullptr;
+}
+
+void PlayerSaveState::stageItemRows(ItemTable table, ItemRows &&rows) {
+	staged.itemRows[static_cast<uint8_t>(table)] = std::move(rows);
+}
+
+PlayerSaveState::StorageMap &PlayerSaveState::resetStorage() {
+	staged.storage.reset();
+	storageDirty = false;
+	return storage.emplace();
+}
+
+const PlayerSaveState::StorageMap* PlayerSaveState::getStorage() const {
+	return storage && pendingSaves == 0 ? &storage.value() : nullptr;
+}
+
+void PlayerSaveState::stageStorage(const StorageMap &newStorage) {
+	// cleared here and not on commit, a storage changed while the save is written stays dirty
+	storageDirty = false;
+	staged.storage = newStorage;
+}
+
+PlayerSaveState::Staged PlayerSaveState::takeStaged() {
+	++pendingSaves;
+	return std::exchange(staged, {});
+}
+
+void PlayerSaveState::commit(Staged &&written) {
+	discard();
+
+	for (uint8_t i = 0; i < itemRows.size(); ++i) {
+		if (written.itemRows[i]) {
+			itemRows[i] = std::move(written.itemRows[i]);
+		}
+	}
+
+	if (written.storage) {
+		storage = std::move(written.storage);
+	}
+}
+
+void PlayerSaveState::discard() {
+	if (pendingSaves > 0) {
+		--pendingSaves;
+	}
+}
+
+void PlayerSaveState::reset() {
+	for (auto &rows : itemRows) {
+		rows.reset();
+	}
+	storage.reset();
+	staged = {};
+}
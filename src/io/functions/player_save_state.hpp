@@ -0,0 +1,115 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+class Item;
+
+/**
+ * What the database holds for a player, so a save only writes the rows that changed.
+ *
+ * Item tables keep the parent id, a hash and the item of every row, keyed by sid. An item
+ * keeps its sid from one save to the next (see ItemSids), so only the rows of the items
+ * that changed are written. The storage keeps a copy of the saved values and a dirty flag
+ * set by Player::addStorageValue.
+ *
+ * The rows written by a save are staged while it is recorded, then taken along with the
+ * recorded queries and only become the saved state once the transaction commits. Every
+ * member is only used on the dispatcher, the writers hand the staged rows back to it.
+ *
+ * A table without a saved state (not loaded, or a save failed) is rewritten entirely by
+ * the next save, and so is every table while another save is still being written: it
+ * could not tell which of the rows of that save will reach the database.
+ */
+class PlayerSaveState {
+public:
+	enum class ItemTable : uint8_t {
+		Inventory,
+		Depot,
+		Reward,
+		Inbox,
+		Last
+	};
+
+	struct ItemRow {
+		int32_t pid = 0;
+		uint64_t hash = 0;
+		// Only compared, never dereferenced: the item may be gone since the row was saved.
+		const Item* item = nullptr;
+	};
+
+	using ItemRows = phmap::flat_hash_map<int32_t, ItemRow>;
+	using StorageMap = std::map<uint32_t, int32_t>;
+
+	/**
+	 * Gives the sids of a save. The loader puts the items of a parent back in sid order, so
+	 * an item keeps its saved sid as long as the sids of its parent still increase from front
+	 * to back. Items added in front take the free sids right below, the others take new
+	 * sids above every saved one. A parent without room is renumbered and gets room for the
+	 * items added in front of it later.
+	 */
+	class ItemSids {
+	public:
+		// Sids below are parent ids: inventory slots, depot ids and the inbox.
+		static constexpr int32_t FIRST_SID = 101;
+		static constexpr int32_t FRONT_ROOM = 32;
+
+		explicit ItemSids(const ItemRows* savedRows);
+
+		// The sids of the items of a parent, from front to back.
+		void assign(const std::vector<std::shared_ptr<Item>> &items, std::vector<int32_t> &sids);
+
+	private:
+		const ItemRows* savedRows;
+		phmap::flat_hash_map<const Item*, int32_t> saved;
+		int32_t last = FIRST_SID - 1;
+	};
+
+	// The rows staged by a recorded save.
+	struct Staged {
+		std::array<std::optional<ItemRows>, static_cast<uint8_t>(ItemTable::Last)> itemRows;
+		std::optional<StorageMap> storage;
+	};
+
+	static uint64_t hashItemRow(int32_t pid, uint16_t itemType, uint16_t count, const char* attributes, size_t attributesSize);
+
+	// Starts an empty saved state for the table, filled with the rows read when loading the player.
+	ItemRows &resetItemRows(ItemTable table);
+	// Returns nullptr when the database content of the table is unknown.
+	const ItemRows* getItemRows(ItemTable table) const;
+	void stageItemRows(ItemTable table, ItemRows &&rows);
+
+	StorageMap &resetStorage();
+	const StorageMap* getStorage() const;
+	void stageStorage(const StorageMap &storage);
+
+	bool isStorageDirty() const {
+		return storageDirty;
+	}
+	void setStorageDirty() {
+		storageDirty = true;
+	}
+
+	// Takes the rows staged by the save just recorded, the save is pending until committed or discarded.
+	Staged takeStaged();
+	// The pending save was written, its rows become the saved state.
+	void commit(Staged &&staged);
+	// The pending save was not written.
+	void discard();
+	// A save failed, forget everything so the next save rewrites the tables.
+	void reset();
+
+private:
+	std::array<std::optional<ItemRows>, static_cast<uint8_t>(ItemTable::Last)> itemRows;
+	std::optional<StorageMap> storage;
+
+	Staged staged;
+	uint32_t pendingSaves = 0;
+	bool storageDirty = false;
+};
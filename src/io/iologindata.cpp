@@ -13,9 +13,11 @@
 #include "io/functions/iologindata_load_player.hpp"
 #include "io/functions/iologindata_save_player.hpp"
 #include "game/game.hpp"
+#include "game/scheduling/dispatcher.hpp"
 #include "creatures/monsters/monster.hpp"
 #include "creatures/players/wheel/player_wheel.hpp"
 #include "lib/metrics/metrics.hpp"
+#include "lib/thread/thread_pool.hpp"
 #include "enums/account_type.hpp"
 #include "enums/account_errors.hpp"
 
@@ -92,19 +94,75 @@ void IOLoginData::updateOnlineStatus(uint32_t guid, bool login) {
 // The boolean "disableIrrelevantInfo" will deactivate the loading of information that is not relevant to the preload, for example, forge, bosstiary, etc. None of this we need to access if the player is offline
 bool IOLoginData::loadPlayerById(std::shared_ptr<Player> player, uint32_t id, bool disableIrrelevantInfo /* = true*/) {
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT * FROM `players` WHERE `id` = " << id;
-	return loadPlayer(player, db.storeQuery(query.str()), disableIrrelevantInfo);
+	return loadPlayer(player, db.storeStatement("SELECT * FROM `players` WHERE `id` = ?", { static_cast<uint64_t>(id) }), disableIrrelevantInfo);
 }
 
 bool IOLoginData::loadPlayerByName(std::shared_ptr<Player> player, const std::string &name, bool disableIrrelevantInfo /* = true*/) {
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT * FROM `players` WHERE `name` = " << db.escapeString(name);
-	return loadPlayer(player, db.storeQuery(query.str()), disableIrrelevantInfo);
+	return loadPlayer(player, db.storeStatement("SELECT * FROM `players` WHERE `name` = ?", { name }), disableIrrelevantInfo);
 }
 
 bool IOLoginData::loadPlayer(std::shared_ptr<Player> player, DBResult_ptr result, bool disableIrrelevantInfo /* = false*/) {
+	return loadPlayer(player, result, disableIrrelevantInfo, nullptr);
+}
+
+void IOLoginData::loadPlayerAsync(const std::shared_ptr<Player> &player, std::function<bool()> &&shouldLoad, std::function<void(bool)> &&callback) {
+	using Table = PlayerLoadData::Table;
+
+	struct AsyncLoad {
+		AsyncLoad(const std::shared_ptr<Player> &player, std::function<bool()> &&shouldLoad, std::function<void(bool)> &&callback) :
+			player(player), shouldLoad(std::move(shouldLoad)), callback(std::move(callback)), data(player) { }
+
+		std::shared_ptr<Player> player;
+		std::function<bool()> shouldLoad;
+		std::function<void(bool)> callback;
+		PlayerLoadData data;
+		std::vector<Table> tables;
+		std::atomic<size_t> nextTable = 0;
+		std::atomic<size_t> runningWorkers = 0;
+	};
+
+	auto load = std::make_shared<AsyncLoad>(player, std::move(shouldLoad), std::move(callback));
+	for (uint8_t table = 0; table < static_cast<uint8_t>(Table::Last); ++table) {
+		load->tables.emplace_back(static_cast<Table>(table));
+	}
+	// The loaders skip them, so they are not fetched either
+	std::erase_if(load->tables, [](Table table) {
+		return (table == Table::Prey && !g_configManager().getBoolean(PREY_ENABLED, __FUNCTION__))
+			|| (table == Table::TaskHunting && !g_configManager().getBoolean(TASK_HUNTING_ENABLED, __FUNCTION__));
+	});
+
+	// More workers than connections would only wait for one to be released
+	auto &threadPool = inject<ThreadPool>();
+	const size_t workers = std::clamp<size_t>(std::min<size_t>(Database::getInstance().getPoolSize(), threadPool.getNumberOfThreads()), 1, load->tables.size());
+	load->runningWorkers = workers;
+
+	for (size_t i = 0; i < workers; ++i) {
+		threadPool.addLoad([load] {
+			for (size_t index = load->nextTable++; index < load->tables.size(); index = load->nextTable++) {
+				load->data.fetch(load->tables[index]);
+			}
+
+			if (--load->runningWorkers != 0) {
+				return;
+			}
+
+			g_dispatcher().addEvent(
+				[load] {
+					// Applying the rows creates and registers items, not worth it for a player that is thrown away
+					if (!load->shouldLoad()) {
+						load->callback(false);
+						return;
+					}
+					load->callback(loadPlayer(load->player, load->data.take(Table::Player), false, &load->data));
+				},
+				"IOLoginData::loadPlayerAsync"
+			);
+		});
+	}
+}
+
+bool IOLoginData::loadPlayer(std::shared_ptr<Player> player, DBResult_ptr result, bool disableIrrelevantInfo, PlayerLoadData* data) {
 	if (!result || !player) {
 		std::string nullptrType = !result ? "Result" : "Player";
 		g_logger().warn("[{}] - {} is nullptr", __FUNCTION__, nullptrType);
@@ -115,6 +173,12 @@ bool IOLoginData::loadPlayer(std::shared_ptr<Player> player, DBResult_ptr result
 		// First
 		IOLoginDataLoad::loadPlayerFirst(player, result);
 
+		// Tables that were not fetched beforehand are queried by the loaders
+		std::optional<PlayerLoadData> queriedData;
+		if (!data) {
+			data = &queriedData.emplace(player);
+		}
+
 		// Experience load
 		IOLoginDataLoad::loadPlayerExperience(player, result);
 
@@ -134,56 +198,56 @@ bool IOLoginData::loadPlayer(std::shared_ptr<Player> player, DBResult_ptr result
 		IOLoginDataLoad::loadPlayerSkill(player, result);
 
 		// kills load
-		IOLoginDataLoad::loadPlayerKills(player, result);
+		IOLoginDataLoad::loadPlayerKills(player, result, *data);
 
 		// guild load
-		IOLoginDataLoad::loadPlayerGuild(player, result);
+		IOLoginDataLoad::loadPlayerGuild(player, result, *data);
 
 		// stash load items
-		IOLoginDataLoad::loadPlayerStashItems(player, result);
+		IOLoginDataLoad::loadPlayerStashItems(player, result, *data);
 
 		// bestiary charms
-		IOLoginDataLoad::loadPlayerBestiaryCharms(player, result);
+		IOLoginDataLoad::loadPlayerBestiaryCharms(player, result, *data);
 
 		// load inventory items
-		IOLoginDataLoad::loadPlayerInventoryItems(player, result);
+		IOLoginDataLoad::loadPlayerInventoryItems(player, result, *data);
 
 		// store Inbox
 		IOLoginDataLoad::loadPlayerStoreInbox(player);
 
 		// load depot items
-		IOLoginDataLoad::loadPlayerDepotItems(player, result);
+		IOLoginDataLoad::loadPlayerDepotItems(player, result, *data);
 
 		// load reward items
-		IOLoginDataLoad::loadRewardItems(player);
+		IOLoginDataLoad::loadRewardItems(player, *data);
 
 		// load inbox items
-		IOLoginDataLoad::loadPlayerInboxItems(player, result);
+		IOLoginDataLoad::loadPlayerInboxItems(player, result, *data);
 
 		// load storage map
-		IOLoginDataLoad::loadPlayerStorageMap(player, result);
+		IOLoginDataLoad::loadPlayerStorageMap(player, result, *data);
 
 		// load vip
-		IOLoginDataLoad::loadPlayerVip(player, result);
+		IOLoginDataLoad::loadPlayerVip(player, result, *data);
 
 		// load prey class
-		IOLoginDataLoad::loadPlayerPreyClass(player, result);
+		IOLoginDataLoad::loadPlayerPreyClass(player, result, *data);
 
 		// Load task hunting class
-		IOLoginDataLoad::loadPlayerTaskHuntingClass(player, result);
+		IOLoginDataLoad::loadPlayerTaskHuntingClass(player, result, *data);
 
 		// Load instant spells list
-		IOLoginDataLoad::loadPlayerInstantSpellList(player, result);
+		IOLoginDataLoad::loadPlayerInstantSpellList(player, result, *data);
 
 		if (disableIrrelevantInfo) {
 			return true;
 		}
 
 		// load forge history
-		IOLoginDataLoad::loadPlayerForgeHistory(player, result);
+		IOLoginDataLoad::loadPlayerForgeHistory(player, result, *data);
 
 		// load bosstiary
-		IOLoginDataLoad::loadPlayerBosstiary(player, result);
+		IOLoginDataLoad::loadPlayerBosstiary(player, result, *data);
 
 		IOLoginDataLoad::loadPlayerInitializeSystem(player);
 		IOLoginDataLoad::loadPlayerUpdateSystem(player);
@@ -198,16 +262,34 @@ bool IOLoginData::loadPlayer(std::shared_ptr<Player> player, DBResult_ptr result
 	}
 }
 
-bool IOLoginData::savePlayer(std::shared_ptr<Player> player) {
-	bool success = DBTransaction::executeWithinTransaction([player]() {
-		return savePlayerGuard(player);
-	});
+std::optional<std::vector<DBQuery>> IOLoginData::recordSavePlayer(std::shared_ptr<Player> player) {
+	DBQueryRecorder recorder;
+	try {
+		if (!savePlayerGuard(player)) {
+			player->saveState.reset();
+			return std::nullopt;
+		}
+	} catch (const std::exception &exception) {
+		player->saveState.reset();
+		g_logger().error("[{}] Error occurred recording player save, error: {}", __FUNCTION__, exception.what());
+		return std::nullopt;
+	}
 
-	if (!success) {
-		g_logger().error("[{}] Error occurred saving player", __FUNCTION__);
+	return recorder.release();
+}
+
+void IOLoginData::onPlayerSaved(std::shared_ptr<Player> player, PlayerSaveState::Staged &&staged, bool success) {
+	if (!player) {
+		return;
 	}
 
-	return success;
+	if (success) {
+		player->saveState.commit(std::move(staged));
+	} else {
+		// the transaction was rolled back, the next save must rewrite everything
+		player->saveState.discard();
+		player->saveState.reset();
+	}
 }
 
 bool IOLoginData::savePlayerGuard(std::shared_ptr<Player> player) {
@@ -13,6 +13,8 @@
 #include "creatures/players/player.hpp"
 #include "database/database.hpp"
 
+class PlayerLoadData;
+
 using ItemBlockList = std::list<std::pair<int32_t, std::shared_ptr<Item>>>;
 
 class IOLoginData {
@@ -23,7 +25,14 @@ public:
 	static bool loadPlayerById(std::shared_ptr<Player> player, uint32_t id, bool disableIrrelevantInfo = true);
 	static bool loadPlayerByName(std::shared_ptr<Player> player, const std::string &name, bool disableIrrelevantInfo = true);
 	static bool loadPlayer(std::shared_ptr<Player> player, DBResult_ptr result, bool disableIrrelevantInfo = false);
-	static bool savePlayer(std::shared_ptr<Player> player);
+	// Fetches the player in parallel on the thread pool and loads it on the dispatcher, then calls the callback with the result.
+	// The load is skipped and fails when shouldLoad, checked on the dispatcher, returns false (e.g. the client left).
+	static void loadPlayerAsync(const std::shared_ptr<Player> &player, std::function<bool()> &&shouldLoad, std::function<void(bool)> &&callback);
+	// Records the queries that save the player without executing them, returns std::nullopt on failure.
+	// The rows they stage must then be taken from the player save state.
+	static std::optional<std::vector<DBQuery>> recordSavePlayer(std::shared_ptr<Player> player);
+	// Must be called on the dispatcher once the recorded queries were executed, with the result of the transaction.
+	static void onPlayerSaved(std::shared_ptr<Player> player, PlayerSaveState::Staged &&staged, bool success);
 	static uint32_t getGuidByName(const std::string &name);
 	static bool getGuidByNameEx(uint32_t &guid, bool &specialVip, std::string &name);
 	static std::string getNameByGuid(uint32_t guid);
@@ -37,5 +46,6 @@ public:
 	static void removeVIPEntry(uint32_t accountId, uint32_t guid);
 
 private:
+	static bool loadPlayer(std::shared_ptr<Player> player, DBResult_ptr result, bool disableIrrelevantInfo, PlayerLoadData* data);
 	static bool savePlayerGuard(std::shared_ptr<Player> player);
 };
@@ -74,9 +74,14 @@ bool IOMapSerialize::saveHouseItems() {
 	return success;
 }
 
+std::vector<DBQuery> IOMapSerialize::recordHouseItems() {
+	DBQueryRecorder recorder;
+	SaveHouseItemsGuard();
+	return recorder.release();
+}
+
 bool IOMapSerialize::SaveHouseItemsGuard() {
 	Database &db = Database::getInstance();
-	std::ostringstream query;
 
 	// clear old tile data
 	if (!db.executeQuery("DELETE FROM `tile_store`")) {
@@ -94,8 +99,7 @@ bool IOMapSerialize::SaveHouseItemsGuard() {
 			size_t attributesSize;
 			const char* attributes = stream.getStream(attributesSize);
 			if (attributesSize > 0) {
-				query << house->getId() << ',' << db.escapeBlob(attributes, attributesSize);
-				if (!stmt.addRow(query)) {
+				if (!stmt.addRow({ static_cast<uint64_t>(house->getId()), DBBlob { std::string(attributes, attributesSize) } })) {
 					return false;
 				}
 				stream.clear();
@@ -327,6 +331,12 @@ bool IOMapSerialize::saveHouseInfo() {
 	return success;
 }
 
+std::vector<DBQuery> IOMapSerialize::recordHouseInfo() {
+	DBQueryRecorder recorder;
+	SaveHouseInfoGuard();
+	return recorder.release();
+}
+
 bool IOMapSerialize::SaveHouseInfoGuard() {
 	Database &db = Database::getInstance();
 
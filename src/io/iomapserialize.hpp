@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "database/database.hpp"
 #include "map/map.hpp"
 
 class IOMapSerialize {
@@ -18,6 +19,10 @@ public:
 	static bool loadHouseInfo();
 	static bool saveHouseInfo();
 
+	// Queries saveHouseInfo and saveHouseItems would execute, recorded to be executed later.
+	static std::vector<DBQuery> recordHouseInfo();
+	static std::vector<DBQuery> recordHouseItems();
+
 private:
 	static bool SaveHouseInfoGuard();
 	static bool SaveHouseItemsGuard();
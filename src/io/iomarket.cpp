@@ -59,10 +59,10 @@ MarketOfferList IOMarket::getActiveOffers(MarketAction_t action) {
 MarketOfferList IOMarket::getActiveOffers(MarketAction_t action, uint16_t itemId, uint8_t tier) {
 	MarketOfferList offerList;
 
-	std::ostringstream query;
-	query << "SELECT `id`, `amount`, `price`, `tier`, `created`, `anonymous`, (SELECT `name` FROM `players` WHERE `id` = `player_id`) AS `player_name` FROM `market_offers` WHERE `sale` = " << action << " AND `itemtype` = " << itemId << " AND `tier` = " << std::to_string(tier);
-
-	DBResult_ptr result = Database::getInstance().storeQuery(query.str());
+	DBResult_ptr result = Database::getInstance().storeStatement(
+		"SELECT `id`, `amount`, `price`, `tier`, `created`, `anonymous`, (SELECT `name` FROM `players` WHERE `id` = `player_id`) AS `player_name` FROM `market_offers` WHERE `sale` = ? AND `itemtype` = ? AND `tier` = ?",
+		{ static_cast<uint64_t>(action), static_cast<uint64_t>(itemId), static_cast<uint64_t>(tier) }
+	);
 	if (!result) {
 		return offerList;
 	}
@@ -91,10 +91,10 @@ MarketOfferList IOMarket::getOwnOffers(MarketAction_t action, uint32_t playerId)
 
 	const int32_t marketOfferDuration = g_configManager().getNumber(MARKET_OFFER_DURATION, __FUNCTION__);
 
-	std::ostringstream query;
-	query << "SELECT `id`, `amount`, `price`, `created`, `itemtype`, `tier` FROM `market_offers` WHERE `player_id` = " << playerId << " AND `sale` = " << action;
-
-	DBResult_ptr result = Database::getInstance().storeQuery(query.str());
+	DBResult_ptr result = Database::getInstance().storeStatement(
+		"SELECT `id`, `amount`, `price`, `created`, `itemtype`, `tier` FROM `market_offers` WHERE `player_id` = ? AND `sale` = ?",
+		{ static_cast<uint64_t>(playerId), static_cast<uint64_t>(action) }
+	);
 	if (!result) {
 		return offerList;
 	}
@@ -115,10 +115,10 @@ MarketOfferList IOMarket::getOwnOffers(MarketAction_t action, uint32_t playerId)
 HistoryMarketOfferList IOMarket::getOwnHistory(MarketAction_t action, uint32_t playerId) {
 	HistoryMarketOfferList offerList;
 
-	std::ostringstream query;
-	query << "SELECT `itemtype`, `amount`, `price`, `expires_at`, `state`, `tier` FROM `market_history` WHERE `player_id` = " << playerId << " AND `sale` = " << action;
-
-	DBResult_ptr result = Database::getInstance().storeQuery(query.str());
+	DBResult_ptr result = Database::getInstance().storeStatement(
+		"SELECT `itemtype`, `amount`, `price`, `expires_at`, `state`, `tier` FROM `market_history` WHERE `player_id` = ? AND `sale` = ?",
+		{ static_cast<uint64_t>(playerId), static_cast<uint64_t>(action) }
+	);
 	if (!result) {
 		return offerList;
 	}
@@ -236,10 +236,7 @@ void IOMarket::checkExpiredOffers() {
 }
 
 uint32_t IOMarket::getPlayerOfferCount(uint32_t playerId) {
-	std::ostringstream query;
-	query << "SELECT COUNT(*) AS `count` FROM `market_offers` WHERE `player_id` = " << playerId;
-
-	DBResult_ptr result = Database::getInstance().storeQuery(query.str());
+	DBResult_ptr result = Database::getInstance().storeStatement("SELECT COUNT(*) AS `count` FROM `market_offers` WHERE `player_id` = ?", { static_cast<uint64_t>(playerId) });
 	if (!result) {
 		return 0;
 	}
@@ -251,10 +248,10 @@ MarketOfferEx IOMarket::getOfferByCounter(uint32_t timestamp, uint16_t counter)
 
 	const int32_t created = timestamp - g_configManager().getNumber(MARKET_OFFER_DURATION, __FUNCTION__);
 
-	std::ostringstream query;
-	query << "SELECT `id`, `sale`, `itemtype`, `amount`, `created`, `price`, `player_id`, `anonymous`, `tier`, (SELECT `name` FROM `players` WHERE `id` = `player_id`) AS `player_name` FROM `market_offers` WHERE `created` = " << created << " AND (`id` & 65535) = " << counter << " LIMIT 1";
-
-	DBResult_ptr result = Database::getInstance().storeQuery(query.str());
+	DBResult_ptr result = Database::getInstance().storeStatement(
+		"SELECT `id`, `sale`, `itemtype`, `amount`, `created`, `price`, `player_id`, `anonymous`, `tier`, (SELECT `name` FROM `players` WHERE `id` = `player_id`) AS `player_name` FROM `market_offers` WHERE `created` = ? AND (`id` & 65535) = ? LIMIT 1",
+		{ static_cast<int64_t>(created), static_cast<uint64_t>(counter) }
+	);
 	if (!result) {
 		offer.id = 0;
 		return offer;
@@ -278,21 +275,18 @@ MarketOfferEx IOMarket::getOfferByCounter(uint32_t timestamp, uint16_t counter)
 }
 
 void IOMarket::createOffer(uint32_t playerId, MarketAction_t action, uint32_t itemId, uint16_t amount, uint64_t price, uint8_t tier, bool anonymous) {
-	std::ostringstream query;
-	query << "INSERT INTO `market_offers` (`player_id`, `sale`, `itemtype`, `amount`, `created`, `anonymous`, `price`, `tier`) VALUES (" << playerId << ',' << action << ',' << itemId << ',' << amount << ',' << getTimeNow() << ',' << anonymous << ',' << price << ',' << std::to_string(tier) << ')';
-	Database::getInstance().executeQuery(query.str());
+	Database::getInstance().executeStatement(
+		"INSERT INTO `market_offers` (`player_id`, `sale`, `itemtype`, `amount`, `created`, `anonymous`, `price`, `tier`) VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+		{ static_cast<uint64_t>(playerId), static_cast<uint64_t>(action), static_cast<uint64_t>(itemId), static_cast<uint64_t>(amount), static_cast<int64_t>(getTimeNow()), static_cast<uint64_t>(anonymous), price, static_cast<uint64_t>(tier) }
+	);
 }
 
 void IOMarket::acceptOffer(uint32_t offerId, uint16_t amount) {
-	std::ostringstream query;
-	query << "UPDATE `market_offers` SET `amount` = `amount` - " << amount << " WHERE `id` = " << offerId;
-	Database::getInstance().executeQuery(query.str());
+	Database::getInstance().executeStatement("UPDATE `market_offers` SET `amount` = `amount` - ? WHERE `id` = ?", { static_cast<uint64_t>(amount), static_cast<uint64_t>(offerId) });
 }
 
 void IOMarket::deleteOffer(uint32_t offerId) {
-	std::ostringstream query;
-	query << "DELETE FROM `market_offers` WHERE `id` = " << offerId;
-	Database::getInstance().executeQuery(query.str());
+	Database::getInstance().executeStatement("DELETE FROM `market_offers` WHERE `id` = ?", { static_cast<uint64_t>(offerId) });
 }
 
 void IOMarket::appendHistory(uint32_t playerId, MarketAction_t type, uint16_t itemId, uint16_t amount, uint64_t price, time_t timestamp, uint8_t tier, MarketOfferState_t state) {
@@ -306,17 +300,12 @@ void IOMarket::appendHistory(uint32_t playerId, MarketAction_t type, uint16_t it
 bool IOMarket::moveOfferToHistory(uint32_t offerId, MarketOfferState_t state) {
 	Database &db = Database::getInstance();
 
-	std::ostringstream query;
-	query << "SELECT `player_id`, `sale`, `itemtype`, `amount`, `price`, `created`, `tier` FROM `market_offers` WHERE `id` = " << offerId;
-
-	DBResult_ptr result = db.storeQuery(query.str());
+	DBResult_ptr result = db.storeStatement("SELECT `player_id`, `sale`, `itemtype`, `amount`, `price`, `created`, `tier` FROM `market_offers` WHERE `id` = ?", { static_cast<uint64_t>(offerId) });
 	if (!result) {
 		return false;
 	}
 
-	query.str(std::string());
-	query << "DELETE FROM `market_offers` WHERE `id` = " << offerId;
-	if (!db.executeQuery(query.str())) {
+	if (!db.executeStatement("DELETE FROM `market_offers` WHERE `id` = ?", { static_cast<uint64_t>(offerId) })) {
 		return false;
 	}
 
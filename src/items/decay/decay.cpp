@@ -14,11 +14,17 @@
 #include "lib/di/container.hpp"
 #include "game/game.hpp"
 #include "game/scheduling/dispatcher.hpp"
+#include "lib/metrics/metrics.hpp"
 
 Decay &Decay::getInstance() {
 	return inject<Decay>();
 }
 
+int64_t Decay::toTick(int64_t timestamp) {
+	// Rounded up, an item never expires before its timestamp
+	return (timestamp + SCHEDULER_MINTICKS - 1) / SCHEDULER_MINTICKS;
+}
+
 void Decay::startDecay(std::shared_ptr<Item> item) {
 	if (!item) {
 		return;
@@ -46,62 +52,24 @@ void Decay::startDecay(std::shared_ptr<Item> item) {
 		}
 
 		int64_t timestamp = OTSYS_TIME() + duration;
-		if (decayMap.empty()) {
-			eventId = g_dispatcher().scheduleEvent(
-				std::max<int32_t>(SCHEDULER_MINTICKS, duration), [this] { checkDecay(); }, "Decay::checkDecay"
-			);
-		} else {
-			if (timestamp < decayMap.begin()->first) {
-				g_dispatcher().stopEvent(eventId);
-				eventId = g_dispatcher().scheduleEvent(
-					std::max<int32_t>(SCHEDULER_MINTICKS, duration), [this] { checkDecay(); }, "Decay::checkDecay"
-				);
-			}
-		}
-
 		item->setDecaying(DECAYING_TRUE);
 		item->setAttribute(ItemAttribute_t::DURATION_TIMESTAMP, timestamp);
-		decayMap[timestamp].push_back(item);
+		link(item, timestamp);
 	}
 }
 
 void Decay::stopDecay(std::shared_ptr<Item> item) {
 	if (item->hasAttribute(ItemAttribute_t::DECAYSTATE)) {
-		auto timestamp = item->getAttribute<int64_t>(ItemAttribute_t::DURATION_TIMESTAMP);
 		if (item->hasAttribute(ItemAttribute_t::DURATION_TIMESTAMP)) {
-			auto it = decayMap.find(timestamp);
-			if (it != decayMap.end()) {
-				auto &decayItems = it->second;
-
-				size_t i = 0, end = decayItems.size();
-				auto decayItem = decayItems[i];
-				if (end == 1) {
-					if (item == decayItem) {
-						if (item->hasAttribute(ItemAttribute_t::DURATION)) {
-							// Incase we removed duration attribute don't assign new duration
-							item->setDuration(item->getDuration());
-						}
-						item->removeAttribute(ItemAttribute_t::DECAYSTATE);
-
-						decayMap.erase(it);
-					}
-					return;
-				}
-				while (i < end) {
-					decayItem = decayItems[i];
-					if (item == decayItem) {
-						if (item->hasAttribute(ItemAttribute_t::DURATION)) {
-							// Incase we removed duration attribute don't assign new duration
-							item->setDuration(item->getDuration());
-						}
-						item->removeAttribute(ItemAttribute_t::DECAYSTATE);
-
-						decayItems[i] = decayItems.back();
-						decayItems.pop_back();
-						return;
-					}
-					++i;
+			if (item->decayIndex != NO_DECAY_INDEX) {
+				if (item->hasAttribute(ItemAttribute_t::DURATION)) {
+					// Incase we removed duration attribute don't assign new duration
+					item->setDuration(item->getDuration());
 				}
+				item->removeAttribute(ItemAttribute_t::DECAYSTATE);
+
+				unlink(item);
+				return;
 			}
 			item->removeAttribute(ItemAttribute_t::DURATION_TIMESTAMP);
 		} else {
@@ -110,26 +78,78 @@ void Decay::stopDecay(std::shared_ptr<Item> item) {
 	}
 }
 
+void Decay::link(const std::shared_ptr<Item> &item, int64_t timestamp) {
+	if (item->decayIndex != NO_DECAY_INDEX) {
+		unlink(item);
+	}
+
+	if (decayingCount == 0 && eventId == 0) {
+		// The wheel was idle, start counting from now instead of the last expired tick
+		currentTick = OTSYS_TIME() / SCHEDULER_MINTICKS;
+	}
+
+	const int64_t tick = std::max(toTick(timestamp), currentTick + 1);
+	const auto slotIndex = static_cast<uint16_t>(tick & (WHEEL_SIZE - 1));
+	auto &slot = wheel[slotIndex];
+
+	item->decaySlot = slotIndex;
+	item->decayIndex = static_cast<uint32_t>(slot.size());
+	slot.push_back({ tick, item });
+	++decayingCount;
+
+	scheduleCheck();
+}
+
+void Decay::unlink(const std::shared_ptr<Item> &item) {
+	auto &slot = wheel[item->decaySlot];
+	const uint32_t index = item->decayIndex;
+	if (index != slot.size() - 1) {
+		slot[index] = std::move(slot.back());
+		slot[index].item->decayIndex = index;
+	}
+	slot.pop_back();
+
+	item->decayIndex = NO_DECAY_INDEX;
+	--decayingCount;
+}
+
+void Decay::scheduleCheck() {
+	if (eventId != 0 || decayingCount == 0) {
+		return;
+	}
+
+	eventId = g_dispatcher().scheduleEvent(
+		SCHEDULER_MINTICKS, [this] { checkDecay(); }, "Decay::checkDecay"
+	);
+}
+
 void Decay::checkDecay() {
-	int64_t timestamp = OTSYS_TIME();
+	metrics::method_latency measure(__METHOD_NAME__);
+
+	eventId = 0;
+	const int64_t nowTick = OTSYS_TIME() / SCHEDULER_MINTICKS;
 
 	std::vector<std::shared_ptr<Item>> tempItems;
 	tempItems.reserve(32); // Small preallocation
 
-	auto it = decayMap.begin(), end = decayMap.end();
-	while (it != end) {
-		if (it->first > timestamp) {
-			break;
-		}
+	// After a stall longer than a turn every slot only needs to be visited once
+	const int64_t lastTick = std::min(nowTick, currentTick + WHEEL_SIZE);
+	for (int64_t tick = currentTick + 1; tick <= lastTick; ++tick) {
+		auto &slot = wheel[tick & (WHEEL_SIZE - 1)];
+		size_t i = 0;
+		while (i < slot.size()) {
+			if (slot[i].tick > nowTick) {
+				++i;
+				continue;
+			}
 
-		// Iterating here is unsafe so let's copy our items into temporary vector
-		auto &decayItems = it->second;
-		tempItems.reserve(tempItems.size() + decayItems.size());
-		for (auto &decayItem : decayItems) {
-			tempItems.push_back(decayItem);
+			// Decaying an item can start or stop other decays, so they are expired afterwards
+			auto item = slot[i].item;
+			unlink(item);
+			tempItems.push_back(std::move(item));
 		}
-		it = decayMap.erase(it);
 	}
+	currentTick = std::max(currentTick, nowTick);
 
 	for (const auto &item : tempItems) {
 		if (!item->canDecay()) {
@@ -141,11 +161,12 @@ void Decay::checkDecay() {
 		}
 	}
 
-	if (it != end) {
-		eventId = g_dispatcher().scheduleEvent(
-			std::max<int32_t>(SCHEDULER_MINTICKS, static_cast<int32_t>(it->first - timestamp)), [this] { checkDecay(); }, "Decay::checkDecay"
-		);
+	if (decayingCount != reportedCount) {
+		g_metrics().addUpDownCounter("decaying_items", static_cast<int>(static_cast<int64_t>(decayingCount) - static_cast<int64_t>(reportedCount)));
+		reportedCount = decayingCount;
 	}
+
+	scheduleCheck();
 }
 
 void Decay::internalDecayItem(std::shared_ptr<Item> item) {
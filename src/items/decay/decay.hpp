@@ -11,6 +11,14 @@
 
 class Item;
 
+/**
+ * Keeps the decaying items in a hashed timing wheel.
+ *
+ * Each slot covers one tick (SCHEDULER_MINTICKS) and the wheel turns every
+ * WHEEL_SIZE ticks, items due in a later turn stay in their slot until their
+ * tick is reached. Every item stores its slot and index in the slot, so
+ * stopping a decay is a swap and pop instead of a lookup.
+ */
 class Decay {
 public:
 	Decay() = default;
@@ -23,13 +31,34 @@ public:
 	void startDecay(std::shared_ptr<Item> item);
 	void stopDecay(std::shared_ptr<Item> item);
 
+	[[nodiscard]] size_t size() const {
+		return decayingCount;
+	}
+
 private:
+	static constexpr uint32_t WHEEL_BITS = 12;
+	static constexpr uint32_t WHEEL_SIZE = 1 << WHEEL_BITS;
+	static constexpr uint32_t NO_DECAY_INDEX = std::numeric_limits<uint32_t>::max();
+
+	struct Entry {
+		int64_t tick;
+		std::shared_ptr<Item> item;
+	};
+
+	static int64_t toTick(int64_t timestamp);
+
+	void link(const std::shared_ptr<Item> &item, int64_t timestamp);
+	void unlink(const std::shared_ptr<Item> &item);
 	void checkDecay();
+	void scheduleCheck();
 	void internalDecayItem(std::shared_ptr<Item> item);
 
-	uint32_t eventId { 0 };
-	// order is important, so we use an std::map
-	std::map<int64_t, std::vector<std::shared_ptr<Item>>> decayMap;
+	std::array<std::vector<Entry>, WHEEL_SIZE> wheel;
+	// Last tick already expired, items are always linked to a later tick.
+	int64_t currentTick { 0 };
+	size_t decayingCount { 0 };
+	size_t reportedCount { 0 };
+	uint64_t eventId { 0 };
 };
 
 constexpr auto g_decay = Decay::getInstance;
@@ -771,6 +771,10 @@ protected:
 	bool isLootTrackeable = false;
 	bool decayDisabled = false;
 
+	// Position in the Decay timing wheel, only handled by the Decay class.
+	uint16_t decaySlot = 0;
+	uint32_t decayIndex = std::numeric_limits<uint32_t>::max();
+
 private:
 	void setImbuement(uint8_t slot, uint16_t imbuementId, uint32_t duration);
 	// Don't add variables here, use the ItemAttribute class.
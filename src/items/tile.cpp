@@ -1635,6 +1635,8 @@ void Tile::updateTileFlags(const std::shared_ptr<Item> &item) {
 }
 
 void Tile::setTileFlags(const std::shared_ptr<Item> &item) {
+	const bool wasWalkable = !hasFlag(TILESTATE_BLOCKSOLID | TILESTATE_FLOORCHANGE);
+
 	if (!hasFlag(TILESTATE_FLOORCHANGE)) {
 		const auto &it = Item::items[item->getID()];
 		if (it.floorChange != 0) {
@@ -1719,9 +1721,15 @@ void Tile::setTileFlags(const std::shared_ptr<Item> &item) {
 	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE)) {
 		setFlag(TILESTATE_SUPPORTS_HANGABLE);
 	}
+
+	if (wasWalkable && hasFlag(TILESTATE_BLOCKSOLID | TILESTATE_FLOORCHANGE)) {
+		g_game().map.invalidatePathClusters(getPosition());
+	}
 }
 
 void Tile::resetTileFlags(const std::shared_ptr<Item> &item) {
+	const bool wasWalkable = !hasFlag(TILESTATE_BLOCKSOLID | TILESTATE_FLOORCHANGE);
+
 	const ItemType &it = Item::items[item->getID()];
 	if (it.floorChange != 0) {
 		resetFlag(TILESTATE_FLOORCHANGE);
@@ -1800,6 +1808,10 @@ void Tile::resetTileFlags(const std::shared_ptr<Item> &item) {
 	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE)) {
 		resetFlag(TILESTATE_SUPPORTS_HANGABLE);
 	}
+
+	if (!wasWalkable && !hasFlag(TILESTATE_BLOCKSOLID | TILESTATE_FLOORCHANGE)) {
+		g_game().map.invalidatePathClusters(getPosition());
+	}
 }
 
 bool Tile::isMovableBlocking() const {
@@ -35,58 +35,373 @@ void KVStore::set(const std::string &key, const ValueWrapper &value) {
 	return setLocked(key, value);
 }
 
-void KVStore::setLocked(const std::string &key, const ValueWrapper &value) {
-	logger.trace("KVStore::set({})", key);
-	auto it = store_.find(key);
-	if (it != store_.end()) {
-		it->second.first = value;
-		lruQueue_.splice(lruQueue_.begin(), lruQueue_, it->second.second);
+size_t KVStore::estimateSize(const ValueWrapper &value) {
+	return sizeof(ValueWrapper) + std::visit(
+		[](const auto &arg) -> size_t {
+			using T = std::decay_t<decltype(arg)>;
+			if constexpr (std::is_same_v<T, StringType>) {
+				return arg.capacity();
+			} else if constexpr (std::is_same_v<T, ArrayType>) {
+				size_t size = 0;
+				for (const auto &item : arg) {
+					size += estimateSize(item);
+				}
+				return size;
+			} else if constexpr (std::is_same_v<T, MapType>) {
+				size_t size = 0;
+				for (const auto &[key, item] : arg) {
+					size += sizeof(std::pair<const std::string, std::shared_ptr<ValueWrapper>>) + key.capacity();
+					if (item) {
+						size += estimateSize(*item);
+					}
+				}
+				return size;
+			} else {
+				return 0;
+			}
+		},
+		value.getVariant()
+	);
+}
+
+void KVStore::linkFront(Entry* entry) {
+	entry->prev = nullptr;
+	entry->next = lruHead_;
+	if (lruHead_) {
+		lruHead_->prev = entry;
+	}
+	lruHead_ = entry;
+	if (!lruTail_) {
+		lruTail_ = entry;
+	}
+}
+
+void KVStore::unlink(Entry* entry) {
+	if (entry->prev) {
+		entry->prev->next = entry->next;
+	} else {
+		lruHead_ = entry->next;
+	}
+	if (entry->next) {
+		entry->next->prev = entry->prev;
 	} else {
-		if (store_.size() >= MAX_SIZE) {
-			logger.debug("KVStore::set() - MAX_SIZE reached, removing last element");
-			auto last = lruQueue_.end();
-			last--;
-			save(*last, store_[*last].first);
-			store_.erase(*last);
-			lruQueue_.pop_back();
+		lruTail_ = entry->prev;
+	}
+	entry->prev = entry->next = nullptr;
+}
+
+void KVStore::touch(Entry* entry) {
+	if (entry != lruHead_) {
+		unlink(entry);
+		linkFront(entry);
+	}
+}
+
+void KVStore::evictLocked() {
+	while (lruTail_ && (store_.size() > MAX_SIZE || memoryUsage_ > memoryLimit_)) {
+		Entry* last = lruTail_;
+		// Copied, the key is owned by the node about to be erased.
+		const std::string key = *last->key;
+		logger.debug("KVStore::evict({})", key);
+
+		unlink(last);
+		memoryUsage_ -= last->bytes;
+		if (last->dirty) {
+			if (writeBehind_) {
+				// Written by the next flush, get() still finds it meanwhile.
+				evicted_.insert_or_assign(key, std::move(last->value));
+				if (evicted_.size() >= MAX_EVICTED_PENDING && !flushRequested_.exchange(true)) {
+					flushSignal_.notify_all();
+				}
+			} else {
+				save(key, last->value);
+			}
 		}
+		// Removes it from dirtyKeys_ lazily, the flush skips keys no longer in the store.
+		store_.erase(key);
+	}
+}
+
+void KVStore::setLocked(const std::string &key, const ValueWrapper &value, bool dirty /* = true */) {
+	logger.trace("KVStore::set({})", key);
+	auto [it, inserted] = store_.try_emplace(key);
+	Entry &entry = it->second;
+	if (inserted) {
+		entry.key = &it->first;
+		linkFront(&entry);
+		evicted_.erase(key);
+	} else {
+		memoryUsage_ -= entry.bytes;
+		touch(&entry);
+	}
+
+	entry.value = value;
+	entry.bytes = sizeof(Entry) + key.capacity() + estimateSize(value);
+	memoryUsage_ += entry.bytes;
 
-		lruQueue_.push_front(key);
-		store_.try_emplace(key, std::make_pair(value, lruQueue_.begin()));
+	if (dirty && !entry.dirty) {
+		entry.dirty = true;
+		dirtyKeys_.emplace_back(key);
 	}
+
+	if (keyIndexLoaded_) {
+		indexKey(key, value.isDeleted());
+		if (keyIndexBytes_ > memoryLimit_ / KEY_INDEX_MEMORY_SHARE) {
+			logger.warn("KVStore key index outgrew its share of the memory limit, keys() will query the backend");
+			dropKeyIndex();
+			keyIndexTooLarge_ = true;
+		}
+	}
+
+	evictLocked();
 }
 
 std::optional<ValueWrapper> KVStore::get(const std::string &key, bool forceLoad /*= false */) {
 	logger.trace("KVStore::get({})", key);
 	std::scoped_lock lock(mutex_);
-	if (forceLoad || !store_.contains(key)) {
-		auto value = load(key);
-		if (value) {
-			setLocked(key, *value);
+	if (!forceLoad) {
+		if (auto it = store_.find(key); it != store_.end()) {
+			Entry &entry = it->second;
+			if (entry.value.isDeleted()) {
+				// Kept until saved, but the first to go when memory is needed.
+				if (&entry != lruTail_) {
+					unlink(&entry);
+					entry.prev = lruTail_;
+					if (lruTail_) {
+						lruTail_->next = &entry;
+					}
+					lruTail_ = &entry;
+					if (!lruHead_) {
+						lruHead_ = &entry;
+					}
+				}
+				return std::nullopt;
+			}
+			touch(&entry);
+			return entry.value;
+		}
+
+		// Evicted before being written, it is still the newest value.
+		if (auto it = evicted_.find(key); it != evicted_.end()) {
+			auto value = std::move(it->second);
+			evicted_.erase(it);
+			setLocked(key, value);
+			if (value.isDeleted()) {
+				return std::nullopt;
+			}
+			return value;
 		}
-		return value;
 	}
 
-	auto &[value, lruIt] = store_[key];
-	if (value.isDeleted()) {
-		lruQueue_.splice(lruQueue_.end(), lruQueue_, lruIt);
-		return std::nullopt;
+	auto value = load(key);
+	if (value) {
+		setLocked(key, *value, false);
 	}
-	lruQueue_.splice(lruQueue_.begin(), lruQueue_, lruIt);
 	return value;
 }
 
+bool KVStore::saveBatch(const std::vector<std::pair<std::string, ValueWrapper>> &values) {
+	bool success = true;
+	for (const auto &[key, value] : values) {
+		success = save(key, value) && success;
+	}
+	return success;
+}
+
+bool KVStore::saveAll() {
+	std::scoped_lock flushLock(flushMutex_);
+
+	std::vector<std::pair<std::string, ValueWrapper>> batch;
+	{
+		std::scoped_lock lock(mutex_);
+		flushRequested_ = false;
+		batch.reserve(dirtyKeys_.size() + evicted_.size());
+		for (auto &key : dirtyKeys_) {
+			auto it = store_.find(key);
+			if (it == store_.end() || !it->second.dirty) {
+				continue;
+			}
+			it->second.dirty = false;
+			batch.emplace_back(std::move(key), it->second.value);
+		}
+		dirtyKeys_.clear();
+
+		for (auto &[key, value] : evicted_) {
+			batch.emplace_back(key, std::move(value));
+		}
+		evicted_.clear();
+	}
+
+	if (batch.empty()) {
+		return true;
+	}
+
+	logger.debug("KVStore::saveAll() - writing {} keys", batch.size());
+	if (saveBatch(batch)) {
+		return true;
+	}
+
+	// Marked dirty again so the next flush retries, unless it was changed meanwhile.
+	std::scoped_lock lock(mutex_);
+	for (auto &[key, value] : batch) {
+		auto it = store_.find(key);
+		if (it == store_.end()) {
+			evicted_.try_emplace(key, std::move(value));
+		} else if (!it->second.dirty) {
+			it->second.dirty = true;
+			dirtyKeys_.emplace_back(key);
+		}
+	}
+	return false;
+}
+
+void KVStore::clear() {
+	std::scoped_lock lock(mutex_);
+	store_.clear();
+	lruHead_ = lruTail_ = nullptr;
+	memoryUsage_ = 0;
+	dirtyKeys_.clear();
+	evicted_.clear();
+	keyIndex_.clear();
+	keyIndexBytes_ = 0;
+	keyIndexLoaded_ = false;
+	keyIndexTooLarge_ = false;
+}
+
+void KVStore::startWriteBehind(std::chrono::milliseconds interval) {
+	if (writeBehind_.exchange(true)) {
+		return;
+	}
+
+	logger.info("KVStore write-behind enabled, flushing every {}ms", interval.count());
+	flusher_ = std::jthread([this, interval](const std::stop_token &stopToken) {
+		std::mutex waitMutex;
+		while (!stopToken.stop_requested()) {
+			{
+				std::unique_lock lock(waitMutex);
+				flushSignal_.wait_for(lock, stopToken, interval, [this] { return flushRequested_.load(); });
+			}
+			if (!saveAll()) {
+				logger.error("KVStore write-behind flush failed, retrying on the next one");
+			}
+		}
+	});
+}
+
+void KVStore::stopWriteBehind() {
+	if (!writeBehind_.exchange(false)) {
+		return;
+	}
+
+	flusher_.request_stop();
+	flusher_.join();
+	saveAll();
+}
+
+void KVStore::setMemoryLimit(size_t bytes) {
+	std::scoped_lock lock(mutex_);
+	memoryLimit_ = bytes;
+	// A larger limit may fit the index again, a smaller one may not fit the loaded one anymore
+	keyIndexTooLarge_ = false;
+	if (keyIndexBytes_ > memoryLimit_ / KEY_INDEX_MEMORY_SHARE) {
+		dropKeyIndex();
+	}
+	evictLocked();
+}
+
+size_t KVStore::getMemoryUsage() {
+	std::scoped_lock lock(mutex_);
+	return memoryUsage_;
+}
+
+size_t KVStore::estimateIndexSize(const std::string &key) {
+	// Tree node: the key, three links and the color
+	return sizeof(std::string) + 4 * sizeof(void*) + key.capacity();
+}
+
+void KVStore::indexKey(const std::string &key, bool deleted) {
+	if (deleted) {
+		if (auto it = keyIndex_.find(key); it != keyIndex_.end()) {
+			keyIndexBytes_ -= estimateIndexSize(*it);
+			memoryUsage_ -= estimateIndexSize(*it);
+			keyIndex_.erase(it);
+		}
+		return;
+	}
+
+	if (auto [it, inserted] = keyIndex_.emplace(key); inserted) {
+		keyIndexBytes_ += estimateIndexSize(*it);
+		memoryUsage_ += estimateIndexSize(*it);
+	}
+}
+
+void KVStore::dropKeyIndex() {
+	memoryUsage_ -= keyIndexBytes_;
+	keyIndexBytes_ = 0;
+	keyIndex_.clear();
+	keyIndexLoaded_ = false;
+}
+
+bool KVStore::loadKeyIndex() {
+	if (keyIndexLoaded_) {
+		return true;
+	}
+	if (keyIndexTooLarge_) {
+		return false;
+	}
+
+	for (const auto &key : loadPrefix()) {
+		indexKey(key, false);
+	}
+	// Keys only known by the cache, and the ones removed but not saved yet.
+	for (const auto &[key, entry] : store_) {
+		indexKey(key, entry.value.isDeleted());
+	}
+	for (const auto &[key, value] : evicted_) {
+		indexKey(key, value.isDeleted());
+	}
+
+	if (keyIndexBytes_ > memoryLimit_ / KEY_INDEX_MEMORY_SHARE) {
+		logger.warn("KVStore key index does not fit its share of the memory limit, keys() will query the backend");
+		dropKeyIndex();
+		keyIndexTooLarge_ = true;
+		return false;
+	}
+
+	keyIndexLoaded_ = true;
+	evictLocked();
+	return true;
+}
+
 std::unordered_set<std::string> KVStore::keys(const std::string &prefix /*= ""*/) {
 	std::scoped_lock lock(mutex_);
 	std::unordered_set<std::string> keys;
-	for (const auto &[key, value] : store_) {
-		if (key.find(prefix) == 0) {
-			std::string suffix = key.substr(prefix.size());
-			keys.insert(suffix);
+	if (loadKeyIndex()) {
+		for (auto it = keyIndex_.lower_bound(prefix); it != keyIndex_.end() && it->starts_with(prefix); ++it) {
+			keys.insert(it->substr(prefix.size()));
+		}
+		return keys;
+	}
+
+	for (auto &key : loadPrefix(prefix)) {
+		keys.insert(std::move(key));
+	}
+	// The cache is newer than the backend
+	const auto merge = [&keys, &prefix](const std::string &key, const ValueWrapper &value) {
+		if (!key.starts_with(prefix)) {
+			return;
+		}
+		if (value.isDeleted()) {
+			keys.erase(key.substr(prefix.size()));
+		} else {
+			keys.insert(key.substr(prefix.size()));
 		}
+	};
+	for (const auto &[key, entry] : store_) {
+		merge(key, entry.value);
 	}
-	for (const auto &key : loadPrefix(prefix)) {
-		keys.insert(key);
+	for (const auto &[key, value] : evicted_) {
+		merge(key, value);
 	}
 	return keys;
 }
@@ -17,7 +17,9 @@
 	#include <optional>
 	#include <unordered_set>
 	#include <iomanip>
-	#include <list>
+	#include <set>
+	#include <thread>
+	#include <condition_variable>
 #endif
 
 #include "lib/logging/logger.hpp"
@@ -71,9 +73,33 @@ private:
 	static std::mutex mutex_;
 };
 
+/**
+ * Cache in front of the persisted key-value store.
+ *
+ * Entries are kept in a node map, so the LRU links live in the entries themselves
+ * and touching a key never allocates. The cache is bounded both by MAX_SIZE keys
+ * and by an estimated memory limit in bytes, the least recently used entries are
+ * evicted first.
+ *
+ * Changed keys are only marked dirty: setting a key many times between two saves
+ * writes it once. saveAll() writes every dirty key in a single batch, and the
+ * write-behind mode calls it periodically from a background thread. Evicted dirty
+ * entries are saved right away, or kept until the next flush in write-behind mode.
+ *
+ * keys() is answered by a sorted index of every known key, loaded once from the
+ * backend, so prefix lookups don't query it again. The index counts against the
+ * memory limit, and is dropped when it grows past a quarter of it: keys() then
+ * queries the backend every time, as it did before the index existed.
+ */
 class KVStore : public KV {
 public:
 	static constexpr size_t MAX_SIZE = 1000000;
+	static constexpr size_t DEFAULT_MEMORY_LIMIT = 256 * 1024 * 1024;
+	// Evicted dirty entries waiting for the flush that wake up the write-behind thread earlier.
+	static constexpr size_t MAX_EVICTED_PENDING = 10000;
+	// The key index may take up to 1 / KEY_INDEX_MEMORY_SHARE of the memory limit.
+	static constexpr size_t KEY_INDEX_MEMORY_SHARE = 4;
+
 	static KVStore &getInstance();
 
 	explicit KVStore(Logger &logger) :
@@ -85,38 +111,82 @@ public:
 
 	std::optional<ValueWrapper> get(const std::string &key, bool forceLoad = false) override;
 
+	bool saveAll() override;
+
 	void flush() override {
-		std::scoped_lock lock(mutex_);
-		KV::flush();
-		store_.clear();
+		saveAll();
+		clear();
 	}
 
 	std::shared_ptr<KV> scoped(const std::string &scope) override final;
-	std::unordered_set<std::string> keys(const std::string &prefix = "");
+	std::unordered_set<std::string> keys(const std::string &prefix = "") override;
 
-protected:
-	phmap::parallel_flat_hash_map<std::string, std::pair<ValueWrapper, std::list<std::string>::iterator>> getStore() {
-		std::scoped_lock lock(mutex_);
-		phmap::parallel_flat_hash_map<std::string, std::pair<ValueWrapper, std::list<std::string>::iterator>> copy;
-		for (const auto &[key, value] : store_) {
-			copy.try_emplace(key, value);
-		}
-		return copy;
-	}
+	void startWriteBehind(std::chrono::milliseconds interval);
+	void stopWriteBehind();
+
+	void setMemoryLimit(size_t bytes);
+	[[nodiscard]] size_t getMemoryUsage();
 
 protected:
 	Logger &logger;
 
 	virtual std::optional<ValueWrapper> load(const std::string &key) = 0;
 	virtual bool save(const std::string &key, const ValueWrapper &value) = 0;
+	// Saves every value in one go, backends that can batch writes should override it.
+	virtual bool saveBatch(const std::vector<std::pair<std::string, ValueWrapper>> &values);
 	virtual std::vector<std::string> loadPrefix(const std::string &prefix = "") = 0;
 
 private:
-	void setLocked(const std::string &key, const ValueWrapper &value);
+	struct Entry {
+		ValueWrapper value;
+		// LRU links, the head is the most recently used entry.
+		Entry* prev = nullptr;
+		Entry* next = nullptr;
+		// Key of the map node holding this entry.
+		const std::string* key = nullptr;
+		size_t bytes = 0;
+		bool dirty = false;
+	};
+
+	static size_t estimateSize(const ValueWrapper &value);
+
+	void setLocked(const std::string &key, const ValueWrapper &value, bool dirty = true);
+	void clear();
+
+	void linkFront(Entry* entry);
+	void unlink(Entry* entry);
+	void touch(Entry* entry);
+	void evictLocked();
+
+	static size_t estimateIndexSize(const std::string &key);
+
+	// Returns false when the index does not fit its share of the memory limit.
+	bool loadKeyIndex();
+	void indexKey(const std::string &key, bool deleted);
+	void dropKeyIndex();
+
+	phmap::parallel_node_hash_map<std::string, Entry> store_;
+	Entry* lruHead_ = nullptr;
+	Entry* lruTail_ = nullptr;
+	size_t memoryUsage_ = 0;
+	size_t memoryLimit_ = DEFAULT_MEMORY_LIMIT;
+
+	std::vector<std::string> dirtyKeys_;
+	phmap::flat_hash_map<std::string, ValueWrapper> evicted_;
+
+	std::set<std::string> keyIndex_;
+	size_t keyIndexBytes_ = 0;
+	bool keyIndexLoaded_ = false;
+	bool keyIndexTooLarge_ = false;
 
-	phmap::parallel_flat_hash_map<std::string, std::pair<ValueWrapper, std::list<std::string>::iterator>> store_;
-	std::list<std::string> lruQueue_;
 	std::mutex mutex_;
+	// Keeps the batches in order when the write-behind thread and a server save flush together.
+	std::mutex flushMutex_;
+
+	std::atomic_bool writeBehind_ = false;
+	std::atomic_bool flushRequested_ = false;
+	std::condition_variable_any flushSignal_;
+	std::jthread flusher_;
 };
 
 class ScopedKV final : public KV {
@@ -11,13 +11,11 @@
 
 #include "kv/kv_sql.hpp"
 #include "kv/value_wrapper_proto.hpp"
-#include "utils/tools.hpp"
 
 #include <kv.pb.h>
 
 std::optional<ValueWrapper> KVSQL::load(const std::string &key) {
-	auto query = fmt::format("SELECT `key_name`, `timestamp`, `value` FROM `kv_store` WHERE `key_name` = {}", db.escapeString(key));
-	auto result = db.storeQuery(query);
+	auto result = db.storeStatement("SELECT `key_name`, `timestamp`, `value` FROM `kv_store` WHERE `key_name` = ?", { key });
 	if (result == nullptr) {
 		return std::nullopt;
 	}
@@ -41,17 +39,14 @@ std::optional<ValueWrapper> KVSQL::load(const std::string &key) {
 
 std::vector<std::string> KVSQL::loadPrefix(const std::string &prefix /* = ""*/) {
 	std::vector<std::string> keys;
-	std::string keySearch = db.escapeString(prefix + "%");
-	auto query = fmt::format("SELECT `key_name` FROM `kv_store` WHERE `key_name` LIKE {}", keySearch);
-	auto result = db.storeQuery(query);
+	auto result = db.storeStatement("SELECT `key_name` FROM `kv_store` WHERE `key_name` LIKE ?", { prefix + "%" });
 	if (result == nullptr) {
 		return keys;
 	}
 
 	do {
 		std::string key = result->getString("key_name");
-		replaceString(key, prefix, "");
-		keys.push_back(key);
+		keys.push_back(key.substr(std::min(prefix.size(), key.size())));
 	} while (result->next());
 
 	return keys;
@@ -70,29 +65,41 @@ bool KVSQL::prepareSave(const std::string &key, const ValueWrapper &value, DBIns
 		return false;
 	}
 	if (value.isDeleted()) {
-		auto query = fmt::format("DELETE FROM `kv_store` WHERE `key_name` = {}", db.escapeString(key));
-		return db.executeQuery(query);
+		return db.executeStatement("DELETE FROM `kv_store` WHERE `key_name` = ?", { key });
 	}
 
-	update.addRow(fmt::format("{}, {}, {}", db.escapeString(key), value.getTimestamp(), db.escapeString(data)));
-	return true;
+	return update.addRow({ key, value.getTimestamp(), DBBlob { std::move(data) } });
 }
 
-bool KVSQL::saveAll() {
-	auto store = getStore();
-	bool success = DBTransaction::executeWithinTransaction([this, &store]() {
+bool KVSQL::saveBatch(const std::vector<std::pair<std::string, ValueWrapper>> &values) {
+	bool success = DBTransaction::executeWithinTransaction([this, &values]() {
 		auto update = dbUpdate();
-		if (!std::ranges::all_of(store, [this, &update](const auto &kv) {
-				const auto &[key, value] = kv;
-				return prepareSave(key, value.first, update);
-			})) {
-			return false;
+		std::vector<DBValue> deletedKeys;
+		for (const auto &[key, value] : values) {
+			if (value.isDeleted()) {
+				deletedKeys.emplace_back(key);
+			} else if (!prepareSave(key, value, update)) {
+				return false;
+			}
+		}
+
+		// Only a few batch sizes, so the deletes share the same few prepared statements
+		for (size_t first = 0; first < deletedKeys.size();) {
+			const size_t remaining = deletedKeys.size() - first;
+			const size_t batchSize = remaining >= 256 ? 256 : (remaining >= 16 ? 16 : 1);
+			const std::vector<std::string_view> placeholders(batchSize, "?");
+			const auto query = fmt::format("DELETE FROM `kv_store` WHERE `key_name` IN ({})", fmt::join(placeholders, ", "));
+			const auto begin = deletedKeys.begin() + static_cast<std::ptrdiff_t>(first);
+			if (!db.executeStatement(query, std::vector<DBValue>(begin, begin + static_cast<std::ptrdiff_t>(batchSize)))) {
+				return false;
+			}
+			first += batchSize;
 		}
 		return update.execute();
 	});
 
 	if (!success) {
-		g_logger().error("[{}] Error occurred saving player", __FUNCTION__);
+		logger.error("[{}] Error occurred saving {} keys", __FUNCTION__, values.size());
 	}
 
 	return success;
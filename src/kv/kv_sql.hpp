@@ -22,12 +22,16 @@ public:
 		KVStore(logger),
 		db(db) { }
 
-	bool saveAll() override;
+	~KVSQL() {
+		// The flusher thread calls back into this class, it must stop before it is gone.
+		stopWriteBehind();
+	}
 
 private:
 	std::vector<std::string> loadPrefix(const std::string &prefix = "") override;
 	std::optional<ValueWrapper> load(const std::string &key) override;
 	bool save(const std::string &key, const ValueWrapper &value) override;
+	bool saveBatch(const std::vector<std::pair<std::string, ValueWrapper>> &values) override;
 	bool prepareSave(const std::string &key, const ValueWrapper &value, DBInsert &update);
 
 	DBInsert dbUpdate() {
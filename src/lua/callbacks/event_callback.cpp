@@ -15,6 +15,12 @@
 #include "items/item.hpp"
 #include "creatures/players/player.hpp"
 #include "game/zones/zone.hpp"
+#include "lib/metrics/metrics.hpp"
+
+namespace {
+	// Handlers of the event being dispatched by EventsCallbacks
+	const std::vector<std::shared_ptr<EventCallback>>* dispatchHandlers = nullptr;
+}
 
 /**
  * @class EventCallback
@@ -45,6 +51,66 @@ void EventCallback::setType(EventCallback_t type) {
 	m_callbackType = type;
 }
 
+void EventCallback::setDispatchHandlers(const std::vector<std::shared_ptr<EventCallback>>* handlers) {
+	dispatchHandlers = handlers;
+}
+
+template <typename OnResult>
+bool EventCallback::callHandlers(lua_State* L, int nargs, int nresults, OnResult &&onResult) const {
+	// Taken before running any script, so events raised by the handlers dispatch their own
+	const auto* handlers = std::exchange(dispatchHandlers, nullptr);
+	const int argsIndex = lua_gettop(L) - nargs + 1;
+	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
+
+	bool succeeded = true;
+	const auto call = [&](const EventCallback &handler) {
+		LuaScriptInterface* scriptInterface = handler.getScriptInterface();
+		scriptEnvironment->setScriptId(handler.getScriptId(), scriptInterface);
+
+		metrics::lua_latency measure(scriptInterface->getMetricsScope());
+		scriptInterface->pushFunction(handler.getScriptId());
+		for (int i = 0; i < nargs; ++i) {
+			lua_pushvalue(L, argsIndex + i);
+		}
+
+		if (LuaScriptInterface::protectedCall(L, nargs, nresults) != 0) {
+			LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
+			succeeded = false;
+		} else {
+			onResult(argsIndex);
+		}
+		lua_settop(L, argsIndex + nargs - 1);
+	};
+
+	if (!handlers) {
+		call(*this);
+	} else {
+		// Indexed and copied, a handler may reload the scripts and clear the list
+		for (size_t i = 0; i < handlers->size(); ++i) {
+			const auto handler = (*handlers)[i];
+			if (handler && handler->isLoadedCallback()) {
+				call(*handler);
+			}
+		}
+	}
+
+	lua_settop(L, argsIndex - 1);
+	getScriptInterface()->resetScriptEnv();
+	return succeeded;
+}
+
+bool EventCallback::callHandlers(lua_State* L, int nargs) const {
+	bool result = true;
+	const bool succeeded = callHandlers(L, nargs, 1, [&](int) {
+		result = result && LuaScriptInterface::getBoolean(L, -1);
+	});
+	return succeeded && result;
+}
+
+void EventCallback::callVoidHandlers(lua_State* L, int nargs) const {
+	callHandlers(L, nargs, 0, [](int) { });
+}
+
 // Lua functions
 // Creature
 bool EventCallback::creatureOnChangeOutfit(std::shared_ptr<Creature> creature, const Outfit_t &outfit) const {
@@ -55,18 +121,14 @@ bool EventCallback::creatureOnChangeOutfit(std::shared_ptr<Creature> creature, c
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
 
 	LuaScriptInterface::pushOutfit(L, outfit);
 
-	return getScriptInterface()->callFunction(2);
+	return callHandlers(L, 2);
 }
 
 ReturnValue EventCallback::creatureOnAreaCombat(std::shared_ptr<Creature> creature, std::shared_ptr<Tile> tile, bool aggressive) const {
@@ -78,11 +140,7 @@ ReturnValue EventCallback::creatureOnAreaCombat(std::shared_ptr<Creature> creatu
 		return RETURNVALUE_NOTPOSSIBLE;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	if (creature) {
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
@@ -96,17 +154,14 @@ ReturnValue EventCallback::creatureOnAreaCombat(std::shared_ptr<Creature> creatu
 
 	LuaScriptInterface::pushBoolean(L, aggressive);
 
-	ReturnValue returnValue;
-	if (getScriptInterface()->protectedCall(L, 3, 1) != 0) {
-		returnValue = RETURNVALUE_NOTPOSSIBLE;
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
-		returnValue = LuaScriptInterface::getNumber<ReturnValue>(L, -1);
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
-	return returnValue;
+	// The first handler refusing the combat decides the result
+	ReturnValue returnValue = RETURNVALUE_NOERROR;
+	const bool called = callHandlers(L, 3, 1, [&](int) {
+		if (returnValue == RETURNVALUE_NOERROR) {
+			returnValue = LuaScriptInterface::getNumber<ReturnValue>(L, -1);
+		}
+	});
+	return called ? returnValue : RETURNVALUE_NOTPOSSIBLE;
 }
 
 ReturnValue EventCallback::creatureOnTargetCombat(std::shared_ptr<Creature> creature, std::shared_ptr<Creature> target) const {
@@ -118,11 +173,7 @@ ReturnValue EventCallback::creatureOnTargetCombat(std::shared_ptr<Creature> crea
 		return RETURNVALUE_NOTPOSSIBLE;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	if (creature) {
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
@@ -134,17 +185,14 @@ ReturnValue EventCallback::creatureOnTargetCombat(std::shared_ptr<Creature> crea
 	LuaScriptInterface::pushUserdata<Creature>(L, target);
 	LuaScriptInterface::setCreatureMetatable(L, -1, target);
 
-	ReturnValue returnValue;
-	if (getScriptInterface()->protectedCall(L, 2, 1) != 0) {
-		returnValue = RETURNVALUE_NOTPOSSIBLE;
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
-		returnValue = LuaScriptInterface::getNumber<ReturnValue>(L, -1);
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
-	return returnValue;
+	// The first handler refusing the combat decides the result
+	ReturnValue returnValue = RETURNVALUE_NOERROR;
+	const bool called = callHandlers(L, 2, 1, [&](int) {
+		if (returnValue == RETURNVALUE_NOERROR) {
+			returnValue = LuaScriptInterface::getNumber<ReturnValue>(L, -1);
+		}
+	});
+	return called ? returnValue : RETURNVALUE_NOTPOSSIBLE;
 }
 
 void EventCallback::creatureOnHear(std::shared_ptr<Creature> creature, std::shared_ptr<Creature> speaker, const std::string &words, SpeakClasses type) const {
@@ -156,11 +204,7 @@ void EventCallback::creatureOnHear(std::shared_ptr<Creature> creature, std::shar
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -171,7 +215,7 @@ void EventCallback::creatureOnHear(std::shared_ptr<Creature> creature, std::shar
 	LuaScriptInterface::pushString(L, words);
 	lua_pushnumber(L, type);
 
-	getScriptInterface()->callVoidFunction(4);
+	callVoidHandlers(L, 4);
 }
 
 void EventCallback::creatureOnDrainHealth(std::shared_ptr<Creature> creature, std::shared_ptr<Creature> attacker, CombatType_t &typePrimary, int32_t &damagePrimary, CombatType_t &typeSecondary, int32_t &damageSecondary, TextColor_t &colorPrimary, TextColor_t &colorSecondary) const {
@@ -183,11 +227,7 @@ void EventCallback::creatureOnDrainHealth(std::shared_ptr<Creature> creature, st
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	if (creature) {
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
@@ -210,19 +250,19 @@ void EventCallback::creatureOnDrainHealth(std::shared_ptr<Creature> creature, st
 	lua_pushnumber(L, colorPrimary);
 	lua_pushnumber(L, colorSecondary);
 
-	if (getScriptInterface()->protectedCall(L, 8, 6) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
+	callHandlers(L, 8, 6, [&](int argsIndex) {
 		typePrimary = LuaScriptInterface::getNumber<CombatType_t>(L, -6);
 		damagePrimary = LuaScriptInterface::getNumber<int32_t>(L, -5);
 		typeSecondary = LuaScriptInterface::getNumber<CombatType_t>(L, -4);
 		damageSecondary = LuaScriptInterface::getNumber<int32_t>(L, -3);
 		colorPrimary = LuaScriptInterface::getNumber<TextColor_t>(L, -2);
 		colorSecondary = LuaScriptInterface::getNumber<TextColor_t>(L, -1);
-		lua_pop(L, 6);
-	}
-
-	getScriptInterface()->resetScriptEnv();
+		// The next handler receives the changed values
+		for (int i = 0; i < 6; ++i) {
+			lua_pushvalue(L, -6 + i);
+			lua_replace(L, argsIndex + 2 + i);
+		}
+	});
 }
 
 // Party
@@ -235,11 +275,7 @@ bool EventCallback::partyOnJoin(std::shared_ptr<Party> party, std::shared_ptr<Pl
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
 	LuaScriptInterface::setMetatable(L, -1, "Party");
@@ -247,7 +283,7 @@ bool EventCallback::partyOnJoin(std::shared_ptr<Party> party, std::shared_ptr<Pl
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
-	return getScriptInterface()->callFunction(2);
+	return callHandlers(L, 2);
 }
 
 bool EventCallback::partyOnLeave(std::shared_ptr<Party> party, std::shared_ptr<Player> player) const {
@@ -259,11 +295,7 @@ bool EventCallback::partyOnLeave(std::shared_ptr<Party> party, std::shared_ptr<P
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
 	LuaScriptInterface::setMetatable(L, -1, "Party");
@@ -271,7 +303,7 @@ bool EventCallback::partyOnLeave(std::shared_ptr<Party> party, std::shared_ptr<P
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
-	return getScriptInterface()->callFunction(2);
+	return callHandlers(L, 2);
 }
 
 bool EventCallback::partyOnDisband(std::shared_ptr<Party> party) const {
@@ -282,16 +314,12 @@ bool EventCallback::partyOnDisband(std::shared_ptr<Party> party) const {
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
 	LuaScriptInterface::setMetatable(L, -1, "Party");
 
-	return getScriptInterface()->callFunction(1);
+	return callHandlers(L, 1);
 }
 
 void EventCallback::partyOnShareExperience(std::shared_ptr<Party> party, uint64_t &exp) const {
@@ -300,25 +328,18 @@ void EventCallback::partyOnShareExperience(std::shared_ptr<Party> party, uint64_
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
 	LuaScriptInterface::setMetatable(L, -1, "Party");
 
 	lua_pushnumber(L, exp);
 
-	if (getScriptInterface()->protectedCall(L, 2, 1) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
+	callHandlers(L, 2, 1, [&](int argsIndex) {
 		exp = LuaScriptInterface::getNumber<uint64_t>(L, -1);
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
+		lua_pushvalue(L, -1);
+		lua_replace(L, argsIndex + 1);
+	});
 }
 
 // Player
@@ -331,18 +352,14 @@ bool EventCallback::playerOnBrowseField(std::shared_ptr<Player> player, const Po
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
 	LuaScriptInterface::pushPosition(L, position);
 
-	return getScriptInterface()->callFunction(2);
+	return callHandlers(L, 2);
 }
 
 void EventCallback::playerOnLook(std::shared_ptr<Player> player, const Position &position, std::shared_ptr<Thing> thing, uint8_t stackpos, int32_t lookDistance) const {
@@ -354,11 +371,7 @@ void EventCallback::playerOnLook(std::shared_ptr<Player> player, const Position
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -376,7 +389,7 @@ void EventCallback::playerOnLook(std::shared_ptr<Player> player, const Position
 	LuaScriptInterface::pushPosition(L, position, stackpos);
 	lua_pushnumber(L, lookDistance);
 
-	getScriptInterface()->callVoidFunction(4);
+	callVoidHandlers(L, 4);
 }
 
 void EventCallback::playerOnLookInBattleList(std::shared_ptr<Player> player, std::shared_ptr<Creature> creature, int32_t lookDistance) const {
@@ -388,11 +401,7 @@ void EventCallback::playerOnLookInBattleList(std::shared_ptr<Player> player, std
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -402,7 +411,7 @@ void EventCallback::playerOnLookInBattleList(std::shared_ptr<Player> player, std
 
 	lua_pushnumber(L, lookDistance);
 
-	getScriptInterface()->callVoidFunction(3);
+	callVoidHandlers(L, 3);
 }
 
 void EventCallback::playerOnLookInTrade(std::shared_ptr<Player> player, std::shared_ptr<Player> partner, std::shared_ptr<Item> item, int32_t lookDistance) const {
@@ -414,11 +423,7 @@ void EventCallback::playerOnLookInTrade(std::shared_ptr<Player> player, std::sha
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -431,7 +436,7 @@ void EventCallback::playerOnLookInTrade(std::shared_ptr<Player> player, std::sha
 
 	lua_pushnumber(L, lookDistance);
 
-	getScriptInterface()->callVoidFunction(4);
+	callVoidHandlers(L, 4);
 }
 
 bool EventCallback::playerOnLookInShop(std::shared_ptr<Player> player, const ItemType* itemType, uint8_t count) const {
@@ -443,11 +448,7 @@ bool EventCallback::playerOnLookInShop(std::shared_ptr<Player> player, const Ite
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -457,7 +458,7 @@ bool EventCallback::playerOnLookInShop(std::shared_ptr<Player> player, const Ite
 
 	lua_pushnumber(L, count);
 
-	return getScriptInterface()->callFunction(3);
+	return callHandlers(L, 3);
 }
 
 void EventCallback::playerOnRemoveCount(std::shared_ptr<Player> player, std::shared_ptr<Item> item) const {
@@ -469,11 +470,7 @@ void EventCallback::playerOnRemoveCount(std::shared_ptr<Player> player, std::sha
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -481,7 +478,7 @@ void EventCallback::playerOnRemoveCount(std::shared_ptr<Player> player, std::sha
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
 
-	getScriptInterface()->callFunction(2);
+	callVoidHandlers(L, 2);
 }
 
 bool EventCallback::playerOnMoveItem(std::shared_ptr<Player> player, std::shared_ptr<Item> item, uint16_t count, const Position &fromPos, const Position &toPos, std::shared_ptr<Cylinder> fromCylinder, std::shared_ptr<Cylinder> toCylinder) const {
@@ -497,13 +494,8 @@ bool EventCallback::playerOnMoveItem(std::shared_ptr<Player> player, std::shared
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
 
-	getScriptInterface()->pushFunction(getScriptId());
-
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
@@ -516,7 +508,7 @@ bool EventCallback::playerOnMoveItem(std::shared_ptr<Player> player, std::shared
 	LuaScriptInterface::pushCylinder(L, fromCylinder);
 	LuaScriptInterface::pushCylinder(L, toCylinder);
 
-	return getScriptInterface()->callFunction(7);
+	return callHandlers(L, 7);
 }
 
 void EventCallback::playerOnItemMoved(std::shared_ptr<Player> player, std::shared_ptr<Item> item, uint16_t count, const Position &fromPosition, const Position &toPosition, std::shared_ptr<Cylinder> fromCylinder, std::shared_ptr<Cylinder> toCylinder) const {
@@ -528,11 +520,7 @@ void EventCallback::playerOnItemMoved(std::shared_ptr<Player> player, std::share
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -547,7 +535,7 @@ void EventCallback::playerOnItemMoved(std::shared_ptr<Player> player, std::share
 	LuaScriptInterface::pushCylinder(L, fromCylinder);
 	LuaScriptInterface::pushCylinder(L, toCylinder);
 
-	getScriptInterface()->callVoidFunction(7);
+	callVoidHandlers(L, 7);
 }
 
 void EventCallback::playerOnChangeZone(std::shared_ptr<Player> player, ZoneType_t zone) const {
@@ -559,17 +547,13 @@ void EventCallback::playerOnChangeZone(std::shared_ptr<Player> player, ZoneType_
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
 	lua_pushnumber(L, zone);
-	getScriptInterface()->callVoidFunction(2);
+	callVoidHandlers(L, 2);
 }
 
 bool EventCallback::playerOnMoveCreature(std::shared_ptr<Player> player, std::shared_ptr<Creature> creature, const Position &fromPosition, const Position &toPosition) const {
@@ -581,11 +565,7 @@ bool EventCallback::playerOnMoveCreature(std::shared_ptr<Player> player, std::sh
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -596,7 +576,7 @@ bool EventCallback::playerOnMoveCreature(std::shared_ptr<Player> player, std::sh
 	LuaScriptInterface::pushPosition(L, fromPosition);
 	LuaScriptInterface::pushPosition(L, toPosition);
 
-	return getScriptInterface()->callFunction(4);
+	return callHandlers(L, 4);
 }
 
 void EventCallback::playerOnReportRuleViolation(std::shared_ptr<Player> player, const std::string &targetName, uint8_t reportType, uint8_t reportReason, const std::string &comment, const std::string &translation) const {
@@ -608,11 +588,7 @@ void EventCallback::playerOnReportRuleViolation(std::shared_ptr<Player> player,
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -625,7 +601,7 @@ void EventCallback::playerOnReportRuleViolation(std::shared_ptr<Player> player,
 	LuaScriptInterface::pushString(L, comment);
 	LuaScriptInterface::pushString(L, translation);
 
-	getScriptInterface()->callVoidFunction(6);
+	callVoidHandlers(L, 6);
 }
 
 void EventCallback::playerOnReportBug(std::shared_ptr<Player> player, const std::string &message, const Position &position, uint8_t category) const {
@@ -637,11 +613,7 @@ void EventCallback::playerOnReportBug(std::shared_ptr<Player> player, const std:
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -650,7 +622,7 @@ void EventCallback::playerOnReportBug(std::shared_ptr<Player> player, const std:
 	LuaScriptInterface::pushPosition(L, position);
 	lua_pushnumber(L, category);
 
-	getScriptInterface()->callFunction(4);
+	callVoidHandlers(L, 4);
 }
 
 bool EventCallback::playerOnTurn(std::shared_ptr<Player> player, Direction direction) const {
@@ -662,18 +634,14 @@ bool EventCallback::playerOnTurn(std::shared_ptr<Player> player, Direction direc
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
 	lua_pushnumber(L, direction);
 
-	return getScriptInterface()->callFunction(2);
+	return callHandlers(L, 2);
 }
 
 bool EventCallback::playerOnTradeRequest(std::shared_ptr<Player> player, std::shared_ptr<Player> target, std::shared_ptr<Item> item) const {
@@ -685,11 +653,7 @@ bool EventCallback::playerOnTradeRequest(std::shared_ptr<Player> player, std::sh
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -700,7 +664,7 @@ bool EventCallback::playerOnTradeRequest(std::shared_ptr<Player> player, std::sh
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
 
-	return getScriptInterface()->callFunction(3);
+	return callHandlers(L, 3);
 }
 
 bool EventCallback::playerOnTradeAccept(std::shared_ptr<Player> player, std::shared_ptr<Player> target, std::shared_ptr<Item> item, std::shared_ptr<Item> targetItem) const {
@@ -712,11 +676,7 @@ bool EventCallback::playerOnTradeAccept(std::shared_ptr<Player> player, std::sha
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -730,7 +690,7 @@ bool EventCallback::playerOnTradeAccept(std::shared_ptr<Player> player, std::sha
 	LuaScriptInterface::pushUserdata<Item>(L, targetItem);
 	LuaScriptInterface::setItemMetatable(L, -1, targetItem);
 
-	return getScriptInterface()->callFunction(4);
+	return callHandlers(L, 4);
 }
 
 void EventCallback::playerOnGainExperience(std::shared_ptr<Player> player, std::shared_ptr<Creature> target, uint64_t &exp, uint64_t rawExp) const {
@@ -742,11 +702,7 @@ void EventCallback::playerOnGainExperience(std::shared_ptr<Player> player, std::
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -761,14 +717,11 @@ void EventCallback::playerOnGainExperience(std::shared_ptr<Player> player, std::
 	lua_pushnumber(L, exp);
 	lua_pushnumber(L, rawExp);
 
-	if (getScriptInterface()->protectedCall(L, 4, 1) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
+	callHandlers(L, 4, 1, [&](int argsIndex) {
 		exp = LuaScriptInterface::getNumber<uint64_t>(L, -1);
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
+		lua_pushvalue(L, -1);
+		lua_replace(L, argsIndex + 2);
+	});
 }
 
 void EventCallback::playerOnLoseExperience(std::shared_ptr<Player> player, uint64_t &exp) const {
@@ -780,25 +733,18 @@ void EventCallback::playerOnLoseExperience(std::shared_ptr<Player> player, uint6
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
 	lua_pushnumber(L, exp);
 
-	if (getScriptInterface()->protectedCall(L, 2, 1) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
+	callHandlers(L, 2, 1, [&](int argsIndex) {
 		exp = LuaScriptInterface::getNumber<uint64_t>(L, -1);
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
+		lua_pushvalue(L, -1);
+		lua_replace(L, argsIndex + 1);
+	});
 }
 
 void EventCallback::playerOnGainSkillTries(std::shared_ptr<Player> player, skills_t skill, uint64_t &tries) const {
@@ -810,11 +756,7 @@ void EventCallback::playerOnGainSkillTries(std::shared_ptr<Player> player, skill
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -822,14 +764,11 @@ void EventCallback::playerOnGainSkillTries(std::shared_ptr<Player> player, skill
 	lua_pushnumber(L, skill);
 	lua_pushnumber(L, tries);
 
-	if (getScriptInterface()->protectedCall(L, 3, 1) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
+	callHandlers(L, 3, 1, [&](int argsIndex) {
 		tries = LuaScriptInterface::getNumber<uint64_t>(L, -1);
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
+		lua_pushvalue(L, -1);
+		lua_replace(L, argsIndex + 2);
+	});
 }
 
 void EventCallback::playerOnCombat(std::shared_ptr<Player> player, std::shared_ptr<Creature> target, std::shared_ptr<Item> item, CombatDamage &damage) const {
@@ -841,11 +780,7 @@ void EventCallback::playerOnCombat(std::shared_ptr<Player> player, std::shared_p
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -866,15 +801,12 @@ void EventCallback::playerOnCombat(std::shared_ptr<Player> player, std::shared_p
 
 	LuaScriptInterface::pushCombatDamage(L, damage);
 
-	if (getScriptInterface()->protectedCall(L, 8, 4) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
+	callHandlers(L, 8, 4, [&](int argsIndex) {
 		damage.primary.value = std::abs(LuaScriptInterface::getNumber<int32_t>(L, -4));
 		damage.primary.type = LuaScriptInterface::getNumber<CombatType_t>(L, -3);
 		damage.secondary.value = std::abs(LuaScriptInterface::getNumber<int32_t>(L, -2));
 		damage.secondary.type = LuaScriptInterface::getNumber<CombatType_t>(L, -1);
 
-		lua_pop(L, 4);
 		if (damage.primary.type != COMBAT_HEALING) {
 			damage.primary.value = -damage.primary.value;
 			damage.secondary.value = -damage.secondary.value;
@@ -889,9 +821,11 @@ void EventCallback::playerOnCombat(std::shared_ptr<Player> player, std::shared_p
 				damage.secondary.value = 0;
 			}
 		}
-	}
 
-	getScriptInterface()->resetScriptEnv();
+		// The next handler receives the changed damage
+		lua_settop(L, argsIndex + 2);
+		LuaScriptInterface::pushCombatDamage(L, damage);
+	});
 }
 
 void EventCallback::playerOnRequestQuestLog(std::shared_ptr<Player> player) const {
@@ -903,16 +837,12 @@ void EventCallback::playerOnRequestQuestLog(std::shared_ptr<Player> player) cons
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
-	getScriptInterface()->callVoidFunction(1);
+	callVoidHandlers(L, 1);
 }
 
 void EventCallback::playerOnRequestQuestLine(std::shared_ptr<Player> player, uint16_t questId) const {
@@ -924,18 +854,14 @@ void EventCallback::playerOnRequestQuestLine(std::shared_ptr<Player> player, uin
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
 	lua_pushnumber(L, questId);
 
-	getScriptInterface()->callVoidFunction(2);
+	callVoidHandlers(L, 2);
 }
 
 void EventCallback::playerOnInventoryUpdate(std::shared_ptr<Player> player, std::shared_ptr<Item> item, Slots_t slot, bool equip) const {
@@ -944,11 +870,7 @@ void EventCallback::playerOnInventoryUpdate(std::shared_ptr<Player> player, std:
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -959,7 +881,7 @@ void EventCallback::playerOnInventoryUpdate(std::shared_ptr<Player> player, std:
 	lua_pushnumber(L, slot);
 	LuaScriptInterface::pushBoolean(L, equip);
 
-	getScriptInterface()->callVoidFunction(4);
+	callVoidHandlers(L, 4);
 }
 
 bool EventCallback::playerOnRotateItem(std::shared_ptr<Player> player, std::shared_ptr<Item> item, const Position &position) const {
@@ -968,11 +890,7 @@ bool EventCallback::playerOnRotateItem(std::shared_ptr<Player> player, std::shar
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -982,7 +900,7 @@ bool EventCallback::playerOnRotateItem(std::shared_ptr<Player> player, std::shar
 
 	LuaScriptInterface::pushPosition(L, position);
 
-	return getScriptInterface()->callFunction(3);
+	return callHandlers(L, 3);
 }
 
 void EventCallback::playerOnWalk(std::shared_ptr<Player> player, Direction &dir) const {
@@ -994,18 +912,14 @@ void EventCallback::playerOnWalk(std::shared_ptr<Player> player, Direction &dir)
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
 
 	lua_pushnumber(L, dir);
 
-	getScriptInterface()->callVoidFunction(2);
+	callVoidHandlers(L, 2);
 }
 
 void EventCallback::playerOnStorageUpdate(std::shared_ptr<Player> player, const uint32_t key, const int32_t value, int32_t oldValue, uint64_t currentTime) const {
@@ -1017,11 +931,7 @@ void EventCallback::playerOnStorageUpdate(std::shared_ptr<Player> player, const
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
 	LuaScriptInterface::setMetatable(L, -1, "Player");
@@ -1031,7 +941,7 @@ void EventCallback::playerOnStorageUpdate(std::shared_ptr<Player> player, const
 	lua_pushnumber(L, oldValue);
 	lua_pushnumber(L, currentTime);
 
-	getScriptInterface()->callVoidFunction(5);
+	callVoidHandlers(L, 5);
 }
 
 // Monster
@@ -1044,11 +954,7 @@ void EventCallback::monsterOnDropLoot(std::shared_ptr<Monster> monster, std::sha
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Monster>(L, monster);
 	LuaScriptInterface::setMetatable(L, -1, "Monster");
@@ -1056,7 +962,7 @@ void EventCallback::monsterOnDropLoot(std::shared_ptr<Monster> monster, std::sha
 	LuaScriptInterface::pushUserdata<Container>(L, corpse);
 	LuaScriptInterface::setMetatable(L, -1, "Container");
 
-	return getScriptInterface()->callVoidFunction(2);
+	callVoidHandlers(L, 2);
 }
 
 void EventCallback::monsterPostDropLoot(std::shared_ptr<Monster> monster, std::shared_ptr<Container> corpse) const {
@@ -1068,11 +974,7 @@ void EventCallback::monsterPostDropLoot(std::shared_ptr<Monster> monster, std::s
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Monster>(L, monster);
 	LuaScriptInterface::setMetatable(L, -1, "Monster");
@@ -1080,7 +982,7 @@ void EventCallback::monsterPostDropLoot(std::shared_ptr<Monster> monster, std::s
 	LuaScriptInterface::pushUserdata<Container>(L, corpse);
 	LuaScriptInterface::setMetatable(L, -1, "Container");
 
-	return getScriptInterface()->callVoidFunction(2);
+	callVoidHandlers(L, 2);
 }
 
 void EventCallback::monsterOnSpawn(std::shared_ptr<Monster> monster, const Position &position) const {
@@ -1092,23 +994,13 @@ void EventCallback::monsterOnSpawn(std::shared_ptr<Monster> monster, const Posit
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Monster>(L, monster);
 	LuaScriptInterface::setMetatable(L, -1, "Monster");
 	LuaScriptInterface::pushPosition(L, position);
 
-	if (getScriptInterface()->protectedCall(L, 2, 1) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
+	callVoidHandlers(L, 2);
 }
 
 // Npc
@@ -1121,23 +1013,13 @@ void EventCallback::npcOnSpawn(std::shared_ptr<Npc> npc, const Position &positio
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Npc>(L, npc);
 	LuaScriptInterface::setMetatable(L, -1, "Npc");
 	LuaScriptInterface::pushPosition(L, position);
 
-	if (getScriptInterface()->protectedCall(L, 2, 1) != 0) {
-		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(L));
-	} else {
-		lua_pop(L, 1);
-	}
-
-	getScriptInterface()->resetScriptEnv();
+	callVoidHandlers(L, 2);
 }
 
 bool EventCallback::zoneBeforeCreatureEnter(std::shared_ptr<Zone> zone, std::shared_ptr<Creature> creature) const {
@@ -1149,11 +1031,7 @@ bool EventCallback::zoneBeforeCreatureEnter(std::shared_ptr<Zone> zone, std::sha
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Zone>(L, zone);
 	LuaScriptInterface::setMetatable(L, -1, "Zone");
@@ -1161,7 +1039,7 @@ bool EventCallback::zoneBeforeCreatureEnter(std::shared_ptr<Zone> zone, std::sha
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
 
-	return getScriptInterface()->callFunction(2);
+	return callHandlers(L, 2);
 }
 
 bool EventCallback::zoneBeforeCreatureLeave(std::shared_ptr<Zone> zone, std::shared_ptr<Creature> creature) const {
@@ -1173,11 +1051,7 @@ bool EventCallback::zoneBeforeCreatureLeave(std::shared_ptr<Zone> zone, std::sha
 		return false;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Zone>(L, zone);
 	LuaScriptInterface::setMetatable(L, -1, "Zone");
@@ -1185,7 +1059,7 @@ bool EventCallback::zoneBeforeCreatureLeave(std::shared_ptr<Zone> zone, std::sha
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
 
-	return getScriptInterface()->callFunction(2);
+	return callHandlers(L, 2);
 }
 
 void EventCallback::zoneAfterCreatureEnter(std::shared_ptr<Zone> zone, std::shared_ptr<Creature> creature) const {
@@ -1197,11 +1071,7 @@ void EventCallback::zoneAfterCreatureEnter(std::shared_ptr<Zone> zone, std::shar
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Zone>(L, zone);
 	LuaScriptInterface::setMetatable(L, -1, "Zone");
@@ -1209,7 +1079,7 @@ void EventCallback::zoneAfterCreatureEnter(std::shared_ptr<Zone> zone, std::shar
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
 
-	getScriptInterface()->callVoidFunction(2);
+	callVoidHandlers(L, 2);
 }
 
 void EventCallback::zoneAfterCreatureLeave(std::shared_ptr<Zone> zone, std::shared_ptr<Creature> creature) const {
@@ -1221,11 +1091,7 @@ void EventCallback::zoneAfterCreatureLeave(std::shared_ptr<Zone> zone, std::shar
 		return;
 	}
 
-	ScriptEnvironment* scriptEnvironment = getScriptInterface()->getScriptEnv();
-	scriptEnvironment->setScriptId(getScriptId(), getScriptInterface());
-
 	lua_State* L = getScriptInterface()->getLuaState();
-	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Zone>(L, zone);
 	LuaScriptInterface::setMetatable(L, -1, "Zone");
@@ -1233,5 +1099,5 @@ void EventCallback::zoneAfterCreatureLeave(std::shared_ptr<Zone> zone, std::shar
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
 
-	getScriptInterface()->callVoidFunction(2);
+	callVoidHandlers(L, 2);
 }
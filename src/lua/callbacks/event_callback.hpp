@@ -67,6 +67,14 @@ public:
 	 */
 	void setType(EventCallback_t type);
 
+	/**
+	 * @brief Sets the handlers that the next call of an event function runs in one go.
+	 * @details Used by EventsCallbacks: the event function is called on the first handler, which
+	 * reserves the script environment and pushes the arguments once for all of them.
+	 * @param handlers The handlers of the event, or nullptr to run only the called one.
+	 */
+	static void setDispatchHandlers(const std::vector<std::shared_ptr<EventCallback>>* handlers);
+
 	/**
 	 * @defgroup EventCallbacks Event Callback Functions
 	 * @brief These functions are called in response to specific game events.
@@ -135,4 +143,24 @@ public:
 	/**
 	 * @note here end the lua binder functions }
 	 */
+
+private:
+	/**
+	 * @brief Calls the lua function of every dispatched handler, or only this one when called directly.
+	 * @details The caller reserves the script environment and pushes the arguments, each handler gets
+	 * a copy of them. The result callback may replace argument slots, so the next handler receives
+	 * the values changed by the previous one.
+	 * @param nargs Number of arguments on top of the stack.
+	 * @param nresults Number of results of each handler.
+	 * @param onResult Called with the stack index of the first argument while the results are on top.
+	 * @return False if any handler raised an error.
+	 */
+	template <typename OnResult>
+	bool callHandlers(lua_State* L, int nargs, int nresults, OnResult &&onResult) const;
+
+	/**
+	 * @return True if every handler returned true.
+	 */
+	bool callHandlers(lua_State* L, int nargs) const;
+	void callVoidHandlers(lua_State* L, int nargs) const;
 };
@@ -30,25 +30,16 @@ EventsCallbacks &EventsCallbacks::getInstance() {
 
 void EventsCallbacks::addCallback(const std::shared_ptr<EventCallback> callback) {
 	m_callbacks.push_back(callback);
+	m_callbacksByType[static_cast<size_t>(callback->getType())].push_back(callback);
 }
 
 std::vector<std::shared_ptr<EventCallback>> EventsCallbacks::getCallbacks() const {
 	return m_callbacks;
 }
 
-std::vector<std::shared_ptr<EventCallback>> EventsCallbacks::getCallbacksByType(EventCallback_t type) const {
-	std::vector<std::shared_ptr<EventCallback>> eventCallbacks;
-	for (auto callback : getCallbacks()) {
-		if (callback->getType() != type) {
-			continue;
-		}
-
-		eventCallbacks.push_back(callback);
-	}
-
-	return eventCallbacks;
-}
-
 void EventsCallbacks::clear() {
 	m_callbacks.clear();
+	for (auto &callbacks : m_callbacksByType) {
+		callbacks.clear();
+	}
 }
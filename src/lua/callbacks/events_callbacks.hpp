@@ -62,7 +62,18 @@ public:
 	 * @param type The type of callbacks to retrieve.
 	 * @return Vector of pointers to EventCallback objects of the specified type.
 	 */
-	std::vector<std::shared_ptr<EventCallback>> getCallbacksByType(EventCallback_t type) const;
+	const std::vector<std::shared_ptr<EventCallback>> &getCallbacksByType(EventCallback_t type) const {
+		return m_callbacksByType[static_cast<size_t>(type)];
+	}
+
+	/**
+	 * @brief Checks if any callback is registered for the event type.
+	 * @param type The type of event to check.
+	 * @return True if at least one callback handles the event.
+	 */
+	bool hasCallbacks(EventCallback_t type) const {
+		return !getCallbacksByType(type).empty();
+	}
 
 	/**
 	 * @brief Clears all registered event callbacks.
@@ -71,23 +82,20 @@ public:
 
 	/**
 	 * @brief Executes the specified event callback.
+	 * @details An event without callbacks costs a single branch. Otherwise the callback function is
+	 * called once and runs every registered handler, sharing the script environment and arguments.
 	 * @param eventType The type of event to trigger.
 	 * @param callbackFunc Function pointer to the callback method.
 	 * @param args Variadic arguments to pass to the callback function.
 	 */
 	template <typename CallbackFunc, typename... Args>
 	void executeCallback(EventCallback_t eventType, CallbackFunc callbackFunc, Args &&... args) {
-		for (const auto &callback : getCallbacksByType(eventType)) {
-			auto argsCopy = std::make_tuple(args...);
-			if (callback && callback->isLoadedCallback()) {
-				std::apply(
-					[&callback, &callbackFunc](auto &&... args) {
-						((*callback).*callbackFunc)(std::forward<decltype(args)>(args)...);
-					},
-					argsCopy
-				);
-			}
+		const auto &callbacks = getCallbacksByType(eventType);
+		if (callbacks.empty()) [[likely]] {
+			return;
 		}
+
+		dispatch(callbacks, callbackFunc, args...);
 	}
 
 	/**
@@ -99,26 +107,51 @@ public:
 	 */
 	template <typename CallbackFunc, typename... Args>
 	bool checkCallback(EventCallback_t eventType, CallbackFunc callbackFunc, Args &&... args) {
-		bool allCallbacksSucceeded = true;
-
-		for (const auto &callback : getCallbacksByType(eventType)) {
-			auto argsCopy = std::make_tuple(args...);
-			if (callback && callback->isLoadedCallback()) {
-				bool callbackResult = std::apply(
-					[&callback, &callbackFunc](auto &&... args) {
-						return ((*callback).*callbackFunc)(std::forward<decltype(args)>(args)...);
-					},
-					argsCopy
-				);
-				allCallbacksSucceeded = allCallbacksSucceeded && callbackResult;
-			}
+		const auto &callbacks = getCallbacksByType(eventType);
+		if (callbacks.empty()) [[likely]] {
+			return true;
 		}
-		return allCallbacksSucceeded;
+
+		return dispatch(callbacks, callbackFunc, args...);
+	}
+
+	/**
+	 * @brief Checks the registered callbacks of an event that answers with a ReturnValue.
+	 * @param eventType The type of event to check.
+	 * @param callbackFunc Function pointer to the callback method.
+	 * @param args Variadic arguments to pass to the callback function.
+	 * @return RETURNVALUE_NOERROR if no callback refused, otherwise the first refusal.
+	 */
+	template <typename CallbackFunc, typename... Args>
+	ReturnValue checkCallbackWithReturnValue(EventCallback_t eventType, CallbackFunc callbackFunc, Args &&... args) {
+		const auto &callbacks = getCallbacksByType(eventType);
+		if (callbacks.empty()) [[likely]] {
+			return RETURNVALUE_NOERROR;
+		}
+
+		return dispatch(callbacks, callbackFunc, args...);
 	}
 
 private:
-	// Container for storing registered event callbacks.
+	template <typename CallbackFunc, typename... Args>
+	auto dispatch(const std::vector<std::shared_ptr<EventCallback>> &callbacks, CallbackFunc callbackFunc, Args &... args) {
+		// Kept alive in case a handler reloads the scripts
+		const auto callback = callbacks.front();
+		EventCallback::setDispatchHandlers(&callbacks);
+		if constexpr (std::is_void_v<decltype(((*callback).*callbackFunc)(args...))>) {
+			((*callback).*callbackFunc)(args...);
+			EventCallback::setDispatchHandlers(nullptr);
+		} else {
+			auto result = ((*callback).*callbackFunc)(args...);
+			EventCallback::setDispatchHandlers(nullptr);
+			return result;
+		}
+	}
+
+	// Registered event callbacks, in registration order.
 	std::vector<std::shared_ptr<EventCallback>> m_callbacks;
+	// Dispatch table, the registered callbacks of each event type.
+	std::array<std::vector<std::shared_ptr<EventCallback>>, magic_enum::enum_count<EventCallback_t>()> m_callbacksByType;
 };
 
 constexpr auto g_callbacks = EventsCallbacks::getInstance;
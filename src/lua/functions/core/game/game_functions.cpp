@@ -23,6 +23,7 @@
 #include "lua/creature/talkaction.hpp"
 #include "lua/functions/creatures/npc/npc_type_functions.hpp"
 #include "lua/scripts/lua_environment.hpp"
+#include "lua/scripts/lua_worker_pool.hpp"
 #include "lua/creature/events.hpp"
 #include "lua/callbacks/event_callback.hpp"
 #include "lua/callbacks/events_callbacks.hpp"
@@ -904,3 +905,55 @@ int GameFunctions::luaGameGetAchievements(lua_State* L) {
 	}
 	return 1;
 }
+
+int GameFunctions::luaGameCallPureFunction(lua_State* L) {
+	// Game.callPureFunction(functionName, callback, ...)
+	// Runs a function of the "scripts/pure" folders on a worker state, the callback receives its results
+	const std::string &functionName = getString(L, 1);
+	if (!isFunction(L, 2)) {
+		reportErrorFunc("callback parameter should be a function.");
+		pushBoolean(L, false);
+		return 1;
+	}
+
+	LuaWorkerValues args;
+	for (int index = 3, top = lua_gettop(L); index <= top; ++index) {
+		args.emplace_back(LuaWorkerPool::getValue(L, index));
+	}
+
+	lua_pushvalue(L, 2);
+	const int32_t callback = luaL_ref(L, LUA_REGISTRYINDEX);
+	const int32_t scriptId = getScriptEnv()->getScriptId();
+
+	g_luaWorkers().call(functionName, std::move(args), [callback, scriptId](std::optional<LuaWorkerValues> &&results) {
+		lua_State* luaState = g_luaEnvironment().getLuaState();
+		if (!luaState) {
+			return;
+		}
+
+		lua_rawgeti(luaState, LUA_REGISTRYINDEX, callback);
+		luaL_unref(luaState, LUA_REGISTRYINDEX, callback);
+
+		// A failed call gets no results, the error was already logged by the worker
+		int params = 0;
+		if (results) {
+			for (const auto &value : *results) {
+				LuaWorkerPool::pushValue(luaState, value);
+			}
+			params = static_cast<int>(results->size());
+		}
+
+		if (!reserveScriptEnv()) {
+			lua_pop(luaState, params + 1);
+			g_logger().error("[Game.callPureFunction] Call stack overflow. Too many lua script calls being nested");
+			return;
+		}
+
+		ScriptEnvironment* env = getScriptEnv();
+		env->setScriptId(scriptId, &g_luaEnvironment());
+		g_luaEnvironment().callVoidFunction(params);
+	});
+
+	pushBoolean(L, true);
+	return 1;
+}
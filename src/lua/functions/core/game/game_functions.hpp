@@ -88,6 +88,8 @@ public:
 		registerMethod(L, "Game", "getSecretAchievements", GameFunctions::luaGameGetSecretAchievements);
 		registerMethod(L, "Game", "getPublicAchievements", GameFunctions::luaGameGetPublicAchievements);
 		registerMethod(L, "Game", "getAchievements", GameFunctions::luaGameGetAchievements);
+
+		registerMethod(L, "Game", "callPureFunction", GameFunctions::luaGameCallPureFunction);
 	}
 
 private:
@@ -164,4 +166,6 @@ private:
 	static int luaGameGetSecretAchievements(lua_State* L);
 	static int luaGameGetPublicAchievements(lua_State* L);
 	static int luaGameGetAchievements(lua_State* L);
+
+	static int luaGameCallPureFunction(lua_State* L);
 };
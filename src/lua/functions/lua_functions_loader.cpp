@@ -224,7 +224,7 @@ void LuaFunctionsLoader::pushCylinder(lua_State* L, std::shared_ptr<Cylinder> cy
 		setItemMetatable(L, -1, parentItem);
 	} else if (std::shared_ptr<Tile> tile = cylinder->getTile()) {
 		pushUserdata<Tile>(L, tile);
-		setMetatable(L, -1, "Tile");
+		setMetatable<Tile>(L, -1);
 	} else if (cylinder == VirtualCylinder::virtualCylinder) {
 		pushBoolean(L, true);
 	} else {
@@ -311,33 +311,86 @@ void LuaFunctionsLoader::setWeakMetatable(lua_State* L, int32_t index, const std
 }
 
 void LuaFunctionsLoader::setItemMetatable(lua_State* L, int32_t index, std::shared_ptr<Item> item) {
-	if (validateDispatcherContext(__FUNCTION__)) {
-		return;
-	}
-
 	if (item && item->getContainer()) {
-		luaL_getmetatable(L, "Container");
+		setMetatable<Container>(L, index);
 	} else if (item && item->getTeleport()) {
-		luaL_getmetatable(L, "Teleport");
+		setMetatable<Teleport>(L, index);
 	} else {
-		luaL_getmetatable(L, "Item");
+		setMetatable<Item>(L, index);
 	}
-	lua_setmetatable(L, index - 1);
 }
 
 void LuaFunctionsLoader::setCreatureMetatable(lua_State* L, int32_t index, std::shared_ptr<Creature> creature) {
-	if (validateDispatcherContext(__FUNCTION__)) {
-		return;
-	}
-
 	if (creature && creature->getPlayer()) {
-		luaL_getmetatable(L, "Player");
+		setMetatable<Player>(L, index);
 	} else if (creature && creature->getMonster()) {
-		luaL_getmetatable(L, "Monster");
+		setMetatable<Monster>(L, index);
 	} else {
-		luaL_getmetatable(L, "Npc");
+		setMetatable<Npc>(L, index);
 	}
-	lua_setmetatable(L, index - 1);
+}
+
+void LuaFunctionsLoader::pushCachedMetatable(lua_State* L, int32_t typeId) {
+	void* registryKey = &metatableCacheKeys[typeId];
+	lua_pushlightuserdata(L, registryKey);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+	if (!lua_isnil(L, -1)) {
+		return;
+	}
+
+	lua_pop(L, 1);
+	luaL_getmetatable(L, cachedMetatableNames[typeId]);
+	// Only cache classes that are already registered
+	if (lua_istable(L, -1)) {
+		lua_pushlightuserdata(L, registryKey);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, LUA_REGISTRYINDEX);
+	}
+}
+
+bool LuaFunctionsLoader::pushInternedUserdata(lua_State* L, const void* key) {
+	lua_pushlightuserdata(L, &userdataCacheKey);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+	if (!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+		return false;
+	}
+
+	lua_pushlightuserdata(L, const_cast<void*>(key));
+	lua_rawget(L, -2);
+	// The userdata may have been repointed to another object by a script function (e.g. item transform).
+	// Its pointer must also be the most derived one, only then it reads the same as any base class pointer.
+	if (lua_type(L, -1) == LUA_TUSERDATA && getUserdata<const void>(L, -1) == key) {
+		lua_remove(L, -2);
+		return true;
+	}
+
+	lua_pop(L, 2);
+	return false;
+}
+
+void LuaFunctionsLoader::internUserdata(lua_State* L, const void* key) {
+	lua_pushlightuserdata(L, &userdataCacheKey);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+	if (!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+
+		// Weak values, an entry goes away together with its userdata
+		lua_newtable(L);
+		lua_createtable(L, 0, 1);
+		pushString(L, "v");
+		lua_setfield(L, -2, "__mode");
+		lua_setmetatable(L, -2);
+
+		lua_pushlightuserdata(L, &userdataCacheKey);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, LUA_REGISTRYINDEX);
+	}
+
+	lua_pushlightuserdata(L, const_cast<void*>(key));
+	lua_pushvalue(L, -3);
+	lua_rawset(L, -3);
+	lua_pop(L, 1);
 }
 
 CombatDamage LuaFunctionsLoader::getCombatDamage(lua_State* L) {
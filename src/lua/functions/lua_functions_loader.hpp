@@ -15,13 +15,18 @@
 #include "lua/scripts/script_environment.hpp"
 
 class Combat;
+class Container;
 class Creature;
 class Cylinder;
 class Game;
 class InstantSpell;
 class Item;
+class Monster;
+class Npc;
 class Player;
+class Teleport;
 class Thing;
+class Tile;
 class Guild;
 class Zone;
 class KV;
@@ -30,6 +35,36 @@ struct LuaVariant;
 
 #define reportErrorFunc(a) reportError(__FUNCTION__, a, true)
 
+template <typename... Types>
+struct LuaTypeList { };
+
+template <typename T, typename... Types>
+constexpr bool luaTypeListContains(LuaTypeList<Types...>) {
+	return (std::is_same_v<T, Types> || ...);
+}
+
+/**
+ * Classes whose metatable is looked up on almost every push, their position in
+ * this list is the id used to cache the metatable in the lua registry.
+ * Keep it in sync with LuaFunctionsLoader::cachedMetatableNames.
+ */
+using LuaCachedMetatables = LuaTypeList<Item, Container, Teleport, Player, Monster, Npc, Tile>;
+
+/**
+ * Shared classes whose userdata is reused while lua still references it,
+ * see LuaFunctionsLoader::pushUserdata.
+ */
+using LuaInternedUserdata = LuaTypeList<Creature, Player, Monster, Npc, Item, Container, Teleport>;
+
+template <typename T, typename List>
+struct LuaTypeIndex;
+
+template <typename T, typename... Types>
+struct LuaTypeIndex<T, LuaTypeList<T, Types...>> : std::integral_constant<int32_t, 0> { };
+
+template <typename T, typename Head, typename... Types>
+struct LuaTypeIndex<T, LuaTypeList<Head, Types...>> : std::integral_constant<int32_t, 1 + LuaTypeIndex<T, LuaTypeList<Types...>>::value> { };
+
 class LuaFunctionsLoader {
 public:
 	static void load(lua_State* L);
@@ -55,6 +90,20 @@ public:
 	}
 
 	static void setMetatable(lua_State* L, int32_t index, const std::string &name);
+	/**
+	 * Same as setMetatable(L, index, name), but the metatable reference is
+	 * cached in the registry, skipping the string lookup by class name.
+	 */
+	template <class T>
+	static void setMetatable(lua_State* L, int32_t index) {
+		static_assert(luaTypeListContains<T>(LuaCachedMetatables {}), "metatable of this class is not cached");
+		if (validateDispatcherContext(__FUNCTION__)) {
+			return;
+		}
+
+		pushCachedMetatable(L, LuaTypeIndex<T, LuaCachedMetatables>::value);
+		lua_setmetatable(L, index - 1);
+	}
 	static void setWeakMetatable(lua_State* L, int32_t index, const std::string &name);
 	static void setItemMetatable(lua_State* L, int32_t index, std::shared_ptr<Item> item);
 	static void setCreatureMetatable(lua_State* L, int32_t index, std::shared_ptr<Creature> creature);
@@ -220,12 +269,33 @@ public:
 		return static_cast<std::shared_ptr<T>*>(lua_touserdata(L, arg));
 	}
 
+	/**
+	 * Creatures and items are interned: while the lua side still holds the
+	 * userdata of an object, pushing the same object again reuses it instead
+	 * of allocating a new one and bumping the reference count again.
+	 * The caller still sets the metatable afterwards, which is a no-op cost
+	 * for a reused userdata.
+	 */
 	template <class T>
 	static void pushUserdata(lua_State* L, std::shared_ptr<T> value) {
+		// Keyed by the most derived object, so pushing it as Creature or as Player finds the same entry
+		const void* internKey = nullptr;
+		if constexpr (luaTypeListContains<T>(LuaInternedUserdata {})) {
+			internKey = dynamic_cast<const void*>(value.get());
+		}
+
+		if (internKey && pushInternedUserdata(L, internKey)) {
+			return;
+		}
+
 		// This is basically malloc from C++ point of view.
 		auto userData = static_cast<std::shared_ptr<T>*>(lua_newuserdata(L, sizeof(std::shared_ptr<T>)));
 		// Copy constructor, bumps ref count.
 		new (userData) std::shared_ptr<T>(value);
+
+		if (internKey) {
+			internUserdata(L, internKey);
+		}
 	}
 
 protected:
@@ -247,4 +317,15 @@ protected:
 	static ScriptEnvironment scriptEnv[16];
 	static int32_t scriptEnvIndex;
 	static int validateDispatcherContext(std::string_view fncName);
+
+private:
+	static constexpr std::array<const char*, 7> cachedMetatableNames = { "Item", "Container", "Teleport", "Player", "Monster", "Npc", "Tile" };
+
+	// Registry keys, as light userdata their addresses never collide with the integer keys of luaL_ref
+	static inline char userdataCacheKey = 0;
+	static inline std::array<char, cachedMetatableNames.size()> metatableCacheKeys {};
+
+	static void pushCachedMetatable(lua_State* L, int32_t typeId);
+	static bool pushInternedUserdata(lua_State* L, const void* key);
+	static void internUserdata(lua_State* L, const void* key);
 };
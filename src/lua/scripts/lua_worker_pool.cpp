@@ -0,0 +1,276 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "lua/scripts/lua_worker_pool.hpp"
+
+#include "game/scheduling/dispatcher.hpp"
+#include "lib/di/container.hpp"
+#include "lib/thread/thread_pool.hpp"
+
+LuaWorkerPool::LuaWorkerPool(ThreadPool &threadPool) :
+	// Same indexing as the dispatcher thread tasks
+	workers(threadPool.getNumberOfThreads() + 1) { }
+
+LuaWorkerPool::~LuaWorkerPool() {
+	for (auto &worker : workers) {
+		if (worker.L) {
+			lua_close(worker.L);
+		}
+	}
+}
+
+LuaWorkerPool &LuaWorkerPool::getInstance() {
+	return inject<LuaWorkerPool>();
+}
+
+void LuaWorkerPool::load(std::vector<std::string> newFolders) {
+	{
+		std::scoped_lock lock(foldersMutex);
+		folders = std::move(newFolders);
+	}
+	reload();
+}
+
+void LuaWorkerPool::reload() {
+	generation.fetch_add(1, std::memory_order_release);
+}
+
+void LuaWorkerPool::call(const std::string &functionName, LuaWorkerValues &&args, std::function<void(std::optional<LuaWorkerValues> &&)> &&callback) {
+	g_dispatcher().asyncEvent([this, functionName, args = std::move(args), callback = std::move(callback)]() mutable {
+		auto results = run(functionName, args);
+		g_dispatcher().addEvent([callback = std::move(callback), results = std::move(results)]() mutable { callback(std::move(results)); }, "LuaWorkerPool::call");
+	});
+}
+
+void LuaWorkerPool::callMany(const std::string &functionName, std::vector<LuaWorkerValues> &&args, std::function<void(std::vector<std::optional<LuaWorkerValues>> &&)> &&callback) {
+	struct Batch {
+		std::vector<std::optional<LuaWorkerValues>> results;
+		std::atomic_size_t remaining;
+		std::function<void(std::vector<std::optional<LuaWorkerValues>> &&)> callback;
+	};
+
+	if (args.empty()) {
+		g_dispatcher().addEvent([callback = std::move(callback)] { callback({}); }, "LuaWorkerPool::callMany");
+		return;
+	}
+
+	const auto batch = std::make_shared<Batch>();
+	batch->results.resize(args.size());
+	batch->remaining = args.size();
+	batch->callback = std::move(callback);
+
+	for (size_t i = 0; i < args.size(); ++i) {
+		g_dispatcher().asyncEvent([this, batch, functionName, i, args = std::move(args[i])] {
+			batch->results[i] = run(functionName, args);
+			// The last one to finish merges the results back
+			if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				g_dispatcher().addEvent([batch] { batch->callback(std::move(batch->results)); }, "LuaWorkerPool::callMany");
+			}
+		});
+	}
+}
+
+std::optional<LuaWorkerValues> LuaWorkerPool::run(const std::string &functionName, const LuaWorkerValues &args) {
+	lua_State* L = getState();
+	if (!L) {
+		g_logger().error("[{}] No worker state for thread {}", __FUNCTION__, ThreadPool::getThreadId());
+		return std::nullopt;
+	}
+
+	const int top = lua_gettop(L);
+	lua_getglobal(L, functionName.c_str());
+	if (!lua_isfunction(L, -1)) {
+		g_logger().error("[{}] Pure function {} not found", __FUNCTION__, functionName);
+		lua_settop(L, top);
+		return std::nullopt;
+	}
+
+	for (const auto &arg : args) {
+		pushValue(L, arg);
+	}
+
+	if (lua_pcall(L, static_cast<int>(args.size()), LUA_MULTRET, 0) != 0) {
+		g_logger().error("[{}] Pure function {} failed: {}", __FUNCTION__, functionName, lua_tostring(L, -1));
+		lua_settop(L, top);
+		return std::nullopt;
+	}
+
+	LuaWorkerValues results;
+	results.reserve(lua_gettop(L) - top);
+	for (int index = top + 1; index <= lua_gettop(L); ++index) {
+		results.emplace_back(getValue(L, index));
+	}
+	lua_settop(L, top);
+	return results;
+}
+
+lua_State* LuaWorkerPool::getState() {
+	const auto threadId = ThreadPool::getThreadId();
+	if (threadId < 0 || static_cast<size_t>(threadId) >= workers.size()) {
+		return nullptr;
+	}
+
+	auto &worker = workers[threadId];
+	const auto currentGeneration = generation.load(std::memory_order_acquire);
+	if (worker.L && worker.generation == currentGeneration) {
+		return worker.L;
+	}
+
+	if (worker.L) {
+		lua_close(worker.L);
+	}
+
+	worker.L = luaL_newstate();
+	worker.generation = currentGeneration;
+	if (worker.L) {
+		luaL_openlibs(worker.L);
+		loadState(worker.L);
+	}
+	return worker.L;
+}
+
+void LuaWorkerPool::loadState(lua_State* L) {
+	std::vector<std::string> loadFolders;
+	{
+		std::scoped_lock lock(foldersMutex);
+		loadFolders = folders;
+	}
+
+	for (const auto &folder : loadFolders) {
+		const auto dir = std::filesystem::current_path() / folder;
+		if (!std::filesystem::is_directory(dir)) {
+			continue;
+		}
+
+		for (const auto &entry : std::filesystem::recursive_directory_iterator(dir)) {
+			const auto &path = entry.path();
+			// Same rules as Scripts::loadScripts, files starting with "#" are disabled
+			if (!entry.is_regular_file() || path.extension() != ".lua" || path.filename().string().front() == '#') {
+				continue;
+			}
+
+			if (luaL_dofile(L, path.string().c_str()) != 0) {
+				g_logger().error("[{}] {}", __FUNCTION__, lua_tostring(L, -1));
+				lua_pop(L, 1);
+			}
+		}
+	}
+}
+
+void LuaWorkerPool::pushValue(lua_State* L, const std::optional<ValueWrapper> &value) {
+	if (!value) {
+		lua_pushnil(L);
+		return;
+	}
+
+	std::visit(
+		[L](const auto &arg) {
+			using T = std::decay_t<decltype(arg)>;
+			if constexpr (std::is_same_v<T, StringType>) {
+				lua_pushlstring(L, arg.c_str(), arg.size());
+			} else if constexpr (std::is_same_v<T, BooleanType>) {
+				lua_pushboolean(L, arg);
+			} else if constexpr (std::is_same_v<T, IntType> || std::is_same_v<T, DoubleType>) {
+				lua_pushnumber(L, arg);
+			} else if constexpr (std::is_same_v<T, ArrayType>) {
+				lua_createtable(L, static_cast<int>(arg.size()), 0);
+				for (size_t i = 0; i < arg.size(); ++i) {
+					pushValue(L, arg[i]);
+					lua_rawseti(L, -2, static_cast<int>(i + 1));
+				}
+			} else if constexpr (std::is_same_v<T, MapType>) {
+				lua_createtable(L, 0, static_cast<int>(arg.size()));
+				for (const auto &[key, mapValue] : arg) {
+					pushValue(L, mapValue ? std::optional<ValueWrapper>(*mapValue) : std::nullopt);
+					lua_setfield(L, -2, key.c_str());
+				}
+			}
+		},
+		value->getVariant()
+	);
+}
+
+std::optional<ValueWrapper> LuaWorkerPool::getValue(lua_State* L, int index) {
+	std::vector<const void*> tables;
+	return getValue(L, index, tables);
+}
+
+std::optional<ValueWrapper> LuaWorkerPool::getValue(lua_State* L, int index, std::vector<const void*> &tables) {
+	switch (lua_type(L, index)) {
+		case LUA_TBOOLEAN:
+			return ValueWrapper(lua_toboolean(L, index) != 0);
+		case LUA_TNUMBER:
+			return ValueWrapper(static_cast<double>(lua_tonumber(L, index)));
+		case LUA_TSTRING: {
+			size_t length;
+			const char* string = lua_tolstring(L, index, &length);
+			return ValueWrapper(std::string(string, length));
+		}
+		case LUA_TTABLE:
+			break;
+		default:
+			return std::nullopt;
+	}
+
+	if (index < 0) {
+		index = lua_gettop(L) + index + 1;
+	}
+
+	// Tables being converted are the ones above this one, finding it there means it contains itself
+	const void* table = lua_topointer(L, index);
+	if (std::ranges::find(tables, table) != tables.end()) {
+		g_logger().warn("[{}] Table contains itself, converted as nil", __FUNCTION__);
+		return std::nullopt;
+	}
+	if (tables.size() >= MAX_TABLE_DEPTH || !lua_checkstack(L, 3)) {
+		g_logger().warn("[{}] Table nested deeper than {} levels, converted as nil", __FUNCTION__, MAX_TABLE_DEPTH);
+		return std::nullopt;
+	}
+
+	tables.push_back(table);
+
+	size_t entries = 0;
+	lua_pushnil(L);
+	while (lua_next(L, index) != 0) {
+		++entries;
+		lua_pop(L, 1);
+	}
+
+	// Only a plain sequence is an array, any other key would be lost
+	std::optional<ValueWrapper> value;
+	if (const auto length = lua_objlen(L, index); length > 0 && length == entries) {
+		ArrayType array;
+		array.reserve(length);
+		for (size_t i = 1; i <= length; ++i) {
+			lua_rawgeti(L, index, static_cast<int>(i));
+			auto element = getValue(L, -1, tables);
+			array.emplace_back(element ? std::move(*element) : ValueWrapper());
+			lua_pop(L, 1);
+		}
+		value = ValueWrapper(array);
+	} else {
+		MapType map;
+		lua_pushnil(L);
+		while (lua_next(L, index) != 0) {
+			// Converted on a copy, lua_tolstring on the key itself would break lua_next
+			lua_pushvalue(L, -2);
+			const char* key = lua_tostring(L, -1);
+			if (auto element = getValue(L, -2, tables); key && element) {
+				map[key] = std::make_shared<ValueWrapper>(std::move(*element));
+			}
+			lua_pop(L, 2);
+		}
+		value = ValueWrapper(map);
+	}
+
+	tables.pop_back();
+	return value;
+}
@@ -0,0 +1,92 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "kv/value_wrapper.hpp"
+
+class ThreadPool;
+struct lua_State;
+
+// Arguments and results of a worker call, std::nullopt is nil
+using LuaWorkerValues = std::vector<std::optional<ValueWrapper>>;
+
+/**
+ * Pool of lua states for pure functions, such as loot rolls, damage formulas or
+ * think decisions, so they can run outside of the single main lua state.
+ *
+ * Every thread of the dispatcher parallel group owns a state, loaded on its first
+ * call from the "scripts/pure" folders of the core and of the datapack. These
+ * folders are also loaded by the main state, so a function is callable from both.
+ * Worker states only have the standard lua libraries: a pure function receives and
+ * returns plain data (ValueWrapper) and must not keep state between calls.
+ */
+class LuaWorkerPool {
+public:
+	explicit LuaWorkerPool(ThreadPool &threadPool);
+	~LuaWorkerPool();
+
+	// Ensures that we don't accidentally copy it
+	LuaWorkerPool(const LuaWorkerPool &) = delete;
+	LuaWorkerPool &operator=(const LuaWorkerPool &) = delete;
+
+	static LuaWorkerPool &getInstance();
+
+	/**
+	 * Sets the script folders, folders that don't exist are ignored.
+	 * The worker states are loaded again on their next call.
+	 */
+	void load(std::vector<std::string> newFolders);
+	void reload();
+
+	/**
+	 * Runs a function on a worker state.
+	 * The callback receives the results on the serial dispatcher group, std::nullopt if the call failed.
+	 */
+	void call(const std::string &functionName, LuaWorkerValues &&args, std::function<void(std::optional<LuaWorkerValues> &&)> &&callback);
+
+	/**
+	 * Runs a function once per argument list, spread over the parallel group.
+	 * The callback receives every result, in the order of the argument lists, on the serial dispatcher group.
+	 */
+	void callMany(const std::string &functionName, std::vector<LuaWorkerValues> &&args, std::function<void(std::vector<std::optional<LuaWorkerValues>> &&)> &&callback);
+
+	/**
+	 * Runs a function on the worker state of the calling thread.
+	 * @note Only for tasks of the parallel group, each state belongs to one thread.
+	 */
+	std::optional<LuaWorkerValues> run(const std::string &functionName, const LuaWorkerValues &args);
+
+	// Plain data conversions, they only use the raw lua api so they are safe on any state.
+	// A table with keys other than a sequence becomes a map, keyed by the keys as strings.
+	static void pushValue(lua_State* L, const std::optional<ValueWrapper> &value);
+	static std::optional<ValueWrapper> getValue(lua_State* L, int index);
+
+private:
+	// Deeper tables and tables that contain themselves are converted as nil
+	static constexpr size_t MAX_TABLE_DEPTH = 32;
+
+	struct Worker {
+		lua_State* L = nullptr;
+		uint32_t generation = 0;
+	};
+
+	static std::optional<ValueWrapper> getValue(lua_State* L, int index, std::vector<const void*> &tables);
+
+	lua_State* getState();
+	void loadState(lua_State* L);
+
+	std::vector<Worker> workers;
+
+	std::mutex foldersMutex;
+	std::vector<std::string> folders;
+	std::atomic_uint32_t generation = 1;
+};
+
+constexpr auto g_luaWorkers = LuaWorkerPool::getInstance;
@@ -64,6 +64,7 @@ public:
 	void callVoidFunction(int params);
 
 	std::string getStackTrace(const std::string &error_desc);
+	std::string getMetricsScope();
 
 protected:
 	virtual bool closeState();
@@ -73,7 +74,6 @@ protected:
 	std::map<int32_t, std::string> cacheFiles;
 
 private:
-	std::string getMetricsScope();
 
 	std::string lastLuaError;
 	std::string interfaceName;
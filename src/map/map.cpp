@@ -54,6 +54,9 @@ void Map::loadMap(const std::string &identifier, bool mainMap /*= false*/, bool
 		}
 	}
 
+	// Every tile, item and house loaded below changes the walkability, the path clusters are dropped once at the end
+	HPAStar::InvalidationSuspension suspension(hpaStar);
+
 	// Load the map
 	load(identifier, pos);
 
@@ -100,6 +103,8 @@ void Map::loadMap(const std::string &identifier, bool mainMap /*= false*/, bool
 }
 
 void Map::loadMapCustom(const std::string &mapName, bool loadHouses, bool loadMonsters, bool loadNpcs, bool loadZones, int customMapIndex) {
+	HPAStar::InvalidationSuspension suspension(hpaStar);
+
 	// Load the map
 	load(g_configManager().getString(DATA_DIRECTORY, __FUNCTION__) + "/world/custom/" + mapName + ".otbm");
 
@@ -126,6 +131,7 @@ void Map::loadMapCustom(const std::string &mapName, bool loadHouses, bool loadMo
 }
 
 void Map::loadHouseInfo() {
+	HPAStar::InvalidationSuspension suspension(hpaStar);
 	IOMapSerialize::loadHouseInfo();
 	IOMapSerialize::loadHouseItems(this);
 }
@@ -215,11 +221,51 @@ void Map::setTile(uint16_t x, uint16_t y, uint8_t z, std::shared_ptr<Tile> newTi
 		return;
 	}
 
-	if (const auto leaf = getQTNode(x, y)) {
-		leaf->createFloor(z)->setTile(x, y, newTile);
+	auto leaf = getQTNode(x, y);
+	if (!leaf) {
+		leaf = root.getBestLeaf(x, y, 15);
+	}
+
+	const auto &floor = leaf->createFloor(z);
+	{
+		std::scoped_lock l(floor->getMutex());
+		retireTile(floor->setTile(x, y, std::move(newTile)));
+	}
+	hpaStar.invalidate(Position(x, y, z));
+}
+
+bool Map::hasPlayersAround(const Position &pos) const {
+	uint8_t minZ = pos.z;
+	uint8_t maxZ = pos.z;
+	if (pos.z > MAP_INIT_SURFACE_LAYER) {
+		minZ = static_cast<uint8_t>(std::max<int32_t>(pos.z - MAP_LAYER_VIEW_LIMIT, 0));
+		maxZ = static_cast<uint8_t>(std::min<int32_t>(pos.z + MAP_LAYER_VIEW_LIMIT, MAP_MAX_LAYERS - 1));
+	} else if (pos.z == MAP_INIT_SURFACE_LAYER - 1) {
+		minZ = 0;
+		maxZ = (MAP_INIT_SURFACE_LAYER - 1) + MAP_LAYER_VIEW_LIMIT;
+	} else if (pos.z == MAP_INIT_SURFACE_LAYER) {
+		minZ = 0;
+		maxZ = MAP_INIT_SURFACE_LAYER + MAP_LAYER_VIEW_LIMIT;
 	} else {
-		root.getBestLeaf(x, y, 15)->createFloor(z)->setTile(x, y, newTile);
+		minZ = 0;
+		maxZ = MAP_INIT_SURFACE_LAYER;
 	}
+
+	// Same area as Spectators::collect, players on other floors are seen shifted by the floor difference
+	const int32_t x1 = std::clamp<int32_t>(pos.x - MAP_MAX_VIEW_PORT_X + (pos.z - maxZ), 0, 0xFFFF);
+	const int32_t y1 = std::clamp<int32_t>(pos.y - MAP_MAX_VIEW_PORT_Y + (pos.z - maxZ), 0, 0xFFFF);
+	const int32_t x2 = std::clamp<int32_t>(pos.x + MAP_MAX_VIEW_PORT_X + (pos.z - minZ), 0, 0xFFFF);
+	const int32_t y2 = std::clamp<int32_t>(pos.y + MAP_MAX_VIEW_PORT_Y + (pos.z - minZ), 0, 0xFFFF);
+
+	for (int32_t ny = y1 & ~FLOOR_MASK; ny <= y2; ny += FLOOR_SIZE) {
+		for (int32_t nx = x1 & ~FLOOR_MASK; nx <= x2; nx += FLOOR_SIZE) {
+			const auto leaf = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, nx, ny);
+			if (leaf && leaf->player_list.hasOnFloors(minZ, maxZ)) {
+				return true;
+			}
+		}
+	}
+	return false;
 }
 
 bool Map::placeCreature(const Position &centerPos, std::shared_ptr<Creature> creature, bool extendedPos /* = false*/, bool forceLogin /* = false*/) {
@@ -315,7 +361,7 @@ bool Map::placeCreature(const Position &centerPos, std::shared_ptr<Creature> cre
 	toCylinder->internalAddThing(creature);
 
 	const Position &dest = toCylinder->getPosition();
-	getQTNode(dest.x, dest.y)->addCreature(creature);
+	getQTNode(dest.x, dest.y)->addCreature(creature, dest);
 	return true;
 }
 
@@ -357,7 +403,9 @@ void Map::moveCreature(const std::shared_ptr<Creature> &creature, const std::sha
 	// Switch the node ownership
 	if (leaf != new_leaf) {
 		leaf->removeCreature(creature);
-		new_leaf->addCreature(creature);
+		new_leaf->addCreature(creature, newPos);
+	} else {
+		leaf->updateCreature(creature, newPos);
 	}
 
 	// add the creature
@@ -515,6 +563,17 @@ bool Map::getPathMatching(const std::shared_ptr<Creature> &creature, stdext::arr
 }
 
 bool Map::getPathMatching(const std::shared_ptr<Creature> &creature, const Position &startPos, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp) {
+	// Long chases go through the cluster graph, the plain A* would run out of nodes before reaching the target
+	if (fpp.fullPathSearch && g_configManager().getBoolean(TOGGLE_HIERARCHICAL_PATHFINDING, __FUNCTION__) && HPAStar::isLongDistance(startPos, pathCondition.getTargetPos())) {
+		if (hpaStar.getPathMatching(*this, creature, startPos, dirList, pathCondition, fpp)) {
+			return true;
+		}
+	}
+
+	return getPathMatchingAStar(creature, startPos, dirList, pathCondition, fpp);
+}
+
+bool Map::getPathMatchingAStar(const std::shared_ptr<Creature> &creature, const Position &startPos, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp) {
 	static int_fast32_t allNeighbors[8][2] = {
 		{ -1, 0 }, { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 }
 	};
@@ -11,6 +11,7 @@
 
 #include "mapcache.hpp"
 #include "map/town.hpp"
+#include "map/utils/hpastar.hpp"
 #include "map/house/house.hpp"
 #include "creatures/monsters/spawns/spawn_monster.hpp"
 #include "creatures/npcs/spawns/spawn_npc.hpp"
@@ -123,12 +124,25 @@ public:
 
 	std::shared_ptr<Tile> canWalkTo(const std::shared_ptr<Creature> &creature, const Position &pos);
 
+	/**
+	 * Checks the player counters of the leaves around a position.
+	 * Whole leaves are counted, so this may find players slightly out of view but never misses one in view.
+	 *	\param pos Center point, scanned with the multifloor range of the spectators
+	 *	\returns Whether a player may see the position
+	 */
+	bool hasPlayersAround(const Position &pos) const;
+
 	bool getPathMatching(const std::shared_ptr<Creature> &creature, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp);
 
 	bool getPathMatching(const Position &startPos, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp) {
 		return getPathMatching(nullptr, startPos, dirList, pathCondition, fpp);
 	}
 
+	// Drops the pathfinding clusters built with the old walkability of this position.
+	void invalidatePathClusters(const Position &pos) {
+		hpaStar.invalidate(pos);
+	}
+
 	std::map<std::string, Position> waypoints;
 
 	QTreeLeafNode* getQTNode(uint16_t x, uint16_t y) {
@@ -148,6 +162,7 @@ public:
 
 private:
 	bool getPathMatching(const std::shared_ptr<Creature> &creature, const Position &startPos, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp);
+	bool getPathMatchingAStar(const std::shared_ptr<Creature> &creature, const Position &startPos, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp);
 
 	/**
 	 * Set a single tile.
@@ -167,7 +182,10 @@ private:
 	uint32_t width = 0;
 	uint32_t height = 0;
 
+	HPAStar hpaStar;
+
 	friend class Game;
+	friend class HPAStar;
 	friend class IOMap;
 	friend class MapCache;
 };
@@ -16,6 +16,7 @@
 #include "io/iologindata.hpp"
 #include "items/item.hpp"
 #include "game/game.hpp"
+#include "game/scheduling/dispatcher.hpp"
 #include "game/zones/zone.hpp"
 #include "map/map.hpp"
 #include "utils/hash.hpp"
@@ -101,14 +102,24 @@ std::shared_ptr<Item> MapCache::createItem(const std::shared_ptr<BasicItem> &Bas
 	return item;
 }
 
+std::shared_ptr<Tile> Floor::getTile(uint16_t x, uint16_t y) const {
+	const auto tile = getTileRef(x, y);
+	return tile ? tile->static_self_cast<Tile>() : nullptr;
+}
+
 std::shared_ptr<Tile> MapCache::getOrCreateTileFromCache(const std::unique_ptr<Floor> &floor, uint16_t x, uint16_t y) {
+	if (!floor->hasTileCache(x, y)) {
+		return floor->getTile(x, y);
+	}
+
+	std::scoped_lock l(floor->getMutex());
+
+	// Another thread may have created it while we were waiting for the lock
 	const auto cachedTile = floor->getTileCache(x, y);
 	if (!cachedTile) {
 		return floor->getTile(x, y);
 	}
 
-	std::unique_lock l(floor->getMutex());
-
 	const uint8_t z = floor->getZ();
 
 	auto map = static_cast<Map*>(this);
@@ -139,7 +150,7 @@ std::shared_ptr<Tile> MapCache::getOrCreateTileFromCache(const std::unique_ptr<F
 		tile->addZone(zone);
 	}
 
-	floor->setTile(x, y, tile);
+	retireTile(floor->setTile(x, y, tile));
 
 	// Remove Tile from cache
 	floor->setTileCache(x, y, nullptr);
@@ -147,6 +158,21 @@ std::shared_ptr<Tile> MapCache::getOrCreateTileFromCache(const std::unique_ptr<F
 	return tile;
 }
 
+void MapCache::retireTile(std::shared_ptr<Tile> tile) {
+	if (!tile) {
+		return;
+	}
+
+	// Readers of the tile may run until the end of the current loop iteration, parallel tasks included
+	const auto loop = g_dispatcher().getLoopCount();
+
+	std::scoped_lock l(retiredTilesMutex);
+	std::erase_if(retiredTiles, [loop](const auto &retired) {
+		return retired.first + 1 < loop;
+	});
+	retiredTiles.emplace_back(loop, std::move(tile));
+}
+
 void MapCache::setBasicTile(uint16_t x, uint16_t y, uint8_t z, const std::shared_ptr<BasicTile> &newTile) {
 	if (z >= MAP_MAX_LAYERS) {
 		g_logger().error("Attempt to set tile on invalid coordinate: {}", Position(x, y, z).toString());
@@ -154,11 +180,14 @@ void MapCache::setBasicTile(uint16_t x, uint16_t y, uint8_t z, const std::shared
 	}
 
 	const auto tile = static_tryGetTileFromCache(newTile);
-	if (const auto leaf = QTreeNode::getLeafStatic<QTreeLeafNode*, QTreeNode*>(&root, x, y)) {
-		leaf->createFloor(z)->setTileCache(x, y, tile);
-	} else {
-		root.getBestLeaf(x, y, 15)->createFloor(z)->setTileCache(x, y, tile);
+	auto leaf = QTreeNode::getLeafStatic<QTreeLeafNode*, QTreeNode*>(&root, x, y);
+	if (!leaf) {
+		leaf = root.getBestLeaf(x, y, 15);
 	}
+
+	const auto &floor = leaf->createFloor(z);
+	std::scoped_lock l(floor->getMutex());
+	floor->setTileCache(x, y, tile);
 }
 
 std::shared_ptr<BasicItem> MapCache::tryReplaceItemFromCache(const std::shared_ptr<BasicItem> &ref) {
@@ -79,26 +79,48 @@ private:
 
 #pragma pack()
 
+/**
+ * Tiles of a FLOOR_SIZE x FLOOR_SIZE area of a single layer.
+ *
+ * Tile pointers are published atomically and read without any lock, so the
+ * pathfinding and spectator scans never contend with each other. A raw tile
+ * reference from getTileRef() stays valid until the end of the dispatcher loop
+ * iteration it was taken in, parallel tasks included: replaced tiles are retired
+ * by MapCache instead of being released. Thread pool loads running outside the
+ * dispatcher must not keep raw references.
+ *
+ * Writers (setTile and setTileCache) must hold getMutex().
+ */
 struct Floor {
 	explicit Floor(uint8_t z) :
 		z(z) { }
 
-	std::shared_ptr<Tile> getTile(uint16_t x, uint16_t y) const {
-		std::shared_lock sl(mutex);
-		return tiles[x & FLOOR_MASK][y & FLOOR_MASK].first;
+	Tile* getTileRef(uint16_t x, uint16_t y) const {
+		return cells[x & FLOOR_MASK][y & FLOOR_MASK].tile.load(std::memory_order_acquire);
+	}
+
+	std::shared_ptr<Tile> getTile(uint16_t x, uint16_t y) const;
+
+	// Returns the replaced tile, which must be retired by the caller.
+	[[nodiscard]] std::shared_ptr<Tile> setTile(uint16_t x, uint16_t y, std::shared_ptr<Tile> tile) {
+		auto &owner = tileOwners[x & FLOOR_MASK][y & FLOOR_MASK];
+		std::swap(owner, tile);
+		cells[x & FLOOR_MASK][y & FLOOR_MASK].tile.store(owner.get(), std::memory_order_release);
+		return tile;
 	}
 
-	void setTile(uint16_t x, uint16_t y, std::shared_ptr<Tile> tile) {
-		tiles[x & FLOOR_MASK][y & FLOOR_MASK].first = tile;
+	bool hasTileCache(uint16_t x, uint16_t y) const {
+		return cells[x & FLOOR_MASK][y & FLOOR_MASK].hasCache.load(std::memory_order_acquire);
 	}
 
-	std::shared_ptr<BasicTile> getTileCache(uint16_t x, uint16_t y) const {
-		std::shared_lock sl(mutex);
-		return tiles[x & FLOOR_MASK][y & FLOOR_MASK].second;
+	// Must be called with getMutex() held.
+	const std::shared_ptr<BasicTile> &getTileCache(uint16_t x, uint16_t y) const {
+		return cacheOwners[x & FLOOR_MASK][y & FLOOR_MASK];
 	}
 
 	void setTileCache(uint16_t x, uint16_t y, const std::shared_ptr<BasicTile> &newTile) {
-		tiles[x & FLOOR_MASK][y & FLOOR_MASK].second = newTile;
+		cacheOwners[x & FLOOR_MASK][y & FLOOR_MASK] = newTile;
+		cells[x & FLOOR_MASK][y & FLOOR_MASK].hasCache.store(newTile != nullptr, std::memory_order_release);
 	}
 
 	uint8_t getZ() const {
@@ -110,8 +132,18 @@ struct Floor {
 	}
 
 private:
-	std::pair<std::shared_ptr<Tile>, std::shared_ptr<BasicTile>> tiles[FLOOR_SIZE][FLOOR_SIZE] = {};
-	mutable std::shared_mutex mutex;
+	// Read side, kept apart from the owners so a scan only touches these.
+	struct Cell {
+		std::atomic<Tile*> tile = nullptr;
+		std::atomic_bool hasCache = false;
+	};
+
+	Cell cells[FLOOR_SIZE][FLOOR_SIZE];
+
+	std::shared_ptr<Tile> tileOwners[FLOOR_SIZE][FLOOR_SIZE] = {};
+	std::shared_ptr<BasicTile> cacheOwners[FLOOR_SIZE][FLOOR_SIZE] = {};
+
+	mutable std::mutex mutex;
 	uint8_t z { 0 };
 };
 
@@ -128,9 +160,15 @@ public:
 protected:
 	std::shared_ptr<Tile> getOrCreateTileFromCache(const std::unique_ptr<Floor> &floor, uint16_t x, uint16_t y);
 
+	// Keeps a replaced tile alive until the dispatcher loop iterations that could read it are over.
+	void retireTile(std::shared_ptr<Tile> tile);
+
 	QTreeNode root;
 
 private:
+	std::mutex retiredTilesMutex;
+	std::vector<std::pair<uint64_t, std::shared_ptr<Tile>>> retiredTiles;
+
 	void parseItemAttr(const std::shared_ptr<BasicItem> &BasicItem, std::shared_ptr<Item> item);
 	std::shared_ptr<Item> createItem(const std::shared_ptr<BasicItem> &BasicItem, Position position);
 };
@@ -11,11 +11,26 @@
 
 #include "spectators.hpp"
 #include "game/game.hpp"
+#include "game/scheduling/dispatcher.hpp"
 
 phmap::flat_hash_map<Position, SpectatorsCache> Spectators::spectatorsCache;
+phmap::flat_hash_map<Spectators::ViewKey, const SpectatorList*, Spectators::ViewKeyHash> Spectators::views;
+std::vector<std::unique_ptr<SpectatorList>> Spectators::viewLists;
+size_t Spectators::usedViewLists = 0;
+uint64_t Spectators::viewsLoop = 0;
 
 void Spectators::clearCache() {
 	spectatorsCache.clear();
+	// The lists stay alive, as views of this loop iteration may still be iterated.
+	views.clear();
+}
+
+size_t Spectators::ViewKeyHash::operator()(const ViewKey &key) const {
+	size_t hash = std::hash<Position>()(key.centerPos);
+	for (const int32_t value : { key.minRangeX, key.maxRangeX, key.minRangeY, key.maxRangeY, static_cast<int32_t>(key.multifloor << 1 | key.onlyPlayers) }) {
+		hash ^= std::hash<int32_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	}
+	return hash;
 }
 
 bool Spectators::contains(const std::shared_ptr<Creature> &creature) {
@@ -98,12 +113,15 @@ bool Spectators::checkCache(const SpectatorsCache::FloorData &specData, bool onl
 	return true;
 }
 
-Spectators Spectators::find(const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY) {
+void Spectators::normalizeRange(int32_t &minRangeX, int32_t &maxRangeX, int32_t &minRangeY, int32_t &maxRangeY) {
 	minRangeX = (minRangeX == 0 ? -MAP_MAX_VIEW_PORT_X : -minRangeX);
 	maxRangeX = (maxRangeX == 0 ? MAP_MAX_VIEW_PORT_X : maxRangeX);
 	minRangeY = (minRangeY == 0 ? -MAP_MAX_VIEW_PORT_Y : -minRangeY);
 	maxRangeY = (maxRangeY == 0 ? MAP_MAX_VIEW_PORT_Y : maxRangeY);
+}
 
+Spectators Spectators::find(const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY) {
+	normalizeRange(minRangeX, maxRangeX, minRangeY, maxRangeY);
 	const auto &it = spectatorsCache.find(centerPos);
 	const bool cacheFound = it != spectatorsCache.end();
 	if (cacheFound) {
@@ -135,6 +153,30 @@ Spectators Spectators::find(const Position &centerPos, bool multifloor, bool onl
 		}
 	}
 
+	SpectatorList spectators;
+	spectators.reserve(std::max<uint8_t>(MAP_MAX_VIEW_PORT_X, MAP_MAX_VIEW_PORT_Y) * 2);
+	collect(spectators, centerPos, multifloor, onlyPlayers, minRangeX, maxRangeX, minRangeY, maxRangeY);
+
+	// It is necessary to create the cache even if no spectators is found, so that there is no future query.
+	auto &cache = cacheFound ? it->second : spectatorsCache.emplace(centerPos, SpectatorsCache { .minRangeX = minRangeX, .maxRangeX = maxRangeX, .minRangeY = minRangeY, .maxRangeY = maxRangeY }).first->second;
+	auto &creaturesCache = onlyPlayers ? cache.players : cache.creatures;
+	auto &creatureList = (multifloor ? creaturesCache.multiFloor : creaturesCache.floor);
+	if (creatureList) {
+		creatureList->clear();
+	} else {
+		creatureList.emplace();
+	}
+
+	if (!spectators.empty()) {
+		insertAll(spectators);
+
+		creatureList->insert(creatureList->end(), spectators.begin(), spectators.end());
+	}
+
+	return *this;
+}
+
+void Spectators::collect(SpectatorList &spectators, const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY) {
 	uint8_t minRangeZ = centerPos.z;
 	uint8_t maxRangeZ = centerPos.z;
 
@@ -172,31 +214,23 @@ Spectators Spectators::find(const Position &centerPos, bool multifloor, bool onl
 	const uint_fast16_t endx2 = x2 - (x2 % FLOOR_SIZE);
 	const uint_fast16_t endy2 = y2 - (y2 % FLOOR_SIZE);
 
+	// Leaves keep positions projected to the ground floor (x + z, y + z), so a creature
+	// on another floor is seen when its projection is inside the range shifted by centerPos.z.
+	const int32_t projectedMinX = min_x + centerPos.z;
+	const int32_t projectedMaxX = max_x + centerPos.z;
+	const int32_t projectedMinY = min_y + centerPos.z;
+	const int32_t projectedMaxY = max_y + centerPos.z;
+
 	const auto startLeaf = g_game().map.getQTNode(static_cast<uint16_t>(startx1), static_cast<uint16_t>(starty1));
 	const QTreeLeafNode* leafS = startLeaf;
 	const QTreeLeafNode* leafE;
 
-	SpectatorList spectators;
-	spectators.reserve(std::max<uint8_t>(MAP_MAX_VIEW_PORT_X, MAP_MAX_VIEW_PORT_Y) * 2);
-
 	for (uint_fast16_t ny = starty1; ny <= endy2; ny += FLOOR_SIZE) {
 		leafE = leafS;
 		for (uint_fast16_t nx = startx1; nx <= endx2; nx += FLOOR_SIZE) {
 			if (leafE) {
 				const auto &node_list = (onlyPlayers ? leafE->player_list : leafE->creature_list);
-				for (const auto creature : node_list) {
-					const auto &cpos = creature->getPosition();
-					if (minRangeZ > cpos.z || maxRangeZ < cpos.z) {
-						continue;
-					}
-
-					const int_fast16_t offsetZ = Position::getOffsetZ(centerPos, cpos);
-					if ((min_y + offsetZ) > cpos.y || (max_y + offsetZ) < cpos.y || (min_x + offsetZ) > cpos.x || (max_x + offsetZ) < cpos.x) {
-						continue;
-					}
-
-					spectators.emplace_back(creature);
-				}
+				node_list.collect(spectators, projectedMinX, projectedMaxX, projectedMinY, projectedMaxY, minRangeZ, maxRangeZ);
 				leafE = leafE->leafE;
 			} else {
 				leafE = g_game().map.getQTNode(static_cast<uint16_t>(nx + FLOOR_SIZE), static_cast<uint16_t>(ny));
@@ -209,22 +243,31 @@ Spectators Spectators::find(const Position &centerPos, bool multifloor, bool onl
 			leafS = g_game().map.getQTNode(static_cast<uint16_t>(startx1), static_cast<uint16_t>(ny + FLOOR_SIZE));
 		}
 	}
+}
 
-	// It is necessary to create the cache even if no spectators is found, so that there is no future query.
-	auto &cache = cacheFound ? it->second : spectatorsCache.emplace(centerPos, SpectatorsCache { .minRangeX = minRangeX, .maxRangeX = maxRangeX, .minRangeY = minRangeY, .maxRangeY = maxRangeY }).first->second;
-	auto &creaturesCache = onlyPlayers ? cache.players : cache.creatures;
-	auto &creatureList = (multifloor ? creaturesCache.multiFloor : creaturesCache.floor);
-	if (creatureList) {
-		creatureList->clear();
-	} else {
-		creatureList.emplace();
+SpectatorView Spectators::view(const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY) {
+	normalizeRange(minRangeX, maxRangeX, minRangeY, maxRangeY);
+
+	// The dispatcher cycle doesn't advance while only scheduled events run, the loop count always does
+	if (const auto loop = g_dispatcher().getLoopCount(); loop != viewsLoop) {
+		viewsLoop = loop;
+		views.clear();
+		usedViewLists = 0;
 	}
 
-	if (!spectators.empty()) {
-		insertAll(spectators);
+	const ViewKey key { centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, multifloor, onlyPlayers };
+	if (const auto it = views.find(key); it != views.end()) {
+		return *it->second;
+	}
 
-		creatureList->insert(creatureList->end(), spectators.begin(), spectators.end());
+	if (usedViewLists == viewLists.size()) {
+		viewLists.emplace_back(std::make_unique<SpectatorList>());
 	}
 
-	return *this;
+	auto &spectators = *viewLists[usedViewLists++];
+	spectators.clear();
+	collect(spectators, centerPos, multifloor, onlyPlayers, minRangeX, maxRangeX, minRangeY, maxRangeY);
+
+	views.emplace(key, &spectators);
+	return spectators;
 }
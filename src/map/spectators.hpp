@@ -17,6 +17,7 @@ class Npc;
 struct Position;
 
 using SpectatorList = std::vector<std::shared_ptr<Creature>>;
+using SpectatorView = std::span<const std::shared_ptr<Creature>>;
 
 struct SpectatorsCache {
 	struct FloorData {
@@ -44,6 +45,18 @@ public:
 		return find(centerPos, multifloor, onlyPlayers, minRangeX, maxRangeX, minRangeY, maxRangeY);
 	}
 
+	/**
+	 * Same lookup as find(), but nothing is copied: callers asking for the same area share
+	 * one list until a creature moves, and lists are recycled between dispatcher loop iterations.
+	 * The view stays valid until the end of the loop iteration, even if creatures move meanwhile.
+	 */
+	template <typename T>
+		requires std::is_same_v<Creature, T> || std::is_same_v<Player, T>
+	static SpectatorView view(const Position &centerPos, bool multifloor = false, int32_t minRangeX = 0, int32_t maxRangeX = 0, int32_t minRangeY = 0, int32_t maxRangeY = 0) {
+		constexpr bool onlyPlayers = std::is_same_v<T, Player>;
+		return view(centerPos, multifloor, onlyPlayers, minRangeX, maxRangeX, minRangeY, maxRangeY);
+	}
+
 	template <typename T>
 		requires std::is_base_of_v<Creature, T>
 	Spectators filter();
@@ -60,8 +73,34 @@ public:
 	const CreatureVector &data() noexcept;
 
 private:
+	struct ViewKey {
+		Position centerPos;
+		int32_t minRangeX;
+		int32_t maxRangeX;
+		int32_t minRangeY;
+		int32_t maxRangeY;
+		bool multifloor;
+		bool onlyPlayers;
+
+		bool operator==(const ViewKey &) const = default;
+	};
+
+	struct ViewKeyHash {
+		size_t operator()(const ViewKey &key) const;
+	};
+
 	static phmap::flat_hash_map<Position, SpectatorsCache> spectatorsCache;
 
+	static phmap::flat_hash_map<ViewKey, const SpectatorList*, ViewKeyHash> views;
+	// Lists handed out by view(), only reused once the dispatcher loop iteration that created them is over.
+	static std::vector<std::unique_ptr<SpectatorList>> viewLists;
+	static size_t usedViewLists;
+	static uint64_t viewsLoop;
+
+	static void normalizeRange(int32_t &minRangeX, int32_t &maxRangeX, int32_t &minRangeY, int32_t &maxRangeY);
+	static void collect(SpectatorList &spectators, const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY);
+	static SpectatorView view(const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY);
+
 	Spectators find(const Position &centerPos, bool multifloor = false, bool onlyPlayers = false, int32_t minRangeX = 0, int32_t maxRangeX = 0, int32_t minRangeY = 0, int32_t maxRangeY = 0);
 	bool checkCache(const SpectatorsCache::FloorData &specData, bool onlyPlayers, const Position &centerPos, bool checkDistance, bool multifloor, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY);
 
@@ -18,13 +18,15 @@ AStarNodes::AStarNodes(uint32_t x, uint32_t y) :
 	curNode = 1;
 	closedNodes = 0;
 	openNodes[0] = true;
+	std::fill(std::begin(nodeTable), std::end(nodeTable), -1);
 
 	AStarNode &startNode = nodes[0];
 	startNode.parent = nullptr;
 	startNode.x = x;
 	startNode.y = y;
 	startNode.f = 0;
-	nodeTable[(x << 16) | y] = nodes;
+	nodeTable[getTableSlot(x, y)] = 0;
+	pushOpenNode(0);
 }
 
 AStarNode* AStarNodes::createOpenNode(AStarNode* parent, uint32_t x, uint32_t y, int_fast32_t f) {
@@ -36,30 +38,51 @@ AStarNode* AStarNodes::createOpenNode(AStarNode* parent, uint32_t x, uint32_t y,
 	openNodes[retNode] = true;
 
 	AStarNode* node = nodes + retNode;
-	nodeTable[(x << 16) | y] = node;
 	node->parent = parent;
 	node->x = x;
 	node->y = y;
 	node->f = f;
+
+	uint32_t slot = getTableSlot(x, y);
+	while (nodeTable[slot] != -1) {
+		slot = (slot + 1) & (TABLE_SIZE - 1);
+	}
+	nodeTable[slot] = static_cast<int16_t>(retNode);
+
+	pushOpenNode(static_cast<uint16_t>(retNode));
 	return node;
 }
 
-AStarNode* AStarNodes::getBestNode() {
-	if (curNode == 0) {
-		return nullptr;
+void AStarNodes::pushOpenNode(uint16_t index) {
+	if (heapSize == HEAP_SIZE) {
+		rebuildHeap();
 	}
 
-	int32_t best_node_f = std::numeric_limits<int32_t>::max();
-	int32_t best_node = -1;
-	for (size_t i = 0; i < curNode; i++) {
-		if (openNodes[i] && nodes[i].f < best_node_f) {
-			best_node_f = nodes[i].f;
-			best_node = i;
+	openHeap[heapSize++] = { nodes[index].f, index };
+	std::push_heap(openHeap, openHeap + heapSize, compareHeapEntries);
+}
+
+void AStarNodes::rebuildHeap() {
+	heapSize = 0;
+	for (size_t i = 0; i < curNode; ++i) {
+		if (openNodes[i]) {
+			openHeap[heapSize++] = { nodes[i].f, static_cast<uint16_t>(i) };
 		}
 	}
 
-	if (best_node >= 0) {
-		return nodes + best_node;
+	std::make_heap(openHeap, openHeap + heapSize, compareHeapEntries);
+}
+
+AStarNode* AStarNodes::getBestNode() {
+	// The best node stays on the heap until it is closed, so only stale entries are popped here
+	while (heapSize > 0) {
+		const HeapEntry &top = openHeap[0];
+		if (openNodes[top.index] && nodes[top.index].f == top.f) {
+			return nodes + top.index;
+		}
+
+		std::pop_heap(openHeap, openHeap + heapSize, compareHeapEntries);
+		--heapSize;
 	}
 	return nullptr;
 }
@@ -88,6 +111,9 @@ void AStarNodes::openNode(const AStarNode* node) {
 		openNodes[index] = true;
 		--closedNodes;
 	}
+
+	// Its f was lowered, the previous heap entry becomes stale
+	pushOpenNode(static_cast<uint16_t>(index));
 }
 
 int_fast32_t AStarNodes::getClosedNodes() const {
@@ -95,11 +121,15 @@ int_fast32_t AStarNodes::getClosedNodes() const {
 }
 
 AStarNode* AStarNodes::getNodeByPosition(uint32_t x, uint32_t y) {
-	auto it = nodeTable.find((x << 16) | y);
-	if (it == nodeTable.end()) {
-		return nullptr;
+	uint32_t slot = getTableSlot(x, y);
+	while (nodeTable[slot] != -1) {
+		AStarNode* node = nodes + nodeTable[slot];
+		if (node->x == x && node->y == y) {
+			return node;
+		}
+		slot = (slot + 1) & (TABLE_SIZE - 1);
 	}
-	return it->second;
+	return nullptr;
 }
 
 int_fast32_t AStarNodes::getMapWalkCost(AStarNode* node, const Position &neighborPos, bool preferDiagonal) {
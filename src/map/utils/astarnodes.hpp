@@ -21,6 +21,11 @@ struct AStarNode {
 
 class AStarNodes {
 public:
+	static constexpr int32_t MAX_NODES = 512;
+	static constexpr int32_t MAP_NORMALWALKCOST = 10;
+	static constexpr int32_t MAP_PREFERDIAGONALWALKCOST = 14;
+	static constexpr int32_t MAP_DIAGONALWALKCOST = 25;
+
 	AStarNodes(uint32_t x, uint32_t y);
 
 	AStarNode* createOpenNode(AStarNode* parent, uint32_t x, uint32_t y, int_fast32_t f);
@@ -34,14 +39,34 @@ public:
 	static int_fast32_t getTileWalkCost(const std::shared_ptr<Creature> &creature, const std::shared_ptr<Tile> &tile);
 
 private:
-	static constexpr int32_t MAX_NODES = 512;
-	static constexpr int32_t MAP_NORMALWALKCOST = 10;
-	static constexpr int32_t MAP_PREFERDIAGONALWALKCOST = 14;
-	static constexpr int32_t MAP_DIAGONALWALKCOST = 25;
+	// Open addressing table from position to node index, twice MAX_NODES so probes stay short.
+	static constexpr uint32_t TABLE_SIZE = MAX_NODES * 2;
+	// Every reopened node pushes a new heap entry, when full the heap is rebuilt from the open nodes.
+	static constexpr uint32_t HEAP_SIZE = MAX_NODES * 2;
+
+	struct HeapEntry {
+		int_fast32_t f;
+		uint16_t index;
+	};
+
+	// Lowest f first, ties are broken by creation order like the former linear scan.
+	static bool compareHeapEntries(const HeapEntry &a, const HeapEntry &b) {
+		return a.f > b.f || (a.f == b.f && a.index > b.index);
+	}
+
+	static uint32_t getTableSlot(uint32_t x, uint32_t y) {
+		return ((x * 0x9E3779B1u) ^ (y * 0x85EBCA77u)) & (TABLE_SIZE - 1);
+	}
+
+	void pushOpenNode(uint16_t index);
+	void rebuildHeap();
 
 	AStarNode nodes[MAX_NODES];
 	bool openNodes[MAX_NODES];
-	phmap::flat_hash_map<uint32_t, AStarNode*> nodeTable;
+	int16_t nodeTable[TABLE_SIZE];
+	// Binary min-heap on f, entries of closed nodes or with an outdated f are skipped lazily.
+	HeapEntry openHeap[HEAP_SIZE];
+	size_t heapSize = 0;
 	size_t curNode;
 	int_fast32_t closedNodes;
 };
@@ -0,0 +1,413 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "hpastar.hpp"
+#include "creatures/creature.hpp"
+#include "items/tile.hpp"
+#include "map/map.hpp"
+
+bool HPAStar::isLongDistance(const Position &startPos, const Position &targetPos) {
+	return startPos.z == targetPos.z && std::max(Position::getDistanceX(startPos, targetPos), Position::getDistanceY(startPos, targetPos)) >= CLUSTER_SIZE;
+}
+
+bool HPAStar::isWalkable(const std::shared_ptr<Tile> &tile) {
+	return tile && !tile->hasFlag(TILESTATE_BLOCKSOLID) && !tile->hasFlag(TILESTATE_FLOORCHANGE);
+}
+
+const HPAStar::Entrance* HPAStar::Cluster::findEntrance(const Position &pos) const {
+	for (const auto &entrance : entrances) {
+		if (entrance.pos == pos) {
+			return &entrance;
+		}
+	}
+	return nullptr;
+}
+
+HPAStar::InvalidationSuspension::InvalidationSuspension(HPAStar &hpaStar) :
+	hpaStar(hpaStar) {
+	hpaStar.suspensions.fetch_add(1, std::memory_order_acq_rel);
+}
+
+HPAStar::InvalidationSuspension::~InvalidationSuspension() {
+	// Clusters built while the tiles were changing may be stale, they are dropped all at once
+	if (hpaStar.suspensions.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		hpaStar.clear();
+	}
+}
+
+void HPAStar::invalidate(const Position &pos) {
+	if (suspensions.load(std::memory_order_acquire) != 0) {
+		return;
+	}
+
+	const uint16_t localX = pos.x % CLUSTER_SIZE;
+	const uint16_t localY = pos.y % CLUSTER_SIZE;
+
+	std::array<uint64_t, 5> keys {};
+	size_t count = 0;
+	keys[count++] = clusterKey(pos.x, pos.y, pos.z);
+
+	// Border tiles also decide the entrances of the neighbour cluster
+	if (localX == 0 && pos.x >= CLUSTER_SIZE) {
+		keys[count++] = clusterKey(pos.x - CLUSTER_SIZE, pos.y, pos.z);
+	} else if (localX == CLUSTER_SIZE - 1 && pos.x <= 0xFFFF - CLUSTER_SIZE) {
+		keys[count++] = clusterKey(pos.x + CLUSTER_SIZE, pos.y, pos.z);
+	}
+
+	if (localY == 0 && pos.y >= CLUSTER_SIZE) {
+		keys[count++] = clusterKey(pos.x, pos.y - CLUSTER_SIZE, pos.z);
+	} else if (localY == CLUSTER_SIZE - 1 && pos.y <= 0xFFFF - CLUSTER_SIZE) {
+		keys[count++] = clusterKey(pos.x, pos.y + CLUSTER_SIZE, pos.z);
+	}
+
+	std::scoped_lock l(clustersMutex);
+	for (size_t i = 0; i < count; ++i) {
+		if (const auto it = clusters.find(keys[i]); it != clusters.end()) {
+			it->second.cluster.reset();
+			// A build started before this change must not be cached
+			++it->second.generation;
+		}
+	}
+}
+
+void HPAStar::clear() {
+	std::scoped_lock l(clustersMutex);
+	for (auto &[key, entry] : clusters) {
+		entry.cluster.reset();
+		++entry.generation;
+	}
+}
+
+std::shared_ptr<const HPAStar::Cluster> HPAStar::getCluster(const WalkableCall &walkable, const Position &pos, ClusterCache &cache) {
+	const uint64_t key = clusterKey(pos.x, pos.y, pos.z);
+	if (const auto it = cache.find(key); it != cache.end()) {
+		return it->second;
+	}
+
+	uint32_t generation;
+	{
+		std::scoped_lock l(clustersMutex);
+		auto &entry = clusters[key];
+		if (entry.cluster) {
+			return cache.emplace(key, entry.cluster).first->second;
+		}
+		generation = entry.generation;
+	}
+
+	// Built without the lock, other threads may be building the same cluster meanwhile
+	auto cluster = buildCluster(walkable, pos);
+	{
+		std::scoped_lock l(clustersMutex);
+		auto &entry = clusters[key];
+		if (entry.cluster) {
+			cluster = entry.cluster;
+		} else if (entry.generation == generation) {
+			entry.cluster = cluster;
+		}
+	}
+
+	return cache.emplace(key, std::move(cluster)).first->second;
+}
+
+std::shared_ptr<const HPAStar::Cluster> HPAStar::buildCluster(const WalkableCall &walkable, const Position &pos) {
+	auto cluster = std::make_shared<Cluster>();
+	cluster->originX = pos.x - (pos.x % CLUSTER_SIZE);
+	cluster->originY = pos.y - (pos.y % CLUSTER_SIZE);
+	cluster->z = pos.z;
+
+	for (uint16_t y = 0; y < CLUSTER_SIZE; ++y) {
+		for (uint16_t x = 0; x < CLUSTER_SIZE; ++x) {
+			cluster->walkable[y * CLUSTER_SIZE + x] = walkable(cluster->originX + x, cluster->originY + y, cluster->z);
+		}
+	}
+
+	const auto addEntrance = [&cluster](const Position &inside, const Position &outside) {
+		auto it = std::ranges::find_if(cluster->entrances, [&inside](const Entrance &entrance) {
+			return entrance.pos == inside;
+		});
+		if (it == cluster->entrances.end()) {
+			it = cluster->entrances.emplace(cluster->entrances.end(), Entrance { inside, {} });
+		}
+		it->edges.emplace_back(positionKey(outside), NORMAL_COST);
+	};
+
+	// North, east, south and west borders: offset of the first tile, step along the border and direction to the neighbour
+	static constexpr std::array<std::array<int32_t, 6>, 4> borders { {
+		{ 0, 0, 1, 0, 0, -1 },
+		{ CLUSTER_SIZE - 1, 0, 0, 1, 1, 0 },
+		{ 0, CLUSTER_SIZE - 1, 1, 0, 0, 1 },
+		{ 0, 0, 0, 1, -1, 0 },
+	} };
+
+	for (const auto &[startX, startY, stepX, stepY, outX, outY] : borders) {
+		const int32_t outsideX = cluster->originX + startX + outX;
+		const int32_t outsideY = cluster->originY + startY + outY;
+		if (outsideX < 0 || outsideY < 0 || outsideX + stepX * (CLUSTER_SIZE - 1) > 0xFFFF || outsideY + stepY * (CLUSTER_SIZE - 1) > 0xFFFF) {
+			continue;
+		}
+
+		// Both clusters scan the shared border in the same order, so they agree on the entrances
+		int32_t runStart = -1;
+		for (int32_t i = 0; i <= CLUSTER_SIZE; ++i) {
+			bool open = false;
+			if (i < CLUSTER_SIZE) {
+				const int32_t localX = startX + stepX * i;
+				const int32_t localY = startY + stepY * i;
+				open = cluster->walkable[localY * CLUSTER_SIZE + localX] && walkable(outsideX + stepX * i, outsideY + stepY * i, cluster->z);
+			}
+
+			if (open) {
+				if (runStart == -1) {
+					runStart = i;
+				}
+				continue;
+			}
+
+			if (runStart == -1) {
+				continue;
+			}
+
+			const int32_t runEnd = i - 1;
+			std::array<int32_t, 2> offsets { runStart + (runEnd - runStart) / 2, -1 };
+			if (runEnd - runStart + 1 >= SPLIT_ENTRANCE_LENGTH) {
+				offsets = { runStart, runEnd };
+			}
+
+			for (const int32_t offset : offsets) {
+				if (offset == -1) {
+					continue;
+				}
+
+				const Position inside(cluster->originX + startX + stepX * offset, cluster->originY + startY + stepY * offset, cluster->z);
+				const Position outside(outsideX + stepX * offset, outsideY + stepY * offset, cluster->z);
+				addEntrance(inside, outside);
+			}
+			runStart = -1;
+		}
+	}
+
+	std::array<int32_t, CLUSTER_SIZE * CLUSTER_SIZE> costs;
+	for (auto &entrance : cluster->entrances) {
+		getCosts(*cluster, entrance.pos, costs);
+		for (const auto &other : cluster->entrances) {
+			if (&other == &entrance) {
+				continue;
+			}
+
+			const int32_t cost = costs[(other.pos.y - cluster->originY) * CLUSTER_SIZE + (other.pos.x - cluster->originX)];
+			if (cost != -1) {
+				entrance.edges.emplace_back(positionKey(other.pos), cost);
+			}
+		}
+	}
+
+	return cluster;
+}
+
+void HPAStar::getCosts(const Cluster &cluster, const Position &pos, std::array<int32_t, CLUSTER_SIZE * CLUSTER_SIZE> &costs) {
+	costs.fill(-1);
+
+	using QueueEntry = std::pair<int32_t, uint16_t>;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+
+	// The start cell is always accepted, the target of a search may be standing on a blocking tile
+	const uint16_t start = (pos.y - cluster.originY) * CLUSTER_SIZE + (pos.x - cluster.originX);
+	costs[start] = 0;
+	queue.emplace(0, start);
+
+	while (!queue.empty()) {
+		const auto [cost, cell] = queue.top();
+		queue.pop();
+		if (cost != costs[cell]) {
+			continue;
+		}
+
+		const int32_t x = cell % CLUSTER_SIZE;
+		const int32_t y = cell / CLUSTER_SIZE;
+		for (int32_t dy = -1; dy <= 1; ++dy) {
+			for (int32_t dx = -1; dx <= 1; ++dx) {
+				const int32_t nx = x + dx;
+				const int32_t ny = y + dy;
+				if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= CLUSTER_SIZE || ny >= CLUSTER_SIZE) {
+					continue;
+				}
+
+				const auto neighbor = static_cast<uint16_t>(ny * CLUSTER_SIZE + nx);
+				if (!cluster.walkable[neighbor]) {
+					continue;
+				}
+
+				const int32_t newCost = cost + (dx != 0 && dy != 0 ? DIAGONAL_COST : NORMAL_COST);
+				if (costs[neighbor] == -1 || newCost < costs[neighbor]) {
+					costs[neighbor] = newCost;
+					queue.emplace(newCost, neighbor);
+				}
+			}
+		}
+	}
+}
+
+int32_t HPAStar::findWaypoints(const WalkableCall &walkable, const Position &startPos, const Position &targetPos, std::vector<Position> &waypoints) {
+	ClusterCache cache;
+	const auto startCluster = getCluster(walkable, startPos, cache);
+	const auto targetCluster = getCluster(walkable, targetPos, cache);
+
+	std::array<int32_t, CLUSTER_SIZE * CLUSTER_SIZE> startCosts;
+	std::array<int32_t, CLUSTER_SIZE * CLUSTER_SIZE> targetCosts;
+	getCosts(*startCluster, startPos, startCosts);
+	getCosts(*targetCluster, targetPos, targetCosts);
+
+	const auto getLocalCost = [](const Cluster &cluster, const std::array<int32_t, CLUSTER_SIZE * CLUSTER_SIZE> &costs, const Position &pos) {
+		return costs[(pos.y - cluster.originY) * CLUSTER_SIZE + (pos.x - cluster.originX)];
+	};
+
+	const auto heuristic = [&targetPos](const Position &pos) {
+		return NORMAL_COST * std::max(Position::getDistanceX(pos, targetPos), Position::getDistanceY(pos, targetPos));
+	};
+
+	// Abstract A* over the entrances, the start and the target are virtual nodes
+	static constexpr uint64_t START_NODE = std::numeric_limits<uint64_t>::max();
+	static constexpr uint64_t TARGET_NODE = START_NODE - 1;
+
+	struct Visit {
+		int32_t cost;
+		uint64_t parent;
+		bool closed;
+	};
+
+	phmap::flat_hash_map<uint64_t, Visit> visits;
+	using QueueEntry = std::pair<int32_t, uint64_t>;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> open;
+
+	const auto relax = [&](uint64_t node, uint64_t parent, int32_t cost, int32_t estimate) {
+		auto [it, inserted] = visits.try_emplace(node, Visit { cost, parent, false });
+		if (!inserted) {
+			if (it->second.closed || it->second.cost <= cost) {
+				return;
+			}
+			it->second.cost = cost;
+			it->second.parent = parent;
+		}
+		open.emplace(cost + estimate, node);
+	};
+
+	for (const auto &entrance : startCluster->entrances) {
+		const int32_t cost = getLocalCost(*startCluster, startCosts, entrance.pos);
+		if (cost != -1) {
+			relax(positionKey(entrance.pos), START_NODE, cost, heuristic(entrance.pos));
+		}
+	}
+
+	bool found = false;
+	uint32_t expansions = 0;
+	while (!open.empty() && expansions < MAX_EXPANSIONS) {
+		const uint64_t node = open.top().second;
+		open.pop();
+
+		auto &visit = visits[node];
+		if (visit.closed) {
+			continue;
+		}
+		visit.closed = true;
+
+		if (node == TARGET_NODE) {
+			found = true;
+			break;
+		}
+
+		++expansions;
+		const int32_t cost = visit.cost;
+		const Position pos = keyToPosition(node);
+		const auto cluster = getCluster(walkable, pos, cache);
+		const auto entrance = cluster->findEntrance(pos);
+		if (!entrance) {
+			// The neighbour cluster was rebuilt meanwhile and this entrance is gone
+			continue;
+		}
+
+		for (const auto &edge : entrance->edges) {
+			relax(edge.to, node, cost + edge.cost, heuristic(keyToPosition(edge.to)));
+		}
+
+		if (cluster == targetCluster) {
+			const int32_t targetCost = getLocalCost(*targetCluster, targetCosts, pos);
+			if (targetCost != -1) {
+				relax(TARGET_NODE, node, cost + targetCost, 0);
+			}
+		}
+	}
+
+	if (!found) {
+		return -1;
+	}
+
+	waypoints.clear();
+	for (uint64_t node = visits[TARGET_NODE].parent; node != START_NODE; node = visits[node].parent) {
+		waypoints.emplace_back(keyToPosition(node));
+	}
+	std::ranges::reverse(waypoints);
+	return visits[TARGET_NODE].cost;
+}
+
+bool HPAStar::getPathMatching(Map &map, const std::shared_ptr<Creature> &creature, const Position &startPos, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp) {
+	const Position targetPos = pathCondition.getTargetPos();
+	if (!isLongDistance(startPos, targetPos)) {
+		return false;
+	}
+
+	const WalkableCall walkable = [&map](uint16_t x, uint16_t y, uint8_t z) {
+		return isWalkable(map.getTile(x, y, z));
+	};
+
+	std::vector<Position> waypoints;
+	if (findWaypoints(walkable, startPos, targetPos, waypoints) == -1) {
+		return false;
+	}
+
+	// Refine the abstract path with the bounded A*, one entrance at a time
+	FindPathParams segmentParams;
+	segmentParams.fullPathSearch = true;
+	segmentParams.clearSight = false;
+	segmentParams.allowDiagonal = fpp.allowDiagonal;
+	segmentParams.maxSearchDist = CLUSTER_SIZE * 2;
+	segmentParams.minTargetDist = 0;
+	segmentParams.maxTargetDist = 0;
+
+	std::vector<Direction> path;
+	Position current = startPos;
+	stdext::arraylist<Direction> segment;
+	const auto appendSegment = [&path, &segment]() {
+		const auto &directions = segment.data();
+		path.insert(path.end(), directions.begin(), directions.end());
+		segment.clear();
+	};
+
+	for (const auto &waypoint : waypoints) {
+		if (!map.getPathMatchingAStar(creature, current, segment, FrozenPathingConditionCall(waypoint), segmentParams)) {
+			return false;
+		}
+		appendSegment();
+		current = waypoint;
+	}
+
+	// The last stretch uses the real condition, so the target distances and sight are respected
+	FindPathParams lastParams = fpp;
+	lastParams.maxSearchDist = std::max<int32_t>(fpp.maxSearchDist, CLUSTER_SIZE * 2);
+	if (!map.getPathMatchingAStar(creature, current, segment, pathCondition, lastParams)) {
+		return false;
+	}
+	appendSegment();
+
+	for (const auto direction : path) {
+		dirList.push_back(direction);
+	}
+	return true;
+}
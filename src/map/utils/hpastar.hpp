@@ -0,0 +1,136 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "game/movement/position.hpp"
+
+class Map;
+class Creature;
+class Tile;
+class FrozenPathingConditionCall;
+struct FindPathParams;
+
+/**
+ * Hierarchical pathfinding (HPA*) for long distance searches on a single floor.
+ *
+ * The map is split in CLUSTER_SIZE x CLUSTER_SIZE clusters per floor. A cluster keeps its
+ * entrances (walkable tiles facing a walkable tile of the neighbour cluster) and the cost
+ * between every pair of its entrances. A search runs A* over this small graph and then
+ * refines it with the regular A* between consecutive entrances, so every refinement stays
+ * inside the AStarNodes::MAX_NODES budget no matter how far the target is.
+ *
+ * Clusters are built from the tiles on first use and never modified afterwards, searches
+ * running on the async pathfinding threads only lock to look them up. A tile whose
+ * walkability changes drops its cluster, and the neighbour one when it is on a border.
+ * The map loading suspends that and drops every cluster once it is done.
+ */
+class HPAStar {
+public:
+	static constexpr uint16_t CLUSTER_SIZE = 16;
+
+	HPAStar() = default;
+
+	// Ensures that we don't accidentally copy it
+	HPAStar(const HPAStar &) = delete;
+	HPAStar operator=(const HPAStar &) = delete;
+
+	// Short searches are cheaper with the plain A*, so only targets outside the start cluster range qualify.
+	static bool isLongDistance(const Position &startPos, const Position &targetPos);
+	// Creature independent walkability used by the cluster graph.
+	static bool isWalkable(const std::shared_ptr<Tile> &tile);
+
+	// Tells whether the cluster graph may cross a position, the map checks its tiles with isWalkable.
+	using WalkableCall = std::function<bool(uint16_t x, uint16_t y, uint8_t z)>;
+
+	/**
+	 * Keeps the clusters while the walkability of many tiles changes, like during the map loading.
+	 * Invalidations are ignored until the last suspension ends, then every cluster is dropped.
+	 */
+	class InvalidationSuspension {
+	public:
+		explicit InvalidationSuspension(HPAStar &hpaStar);
+		~InvalidationSuspension();
+
+		InvalidationSuspension(const InvalidationSuspension &) = delete;
+		InvalidationSuspension &operator=(const InvalidationSuspension &) = delete;
+
+	private:
+		HPAStar &hpaStar;
+	};
+
+	bool getPathMatching(Map &map, const std::shared_ptr<Creature> &creature, const Position &startPos, stdext::arraylist<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp);
+
+	/**
+	 * Runs the abstract search over the cluster graph.
+	 * \param waypoints Receives the entrances crossed on the way to the target
+	 * \returns The cost of the abstract path, -1 when the target can't be reached
+	 */
+	int32_t findWaypoints(const WalkableCall &walkable, const Position &startPos, const Position &targetPos, std::vector<Position> &waypoints);
+
+	void invalidate(const Position &pos);
+	void clear();
+
+private:
+	static constexpr int32_t NORMAL_COST = 10;
+	static constexpr int32_t DIAGONAL_COST = 14;
+	// Border runs at least this long get an entrance at each end instead of one in the middle.
+	static constexpr uint16_t SPLIT_ENTRANCE_LENGTH = 6;
+	// Abstract nodes expanded before giving up, enough to cross hundreds of clusters.
+	static constexpr uint32_t MAX_EXPANSIONS = 4096;
+
+	struct Edge {
+		uint64_t to;
+		int32_t cost;
+	};
+
+	struct Entrance {
+		Position pos;
+		std::vector<Edge> edges;
+	};
+
+	struct Cluster {
+		uint16_t originX = 0;
+		uint16_t originY = 0;
+		uint8_t z = 0;
+		std::bitset<CLUSTER_SIZE * CLUSTER_SIZE> walkable;
+		std::vector<Entrance> entrances;
+
+		const Entrance* findEntrance(const Position &pos) const;
+	};
+
+	struct ClusterEntry {
+		std::shared_ptr<const Cluster> cluster;
+		uint32_t generation = 0;
+	};
+
+	using ClusterCache = phmap::flat_hash_map<uint64_t, std::shared_ptr<const Cluster>>;
+
+	static uint64_t clusterKey(uint16_t x, uint16_t y, uint8_t z) {
+		return (static_cast<uint64_t>(x / CLUSTER_SIZE) << 24) | (static_cast<uint64_t>(y / CLUSTER_SIZE) << 8) | z;
+	}
+
+	static uint64_t positionKey(const Position &pos) {
+		return (static_cast<uint64_t>(pos.x) << 24) | (static_cast<uint64_t>(pos.y) << 8) | pos.z;
+	}
+
+	static Position keyToPosition(uint64_t key) {
+		return Position(static_cast<uint16_t>(key >> 24), static_cast<uint16_t>(key >> 8), static_cast<uint8_t>(key));
+	}
+
+	// Walking cost from `pos` to every cell of the cluster without leaving it, -1 when unreachable.
+	static void getCosts(const Cluster &cluster, const Position &pos, std::array<int32_t, CLUSTER_SIZE * CLUSTER_SIZE> &costs);
+
+	std::shared_ptr<const Cluster> getCluster(const WalkableCall &walkable, const Position &pos, ClusterCache &cache);
+	static std::shared_ptr<const Cluster> buildCluster(const WalkableCall &walkable, const Position &pos);
+
+	std::atomic_uint32_t suspensions = 0;
+	std::mutex clustersMutex;
+	phmap::flat_hash_map<uint64_t, ClusterEntry> clusters;
+};
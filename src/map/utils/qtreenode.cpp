@@ -10,8 +10,15 @@
 #include "pch.hpp"
 
 #include "creatures/creature.hpp"
+#include "map/mapcache.hpp"
 #include "qtreenode.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64)
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+#endif
+
 bool QTreeLeafNode::newLeaf = false;
 
 QTreeLeafNode* QTreeNode::getLeaf(uint32_t x, uint32_t y) {
@@ -70,34 +77,148 @@ QTreeLeafNode* QTreeNode::getBestLeaf(uint32_t x, uint32_t y, uint32_t level) {
 	return tempLeaf;
 }
 
-void QTreeLeafNode::addCreature(const std::shared_ptr<Creature> &c) {
-	creature_list.push_back(c);
+Tile* QTreeLeafNode::getTileRef(uint16_t x, uint16_t y, uint8_t z) const {
+	if (z >= MAP_MAX_LAYERS) {
+		return nullptr;
+	}
+
+	const auto &floor = array[z];
+	return floor ? floor->getTileRef(x, y) : nullptr;
+}
+
+void QTreeLeafNode::addCreature(const std::shared_ptr<Creature> &c, const Position &pos) {
+	creature_list.add(c, pos);
 
 	if (c->getPlayer()) {
-		player_list.push_back(c);
+		player_list.add(c, pos);
 	}
 }
 
 void QTreeLeafNode::removeCreature(std::shared_ptr<Creature> c) {
-	auto iter = std::find(creature_list.begin(), creature_list.end(), c);
-	if (iter == creature_list.end()) {
+	if (!creature_list.remove(c)) {
 		g_logger().error("[{}]: Creature not found in creature_list!", __FUNCTION__);
 		return;
 	}
 
-	assert(iter != creature_list.end());
-	*iter = creature_list.back();
-	creature_list.pop_back();
+	if (c->getPlayer() && !player_list.remove(c)) {
+		g_logger().error("[{}]: Player not found in player_list!", __FUNCTION__);
+	}
+}
+
+void QTreeLeafNode::updateCreature(const std::shared_ptr<Creature> &c, const Position &pos) {
+	creature_list.update(c, pos);
 
 	if (c->getPlayer()) {
-		iter = std::find(player_list.begin(), player_list.end(), c);
-		if (iter == player_list.end()) {
-			g_logger().error("[{}]: Player not found in player_list!", __FUNCTION__);
-			return;
+		player_list.update(c, pos);
+	}
+}
+
+size_t LeafCreatures::indexOf(const std::shared_ptr<Creature> &creature) const {
+	return static_cast<size_t>(std::find(creatures.begin(), creatures.end(), creature) - creatures.begin());
+}
+
+void LeafCreatures::add(const std::shared_ptr<Creature> &creature, const Position &pos) {
+	creatures.emplace_back(creature);
+	x.emplace_back(pos.x + pos.z);
+	y.emplace_back(pos.y + pos.z);
+	z.emplace_back(pos.z);
+	++floorCount[pos.z];
+}
+
+bool LeafCreatures::remove(const std::shared_ptr<Creature> &creature) {
+	const auto index = indexOf(creature);
+	if (index == creatures.size()) {
+		return false;
+	}
+
+	--floorCount[z[index]];
+	creatures[index] = std::move(creatures.back());
+	x[index] = x.back();
+	y[index] = y.back();
+	z[index] = z.back();
+
+	creatures.pop_back();
+	x.pop_back();
+	y.pop_back();
+	z.pop_back();
+	return true;
+}
+
+void LeafCreatures::update(const std::shared_ptr<Creature> &creature, const Position &pos) {
+	const auto index = indexOf(creature);
+	if (index == creatures.size()) {
+		return;
+	}
+
+	--floorCount[z[index]];
+	++floorCount[pos.z];
+
+	x[index] = pos.x + pos.z;
+	y[index] = pos.y + pos.z;
+	z[index] = pos.z;
+}
+
+bool LeafCreatures::hasOnFloors(uint8_t minZ, uint8_t maxZ) const {
+	for (uint8_t floor = minZ; floor <= maxZ; ++floor) {
+		if (floorCount[floor] != 0) {
+			return true;
 		}
+	}
+	return false;
+}
+
+void LeafCreatures::collect(std::vector<std::shared_ptr<Creature>> &out, int32_t minX, int32_t maxX, int32_t minY, int32_t maxY, int32_t minZ, int32_t maxZ) const {
+	const size_t size = creatures.size();
+	size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+	const __m128i vMinX = _mm_set1_epi32(minX), vMaxX = _mm_set1_epi32(maxX);
+	const __m128i vMinY = _mm_set1_epi32(minY), vMaxY = _mm_set1_epi32(maxY);
+	const __m128i vMinZ = _mm_set1_epi32(minZ), vMaxZ = _mm_set1_epi32(maxZ);
+
+	for (; i + 4 <= size; i += 4) {
+		const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x.data() + i));
+		const __m128i vy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y.data() + i));
+		const __m128i vz = _mm_loadu_si128(reinterpret_cast<const __m128i*>(z.data() + i));
+
+		// Lanes below the minimum or above the maximum of any axis are out of range
+		__m128i outside = _mm_or_si128(_mm_cmplt_epi32(vx, vMinX), _mm_cmpgt_epi32(vx, vMaxX));
+		outside = _mm_or_si128(outside, _mm_or_si128(_mm_cmplt_epi32(vy, vMinY), _mm_cmpgt_epi32(vy, vMaxY)));
+		outside = _mm_or_si128(outside, _mm_or_si128(_mm_cmplt_epi32(vz, vMinZ), _mm_cmpgt_epi32(vz, vMaxZ)));
+
+		auto mask = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+		while (mask != 0) {
+			out.emplace_back(creatures[i + std::countr_zero(static_cast<uint32_t>(mask))]);
+			mask &= mask - 1;
+		}
+	}
+#elif defined(__ARM_NEON)
+	const int32x4_t vMinX = vdupq_n_s32(minX), vMaxX = vdupq_n_s32(maxX);
+	const int32x4_t vMinY = vdupq_n_s32(minY), vMaxY = vdupq_n_s32(maxY);
+	const int32x4_t vMinZ = vdupq_n_s32(minZ), vMaxZ = vdupq_n_s32(maxZ);
+
+	for (; i + 4 <= size; i += 4) {
+		const int32x4_t vx = vld1q_s32(x.data() + i);
+		const int32x4_t vy = vld1q_s32(y.data() + i);
+		const int32x4_t vz = vld1q_s32(z.data() + i);
+
+		uint32x4_t inside = vandq_u32(vcgeq_s32(vx, vMinX), vcleq_s32(vx, vMaxX));
+		inside = vandq_u32(inside, vandq_u32(vcgeq_s32(vy, vMinY), vcleq_s32(vy, vMaxY)));
+		inside = vandq_u32(inside, vandq_u32(vcgeq_s32(vz, vMinZ), vcleq_s32(vz, vMaxZ)));
+
+		uint32_t lanes[4];
+		vst1q_u32(lanes, inside);
+		for (size_t lane = 0; lane < 4; ++lane) {
+			if (lanes[lane] != 0) {
+				out.emplace_back(creatures[i + lane]);
+			}
+		}
+	}
+#endif
 
-		assert(iter != player_list.end());
-		*iter = player_list.back();
-		player_list.pop_back();
+	for (; i < size; ++i) {
+		if (x[i] >= minX && x[i] <= maxX && y[i] >= minY && y[i] <= maxY && z[i] >= minZ && z[i] <= maxZ) {
+			out.emplace_back(creatures[i]);
+		}
 	}
 }
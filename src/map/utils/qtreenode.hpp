@@ -14,6 +14,8 @@
 struct Floor;
 class QTreeLeafNode;
 class Creature;
+class Tile;
+struct Position;
 
 class QTreeNode {
 public:
@@ -53,6 +55,43 @@ protected:
 	bool leaf = false;
 };
 
+/**
+ * Creatures of a leaf, with their positions kept in separate arrays (SoA) so the
+ * spectator scans filter them with SIMD instead of dereferencing each creature.
+ * Positions are stored projected to the ground floor (x + z, y + z), which is
+ * the offset used to see creatures on other floors.
+ */
+class LeafCreatures {
+public:
+	void add(const std::shared_ptr<Creature> &creature, const Position &pos);
+	bool remove(const std::shared_ptr<Creature> &creature);
+	void update(const std::shared_ptr<Creature> &creature, const Position &pos);
+
+	// Appends the creatures whose projected position is inside the bounds (inclusive).
+	void collect(std::vector<std::shared_ptr<Creature>> &out, int32_t minX, int32_t maxX, int32_t minY, int32_t maxY, int32_t minZ, int32_t maxZ) const;
+
+	const std::vector<std::shared_ptr<Creature>> &list() const {
+		return creatures;
+	}
+
+	bool empty() const {
+		return creatures.empty();
+	}
+
+	// Whether any creature stands on one of the floors, answered from the per floor counters.
+	bool hasOnFloors(uint8_t minZ, uint8_t maxZ) const;
+
+private:
+	size_t indexOf(const std::shared_ptr<Creature> &creature) const;
+
+	std::vector<std::shared_ptr<Creature>> creatures;
+	std::vector<int32_t> x;
+	std::vector<int32_t> y;
+	std::vector<int32_t> z;
+
+	std::array<uint16_t, MAP_MAX_LAYERS> floorCount {};
+};
+
 class QTreeLeafNode final : public QTreeNode {
 public:
 	QTreeLeafNode() {
@@ -72,8 +111,13 @@ public:
 		return array[z];
 	}
 
-	void addCreature(const std::shared_ptr<Creature> &c);
+	// Lock-free lookup of an already loaded tile, the reference is valid until the current dispatcher loop iteration ends.
+	Tile* getTileRef(uint16_t x, uint16_t y, uint8_t z) const;
+
+	void addCreature(const std::shared_ptr<Creature> &c, const Position &pos);
 	void removeCreature(std::shared_ptr<Creature> c);
+	// Must be called when a creature moves without leaving this leaf.
+	void updateCreature(const std::shared_ptr<Creature> &c, const Position &pos);
 
 private:
 	static bool newLeaf;
@@ -82,8 +126,8 @@ private:
 
 	std::unique_ptr<Floor> array[MAP_MAX_LAYERS] = {};
 
-	std::vector<std::shared_ptr<Creature>> creature_list;
-	std::vector<std::shared_ptr<Creature>> player_list;
+	LeafCreatures creature_list;
+	LeafCreatures player_list;
 
 	friend class Map;
 	friend class MapCache;
@@ -68,6 +68,7 @@
 // --------------------
 
 // ABSL
+#include <absl/container/inlined_vector.h>
 #include <absl/numeric/int128.h>
 
 // ASIO
@@ -0,0 +1,299 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "security/xtea.hpp"
+
+#if !defined(__DISABLE_VECTORIZATION__)
+	#if defined(SIMD_X86)
+		#define XTEA_X86 1
+		#include <immintrin.h>
+	#elif defined(__NEON__) || defined(__aarch64__)
+		#define XTEA_NEON 1
+		#include <arm_neon.h>
+	#endif
+#endif
+
+namespace {
+	constexpr uint32_t DELTA = 0x61C88647;
+
+	// Round keys, the key words and the sum of each half round are the same for every block.
+	struct RoundKeys {
+		std::array<uint32_t, 32> first;
+		std::array<uint32_t, 32> second;
+	};
+
+	RoundKeys encryptKeys(const xtea::Key &key) {
+		RoundKeys keys {};
+		uint32_t sum = 0;
+		for (size_t i = 0; i < 32; ++i) {
+			keys.first[i] = sum + key[sum & 3];
+			sum -= DELTA;
+			keys.second[i] = sum + key[(sum >> 11) & 3];
+		}
+		return keys;
+	}
+
+	RoundKeys decryptKeys(const xtea::Key &key) {
+		RoundKeys keys {};
+		uint32_t sum = 0xC6EF3720;
+		for (size_t i = 0; i < 32; ++i) {
+			keys.first[i] = sum + key[(sum >> 11) & 3];
+			sum += DELTA;
+			keys.second[i] = sum + key[sum & 3];
+		}
+		return keys;
+	}
+
+	void encryptScalar(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		for (size_t block = 0; block < blocks; ++block, data += 8) {
+			std::array<uint32_t, 2> v = {};
+			memcpy(v.data(), data, 8);
+			for (size_t i = 0; i < 32; ++i) {
+				v[0] += ((v[1] << 4 ^ v[1] >> 5) + v[1]) ^ keys.first[i];
+				v[1] += ((v[0] << 4 ^ v[0] >> 5) + v[0]) ^ keys.second[i];
+			}
+			memcpy(data, v.data(), 8);
+		}
+	}
+
+	void decryptScalar(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		for (size_t block = 0; block < blocks; ++block, data += 8) {
+			std::array<uint32_t, 2> v = {};
+			memcpy(v.data(), data, 8);
+			for (size_t i = 0; i < 32; ++i) {
+				v[1] -= ((v[0] << 4 ^ v[0] >> 5) + v[0]) ^ keys.first[i];
+				v[0] -= ((v[1] << 4 ^ v[1] >> 5) + v[1]) ^ keys.second[i];
+			}
+			memcpy(data, v.data(), 8);
+		}
+	}
+
+#if defined(XTEA_X86)
+	// The vector kernels split the blocks in a vector of first words and a vector of second words.
+	// Within each 128 bits lane: [a0 b0 a1 b1] [a2 b2 a3 b3] -> [a0 a1 a2 a3] [b0 b1 b2 b3], and back.
+
+	SIMD_TARGET("sse2")
+	inline __m128i mixSSE2(__m128i v) {
+		return _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(v, 4), _mm_srli_epi32(v, 5)), v);
+	}
+
+	SIMD_TARGET("sse2")
+	size_t encryptSSE2(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 4 <= blocks; done += 4) {
+			auto* ptr = reinterpret_cast<__m128i*>(data + done * 8);
+			const __m128i low = _mm_shuffle_epi32(_mm_loadu_si128(ptr), _MM_SHUFFLE(3, 1, 2, 0));
+			const __m128i high = _mm_shuffle_epi32(_mm_loadu_si128(ptr + 1), _MM_SHUFFLE(3, 1, 2, 0));
+			__m128i v0 = _mm_unpacklo_epi64(low, high);
+			__m128i v1 = _mm_unpackhi_epi64(low, high);
+			for (size_t i = 0; i < 32; ++i) {
+				v0 = _mm_add_epi32(v0, _mm_xor_si128(mixSSE2(v1), _mm_set1_epi32(static_cast<int>(keys.first[i]))));
+				v1 = _mm_add_epi32(v1, _mm_xor_si128(mixSSE2(v0), _mm_set1_epi32(static_cast<int>(keys.second[i]))));
+			}
+			_mm_storeu_si128(ptr, _mm_unpacklo_epi32(v0, v1));
+			_mm_storeu_si128(ptr + 1, _mm_unpackhi_epi32(v0, v1));
+		}
+		return done;
+	}
+
+	SIMD_TARGET("sse2")
+	size_t decryptSSE2(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 4 <= blocks; done += 4) {
+			auto* ptr = reinterpret_cast<__m128i*>(data + done * 8);
+			const __m128i low = _mm_shuffle_epi32(_mm_loadu_si128(ptr), _MM_SHUFFLE(3, 1, 2, 0));
+			const __m128i high = _mm_shuffle_epi32(_mm_loadu_si128(ptr + 1), _MM_SHUFFLE(3, 1, 2, 0));
+			__m128i v0 = _mm_unpacklo_epi64(low, high);
+			__m128i v1 = _mm_unpackhi_epi64(low, high);
+			for (size_t i = 0; i < 32; ++i) {
+				v1 = _mm_sub_epi32(v1, _mm_xor_si128(mixSSE2(v0), _mm_set1_epi32(static_cast<int>(keys.first[i]))));
+				v0 = _mm_sub_epi32(v0, _mm_xor_si128(mixSSE2(v1), _mm_set1_epi32(static_cast<int>(keys.second[i]))));
+			}
+			_mm_storeu_si128(ptr, _mm_unpacklo_epi32(v0, v1));
+			_mm_storeu_si128(ptr + 1, _mm_unpackhi_epi32(v0, v1));
+		}
+		return done;
+	}
+
+	SIMD_TARGET("avx2")
+	inline __m256i mixAVX2(__m256i v) {
+		return _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(v, 4), _mm256_srli_epi32(v, 5)), v);
+	}
+
+	SIMD_TARGET("avx2")
+	size_t encryptAVX2(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 8 <= blocks; done += 8) {
+			auto* ptr = reinterpret_cast<__m256i*>(data + done * 8);
+			const __m256i low = _mm256_shuffle_epi32(_mm256_loadu_si256(ptr), _MM_SHUFFLE(3, 1, 2, 0));
+			const __m256i high = _mm256_shuffle_epi32(_mm256_loadu_si256(ptr + 1), _MM_SHUFFLE(3, 1, 2, 0));
+			__m256i v0 = _mm256_unpacklo_epi64(low, high);
+			__m256i v1 = _mm256_unpackhi_epi64(low, high);
+			for (size_t i = 0; i < 32; ++i) {
+				v0 = _mm256_add_epi32(v0, _mm256_xor_si256(mixAVX2(v1), _mm256_set1_epi32(static_cast<int>(keys.first[i]))));
+				v1 = _mm256_add_epi32(v1, _mm256_xor_si256(mixAVX2(v0), _mm256_set1_epi32(static_cast<int>(keys.second[i]))));
+			}
+			_mm256_storeu_si256(ptr, _mm256_unpacklo_epi32(v0, v1));
+			_mm256_storeu_si256(ptr + 1, _mm256_unpackhi_epi32(v0, v1));
+		}
+		return done;
+	}
+
+	SIMD_TARGET("avx2")
+	size_t decryptAVX2(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 8 <= blocks; done += 8) {
+			auto* ptr = reinterpret_cast<__m256i*>(data + done * 8);
+			const __m256i low = _mm256_shuffle_epi32(_mm256_loadu_si256(ptr), _MM_SHUFFLE(3, 1, 2, 0));
+			const __m256i high = _mm256_shuffle_epi32(_mm256_loadu_si256(ptr + 1), _MM_SHUFFLE(3, 1, 2, 0));
+			__m256i v0 = _mm256_unpacklo_epi64(low, high);
+			__m256i v1 = _mm256_unpackhi_epi64(low, high);
+			for (size_t i = 0; i < 32; ++i) {
+				v1 = _mm256_sub_epi32(v1, _mm256_xor_si256(mixAVX2(v0), _mm256_set1_epi32(static_cast<int>(keys.first[i]))));
+				v0 = _mm256_sub_epi32(v0, _mm256_xor_si256(mixAVX2(v1), _mm256_set1_epi32(static_cast<int>(keys.second[i]))));
+			}
+			_mm256_storeu_si256(ptr, _mm256_unpacklo_epi32(v0, v1));
+			_mm256_storeu_si256(ptr + 1, _mm256_unpackhi_epi32(v0, v1));
+		}
+		return done;
+	}
+
+	constexpr auto PERM_DEINTERLEAVE = static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(3, 1, 2, 0));
+
+	SIMD_TARGET("avx512f")
+	inline __m512i mixAVX512(__m512i v) {
+		return _mm512_add_epi32(_mm512_xor_si512(_mm512_slli_epi32(v, 4), _mm512_srli_epi32(v, 5)), v);
+	}
+
+	SIMD_TARGET("avx512f")
+	size_t encryptAVX512(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 16 <= blocks; done += 16) {
+			uint8_t* ptr = data + done * 8;
+			const __m512i low = _mm512_shuffle_epi32(_mm512_loadu_si512(ptr), PERM_DEINTERLEAVE);
+			const __m512i high = _mm512_shuffle_epi32(_mm512_loadu_si512(ptr + 64), PERM_DEINTERLEAVE);
+			__m512i v0 = _mm512_unpacklo_epi64(low, high);
+			__m512i v1 = _mm512_unpackhi_epi64(low, high);
+			for (size_t i = 0; i < 32; ++i) {
+				v0 = _mm512_add_epi32(v0, _mm512_xor_si512(mixAVX512(v1), _mm512_set1_epi32(static_cast<int>(keys.first[i]))));
+				v1 = _mm512_add_epi32(v1, _mm512_xor_si512(mixAVX512(v0), _mm512_set1_epi32(static_cast<int>(keys.second[i]))));
+			}
+			_mm512_storeu_si512(ptr, _mm512_unpacklo_epi32(v0, v1));
+			_mm512_storeu_si512(ptr + 64, _mm512_unpackhi_epi32(v0, v1));
+		}
+		return done;
+	}
+
+	SIMD_TARGET("avx512f")
+	size_t decryptAVX512(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 16 <= blocks; done += 16) {
+			uint8_t* ptr = data + done * 8;
+			const __m512i low = _mm512_shuffle_epi32(_mm512_loadu_si512(ptr), PERM_DEINTERLEAVE);
+			const __m512i high = _mm512_shuffle_epi32(_mm512_loadu_si512(ptr + 64), PERM_DEINTERLEAVE);
+			__m512i v0 = _mm512_unpacklo_epi64(low, high);
+			__m512i v1 = _mm512_unpackhi_epi64(low, high);
+			for (size_t i = 0; i < 32; ++i) {
+				v1 = _mm512_sub_epi32(v1, _mm512_xor_si512(mixAVX512(v0), _mm512_set1_epi32(static_cast<int>(keys.first[i]))));
+				v0 = _mm512_sub_epi32(v0, _mm512_xor_si512(mixAVX512(v1), _mm512_set1_epi32(static_cast<int>(keys.second[i]))));
+			}
+			_mm512_storeu_si512(ptr, _mm512_unpacklo_epi32(v0, v1));
+			_mm512_storeu_si512(ptr + 64, _mm512_unpackhi_epi32(v0, v1));
+		}
+		return done;
+	}
+#elif defined(XTEA_NEON)
+	inline uint32x4_t mixNEON(uint32x4_t v) {
+		return vaddq_u32(veorq_u32(vshlq_n_u32(v, 4), vshrq_n_u32(v, 5)), v);
+	}
+
+	// vld2q deinterleaves the first and second words of 4 blocks.
+	size_t encryptNEON(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 4 <= blocks; done += 4) {
+			auto* ptr = reinterpret_cast<uint32_t*>(data + done * 8);
+			uint32x4x2_t v = vld2q_u32(ptr);
+			for (size_t i = 0; i < 32; ++i) {
+				v.val[0] = vaddq_u32(v.val[0], veorq_u32(mixNEON(v.val[1]), vdupq_n_u32(keys.first[i])));
+				v.val[1] = vaddq_u32(v.val[1], veorq_u32(mixNEON(v.val[0]), vdupq_n_u32(keys.second[i])));
+			}
+			vst2q_u32(ptr, v);
+		}
+		return done;
+	}
+
+	size_t decryptNEON(uint8_t* data, size_t blocks, const RoundKeys &keys) {
+		size_t done = 0;
+		for (; done + 4 <= blocks; done += 4) {
+			auto* ptr = reinterpret_cast<uint32_t*>(data + done * 8);
+			uint32x4x2_t v = vld2q_u32(ptr);
+			for (size_t i = 0; i < 32; ++i) {
+				v.val[1] = vsubq_u32(v.val[1], veorq_u32(mixNEON(v.val[0]), vdupq_n_u32(keys.first[i])));
+				v.val[0] = vsubq_u32(v.val[0], veorq_u32(mixNEON(v.val[1]), vdupq_n_u32(keys.second[i])));
+			}
+			vst2q_u32(ptr, v);
+		}
+		return done;
+	}
+#endif
+}
+
+void xtea::encrypt(uint8_t* data, size_t length, const Key &key, SimdLevel level /* = getSimdLevel()*/) {
+	if (!isSimdLevelSupported(level)) {
+		level = SimdLevel::Scalar;
+	}
+
+	const RoundKeys keys = encryptKeys(key);
+	const size_t blocks = length / 8;
+	size_t done = 0;
+#if defined(XTEA_X86)
+	if (level >= SimdLevel::AVX512) {
+		done += encryptAVX512(data, blocks, keys);
+	}
+	if (level >= SimdLevel::AVX2) {
+		done += encryptAVX2(data + done * 8, blocks - done, keys);
+	}
+	if (level >= SimdLevel::SSE2) {
+		done += encryptSSE2(data + done * 8, blocks - done, keys);
+	}
+#elif defined(XTEA_NEON)
+	if (level == SimdLevel::NEON) {
+		done += encryptNEON(data, blocks, keys);
+	}
+#endif
+	encryptScalar(data + done * 8, blocks - done, keys);
+}
+
+void xtea::decrypt(uint8_t* data, size_t length, const Key &key, SimdLevel level /* = getSimdLevel()*/) {
+	if (!isSimdLevelSupported(level)) {
+		level = SimdLevel::Scalar;
+	}
+
+	const RoundKeys keys = decryptKeys(key);
+	const size_t blocks = length / 8;
+	size_t done = 0;
+#if defined(XTEA_X86)
+	if (level >= SimdLevel::AVX512) {
+		done += decryptAVX512(data, blocks, keys);
+	}
+	if (level >= SimdLevel::AVX2) {
+		done += decryptAVX2(data + done * 8, blocks - done, keys);
+	}
+	if (level >= SimdLevel::SSE2) {
+		done += decryptSSE2(data + done * 8, blocks - done, keys);
+	}
+#elif defined(XTEA_NEON)
+	if (level == SimdLevel::NEON) {
+		done += decryptNEON(data, blocks, keys);
+	}
+#endif
+	decryptScalar(data + done * 8, blocks - done, keys);
+}
@@ -0,0 +1,27 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "utils/simd.hpp"
+
+/**
+ * XTEA as used by the game protocol: 32 rounds, little endian blocks of 8 bytes.
+ *
+ * Blocks are independent, so the vector kernels encrypt several of them at once
+ * (4 with SSE2 and NEON, 8 with AVX2, 16 with AVX-512) and the remaining ones go
+ * through the narrower kernels. The kernel is picked at runtime from getSimdLevel().
+ */
+namespace xtea {
+	using Key = std::array<uint32_t, 4>;
+
+	// The length must be a multiple of 8, the data is encrypted in place.
+	void encrypt(uint8_t* data, size_t length, const Key &key, SimdLevel level = getSimdLevel());
+	void decrypt(uint8_t* data, size_t length, const Key &key, SimdLevel level = getSimdLevel());
+}
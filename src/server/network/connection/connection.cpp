@@ -43,24 +43,52 @@ void ConnectionManager::closeAll() {
 	connections.clear();
 }
 
+void Connection::MessageQueue::push(const OutputMessage_ptr &message) {
+	if (count == buffer.size()) {
+		// Capacity stays a power of two, so the index wraps with a mask
+		std::vector<OutputMessage_ptr> grown(std::max<size_t>(16, buffer.size() * 2));
+		for (size_t i = 0; i < count; ++i) {
+			grown[i] = std::move(buffer[(head + i) & (buffer.size() - 1)]);
+		}
+		buffer = std::move(grown);
+		head = 0;
+	}
+
+	buffer[(head + count) & (buffer.size() - 1)] = message;
+	++count;
+}
+
+void Connection::MessageQueue::pop(size_t n) {
+	n = std::min(n, count);
+	for (size_t i = 0; i < n; ++i) {
+		buffer[head].reset();
+		head = (head + 1) & (buffer.size() - 1);
+	}
+	count -= n;
+}
+
 Connection::Connection(asio::io_service &initIoService, ConstServicePort_ptr initservicePort) :
-	readTimer(initIoService),
-	writeTimer(initIoService),
+	strand(asio::make_strand(initIoService)),
+	readTimer(strand),
+	writeTimer(strand),
 	service_port(std::move(initservicePort)),
-	socket(initIoService) {
+	socket(strand) {
+	writeBuffers.reserve(MAX_WRITE_BUFFERS);
 }
 
 void Connection::close(bool force) {
 	ConnectionManager::getInstance().releaseConnection(shared_from_this());
 
-	std::scoped_lock lock(connectionLock);
 	ip = 0;
 
-	if (connectionState == CONNECTION_STATE_CLOSED) {
+	if (connectionState.exchange(CONNECTION_STATE_CLOSED) == CONNECTION_STATE_CLOSED) {
 		return;
 	}
-	connectionState = CONNECTION_STATE_CLOSED;
 
+	asio::dispatch(strand, [self = shared_from_this(), force] { self->internalClose(force); });
+}
+
+void Connection::internalClose(bool force) {
 	if (protocol) {
 		g_dispatcher().addEvent([protocol = protocol] { protocol->release(); }, "Protocol::release", std::chrono::milliseconds(CONNECTION_WRITE_TIMEOUT * 1000).count());
 	}
@@ -121,7 +149,6 @@ void Connection::acceptInternal(bool toggleParseHeader) {
 	}
 }
 void Connection::parseProxyIdentification(const std::error_code &error) {
-	std::scoped_lock lock(connectionLock);
 	readTimer.cancel();
 
 	if (error || connectionState == CONNECTION_STATE_CLOSED) {
@@ -175,7 +202,6 @@ void Connection::parseProxyIdentification(const std::error_code &error) {
 }
 
 void Connection::parseHeader(const std::error_code &error) {
-	std::scoped_lock lock(connectionLock);
 	readTimer.cancel();
 
 	if (error) {
@@ -221,7 +247,6 @@ void Connection::parseHeader(const std::error_code &error) {
 }
 
 void Connection::parsePacket(const std::error_code &error) {
-	std::scoped_lock lock(connectionLock);
 	readTimer.cancel();
 
 	if (error || connectionState == CONNECTION_STATE_CLOSED) {
@@ -288,43 +313,51 @@ void Connection::parsePacket(const std::error_code &error) {
 }
 
 void Connection::resumeWork() {
-	readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
-	readTimer.async_wait([self = shared_from_this()](const std::error_code &error) { Connection::handleTimeout(std::weak_ptr<Connection>(self), error); });
-
-	try {
-		asio::async_read(socket, asio::buffer(msg.getBuffer(), HEADER_LENGTH), [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->parseHeader(error); });
-	} catch (const std::system_error &e) {
-		g_logger().error("[Connection::resumeWork] - Exception in async_read: {}", e.what());
-		close(FORCE_CLOSE);
-	}
+	asio::dispatch(strand, [self = shared_from_this()] {
+		self->readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
+		self->readTimer.async_wait([self](const std::error_code &error) { Connection::handleTimeout(std::weak_ptr<Connection>(self), error); });
+
+		try {
+			asio::async_read(self->socket, asio::buffer(self->msg.getBuffer(), HEADER_LENGTH), [self](const std::error_code &error, std::size_t N) { self->parseHeader(error); });
+		} catch (const std::system_error &e) {
+			g_logger().error("[Connection::resumeWork] - Exception in async_read: {}", e.what());
+			self->close(FORCE_CLOSE);
+		}
+	});
 }
 
 void Connection::send(const OutputMessage_ptr &outputMessage) {
-	std::scoped_lock lock(connectionLock);
 	if (connectionState == CONNECTION_STATE_CLOSED) {
 		return;
 	}
 
+	asio::dispatch(strand, [self = shared_from_this(), outputMessage] { self->enqueue(outputMessage); });
+}
+
+void Connection::enqueue(const OutputMessage_ptr &outputMessage) {
+	if (!socket.is_open()) {
+		if (connectionState != CONNECTION_STATE_CLOSED) {
+			g_logger().error("[Connection::send] - Socket is not open for writing.");
+			close(FORCE_CLOSE);
+		}
+		return;
+	}
+
 	bool noPendingWrite = messageQueue.empty();
-	messageQueue.emplace_back(outputMessage);
+	messageQueue.push(outputMessage);
 
 	if (noPendingWrite) {
-		if (socket.is_open()) {
-			try {
-				asio::post(socket.get_executor(), [self = shared_from_this()] { self->internalWorker(); });
-			} catch (const std::system_error &e) {
-				g_logger().error("[Connection::send] - Exception in posting write operation: {}", e.what());
-				close(FORCE_CLOSE);
-			}
-		} else {
-			g_logger().error("[Connection::send] - Socket is not open for writing.");
+		// Posted, the messages sent before the worker runs are written along with this one
+		try {
+			asio::post(strand, [self = shared_from_this()] { self->internalWorker(); });
+		} catch (const std::system_error &e) {
+			g_logger().error("[Connection::send] - Exception in posting write operation: {}", e.what());
 			close(FORCE_CLOSE);
 		}
 	}
 }
 
 void Connection::internalWorker() {
-	std::unique_lock lock(connectionLock);
 	if (messageQueue.empty()) {
 		if (connectionState == CONNECTION_STATE_CLOSED) {
 			closeSocket();
@@ -332,36 +365,42 @@ void Connection::internalWorker() {
 		return;
 	}
 
-	const auto &outputMessage = messageQueue.front();
-	lock.unlock();
-	protocol->onSendMessage(outputMessage);
-	lock.lock();
+	internalSend();
+}
 
-	internalSend(outputMessage);
+void Connection::readRemoteIP() {
+	std::error_code error;
+	asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(error);
+	if (error) {
+		g_logger().error("[Connection::readRemoteIP] - Failed to get remote endpoint: {}", error.message());
+		ip = 0;
+	} else {
+		ip = htonl(endpoint.address().to_v4().to_uint());
+	}
 }
 
-uint32_t Connection::getIP() {
-	std::scoped_lock lock(connectionLock);
+void Connection::internalSend() {
+	if (writingMessages != 0) {
+		return;
+	}
 
-	if (ip == 1) {
-		std::error_code error;
-		asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(error);
-		if (error) {
-			g_logger().error("[Connection::getIP] - Failed to get remote endpoint: {}", error.message());
-			ip = 0;
-		} else {
-			ip = htonl(endpoint.address().to_v4().to_uint());
-		}
+	const size_t count = std::min(messageQueue.size(), MAX_WRITE_BUFFERS);
+	for (; preparedMessages < count; ++preparedMessages) {
+		protocol->onSendMessage(messageQueue[preparedMessages]);
 	}
-	return ip;
-}
 
-void Connection::internalSend(const OutputMessage_ptr &outputMessage) {
+	writeBuffers.clear();
+	for (size_t i = 0; i < count; ++i) {
+		const auto &outputMessage = messageQueue[i];
+		writeBuffers.emplace_back(outputMessage->getOutputBuffer(), outputMessage->getLength());
+	}
+	writingMessages = count;
+
 	writeTimer.expires_from_now(std::chrono::seconds(CONNECTION_WRITE_TIMEOUT));
-	readTimer.async_wait([self = shared_from_this()](const std::error_code &error) { Connection::handleTimeout(std::weak_ptr<Connection>(self), error); });
+	writeTimer.async_wait([self = shared_from_this()](const std::error_code &error) { Connection::handleTimeout(std::weak_ptr<Connection>(self), error); });
 
 	try {
-		asio::async_write(socket, asio::buffer(outputMessage->getOutputBuffer(), outputMessage->getLength()), [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->onWriteOperation(error); });
+		asio::async_write(socket, writeBuffers, [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->onWriteOperation(error); });
 	} catch (const std::system_error &e) {
 		g_logger().error("[Connection::internalSend] - Exception in async_write: {}", e.what());
 		close(FORCE_CLOSE);
@@ -369,24 +408,23 @@ void Connection::internalSend(const OutputMessage_ptr &outputMessage) {
 }
 
 void Connection::onWriteOperation(const std::error_code &error) {
-	std::unique_lock lock(connectionLock);
 	writeTimer.cancel();
 
 	if (error) {
 		g_logger().error("[Connection::onWriteOperation] - Write error: {}", error.message());
 		messageQueue.clear();
+		preparedMessages = 0;
+		writingMessages = 0;
 		close(FORCE_CLOSE);
 		return;
 	}
 
-	messageQueue.pop_front();
+	messageQueue.pop(writingMessages);
+	preparedMessages -= writingMessages;
+	writingMessages = 0;
 
 	if (!messageQueue.empty()) {
-		const auto &outputMessage = messageQueue.front();
-		lock.unlock();
-		protocol->onSendMessage(outputMessage);
-		lock.lock();
-		internalSend(outputMessage);
+		internalSend();
 	} else if (connectionState == CONNECTION_STATE_CLOSED) {
 		closeSocket();
 	}
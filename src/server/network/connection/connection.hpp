@@ -45,6 +45,14 @@ private:
 	phmap::parallel_flat_hash_set_m<Connection_ptr> connections;
 };
 
+/**
+ * Connection I/O runs on a strand: the socket and the timers use it as their executor, so every
+ * completion handler is serialized without a lock. Calls made from other threads (send, close,
+ * resumeWork) are posted to it.
+ *
+ * Messages waiting to be written are kept in a ring buffer. When the socket is free, every
+ * message queued meanwhile is written by a single scatter/gather async_write.
+ */
 class Connection : public std::enable_shared_from_this<Connection> {
 public:
 	// Constructor
@@ -67,9 +75,44 @@ public:
 
 	void send(const OutputMessage_ptr &outputMessage);
 
-	uint32_t getIP();
+	// Cached when accepted, 0 once closed.
+	uint32_t getIP() const {
+		return ip;
+	}
 
 private:
+	// Growable ring buffer of the messages waiting to be written, it only allocates when it grows.
+	class MessageQueue {
+	public:
+		[[nodiscard]] bool empty() const {
+			return count == 0;
+		}
+		[[nodiscard]] size_t size() const {
+			return count;
+		}
+
+		const OutputMessage_ptr &operator[](size_t index) const {
+			return buffer[(head + index) & (buffer.size() - 1)];
+		}
+
+		void push(const OutputMessage_ptr &message);
+		void pop(size_t n);
+		void clear() {
+			pop(count);
+		}
+
+	private:
+		std::vector<OutputMessage_ptr> buffer;
+		size_t head = 0;
+		size_t count = 0;
+	};
+
+	// Most messages written by a single async_write, the remaining ones go in the next write.
+	static constexpr size_t MAX_WRITE_BUFFERS = 64;
+
+	void enqueue(const OutputMessage_ptr &outputMessage);
+	void internalClose(bool force);
+
 	void parseProxyIdentification(const std::error_code &error);
 	void parseHeader(const std::error_code &error);
 	void parsePacket(const std::error_code &error);
@@ -78,22 +121,30 @@ private:
 
 	static void handleTimeout(ConnectionWeak_ptr connectionWeak, const std::error_code &error);
 
+	// Runs on the strand once accepted, before anything else may use the socket.
+	void readRemoteIP();
+
 	void closeSocket();
 	void internalWorker();
-	void internalSend(const OutputMessage_ptr &outputMessage);
+	void internalSend();
 
 	asio::ip::tcp::socket &getSocket() {
 		return socket;
 	}
 
+	asio::strand<asio::io_context::executor_type> strand;
+
 	NetworkMessage msg;
 
 	asio::high_resolution_timer readTimer;
 	asio::high_resolution_timer writeTimer;
 
-	std::recursive_mutex connectionLock;
-
-	std::list<OutputMessage_ptr> messageQueue;
+	MessageQueue messageQueue;
+	// Messages prepared by Protocol::onSendMessage, at the front of the queue.
+	size_t preparedMessages = 0;
+	// Messages at the front of the queue being written.
+	size_t writingMessages = 0;
+	std::vector<asio::const_buffer> writeBuffers;
 
 	ConstServicePort_ptr service_port;
 	Protocol_ptr protocol;
@@ -102,9 +153,9 @@ private:
 
 	std::time_t timeConnected = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 	uint32_t packetsSent = 0;
-	uint32_t ip = 1;
+	std::atomic<uint32_t> ip = 0;
 
-	std::underlying_type_t<ConnectionState_t> connectionState = CONNECTION_STATE_OPEN;
+	std::atomic<std::underlying_type_t<ConnectionState_t>> connectionState = CONNECTION_STATE_OPEN;
 	bool receivedFirst = false;
 
 	friend class ServicePort;
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "server/network/message/networkmessage.hpp"
+#include "server/network/message/packet_fragment.hpp"
 #include "server/network/connection/connection.hpp"
 #include "utils/tools.hpp"
 
@@ -53,6 +54,13 @@ public:
 		info.position += msgLen;
 	}
 
+	void append(const PacketFragment &fragment) {
+		auto msgLen = fragment.getLength();
+		memcpy(buffer + info.position, fragment.getBuffer(), msgLen);
+		info.length += msgLen;
+		info.position += msgLen;
+	}
+
 private:
 	template <typename T>
 	void add_header(T addHeader) {
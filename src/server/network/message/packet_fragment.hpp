@@ -0,0 +1,95 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "game/movement/position.hpp"
+
+/**
+ * Bytes of a packet encoded ahead of time, appended as they are to an OutputMessage.
+ *
+ * It uses the same write functions as NetworkMessage, but holds only the few bytes of
+ * a single packet, so it is cheap to build on the stack.
+ */
+class PacketFragment {
+public:
+	static constexpr size_t CAPACITY = 64;
+
+	void addByte(uint8_t value) {
+		if (!canAdd(1)) {
+			return;
+		}
+
+		buffer[length++] = value;
+	}
+
+	template <typename T>
+	void add(T value) {
+		if (!canAdd(sizeof(T))) {
+			return;
+		}
+
+		memcpy(buffer.data() + length, &value, sizeof(T));
+		length += sizeof(T);
+	}
+
+	void addPosition(const Position &pos) {
+		add<uint16_t>(pos.x);
+		add<uint16_t>(pos.y);
+		addByte(pos.z);
+	}
+
+	const uint8_t* getBuffer() const {
+		return buffer.data();
+	}
+
+	uint16_t getLength() const {
+		return length;
+	}
+
+private:
+	bool canAdd(size_t size) const {
+		return length + size <= CAPACITY;
+	}
+
+	std::array<uint8_t, CAPACITY> buffer;
+	uint16_t length = 0;
+};
+
+/**
+ * Packet sent unchanged to every spectator of an event.
+ *
+ * The fragment is encoded by the first spectator using each client flavour (old and
+ * current protocol) and then only copied into the output message of the others.
+ * Anything that depends on the receiver, like the known creatures or the encryption,
+ * stays in ProtocolGame.
+ */
+class BroadcastPacket {
+public:
+	using Encoder = std::function<void(PacketFragment &fragment, bool oldProtocol)>;
+
+	explicit BroadcastPacket(Encoder encoder) :
+		encoder(std::move(encoder)) { }
+
+	// Ensures that we don't accidentally copy it
+	BroadcastPacket(const BroadcastPacket &) = delete;
+	BroadcastPacket &operator=(const BroadcastPacket &) = delete;
+
+	const PacketFragment &get(bool oldProtocol) {
+		auto &fragment = fragments[oldProtocol ? 1 : 0];
+		if (!fragment) {
+			encoder(fragment.emplace(), oldProtocol);
+		}
+		return *fragment;
+	}
+
+private:
+	Encoder encoder;
+	std::array<std::optional<PacketFragment>, 2> fragments;
+};
@@ -12,11 +12,13 @@
 #include "server/network/protocol/protocol.hpp"
 #include "server/network/message/outputmessage.hpp"
 #include "security/rsa.hpp"
+#include "security/xtea.hpp"
 #include "game/scheduling/dispatcher.hpp"
+#include "lib/metrics/metrics.hpp"
 
 void Protocol::onSendMessage(const OutputMessage_ptr &msg) {
 	if (!rawMessages) {
-		const uint32_t sendMessageChecksum = msg->getLength() >= 128 && compression(*msg) ? (1U << 31) : 0;
+		const uint32_t sendMessageChecksum = compression(*msg) ? (1U << 31) : 0;
 
 		msg->writeMessageLength();
 
@@ -106,36 +108,13 @@ OutputMessage_ptr Protocol::getOutputBuffer(int32_t size) {
 }
 
 void Protocol::XTEA_encrypt(OutputMessage &msg) const {
-	const uint32_t delta = 0x61C88647;
-
 	// The message must be a multiple of 8
 	size_t paddingBytes = msg.getLength() & 7;
 	if (paddingBytes != 0) {
 		msg.addPaddingBytes(8 - paddingBytes);
 	}
 
-	uint8_t* buffer = msg.getOutputBuffer();
-	auto messageLength = static_cast<int32_t>(msg.getLength());
-	int32_t readPos = 0;
-	const std::array<uint32_t, 4> newKey = { key[0], key[1], key[2], key[3] };
-	// TODO: refactor this for not use c-style
-	uint32_t precachedControlSum[32][2];
-	uint32_t sum = 0;
-	for (int32_t i = 0; i < 32; ++i) {
-		precachedControlSum[i][0] = (sum + newKey[sum & 3]);
-		sum -= delta;
-		precachedControlSum[i][1] = (sum + newKey[(sum >> 11) & 3]);
-	}
-	while (readPos < messageLength) {
-		std::array<uint32_t, 2> vData = {};
-		memcpy(vData.data(), buffer + readPos, 8);
-		for (int32_t i = 0; i < 32; ++i) {
-			vData[0] += ((vData[1] << 4 ^ vData[1] >> 5) + vData[1]) ^ precachedControlSum[i][0];
-			vData[1] += ((vData[0] << 4 ^ vData[0] >> 5) + vData[0]) ^ precachedControlSum[i][1];
-		}
-		memcpy(buffer + readPos, vData.data(), 8);
-		readPos += 8;
-	}
+	xtea::encrypt(msg.getOutputBuffer(), msg.getLength(), key);
 }
 
 bool Protocol::XTEA_decrypt(NetworkMessage &msg) const {
@@ -144,30 +123,7 @@ bool Protocol::XTEA_decrypt(NetworkMessage &msg) const {
 		return false;
 	}
 
-	const uint32_t delta = 0x61C88647;
-
-	uint8_t* buffer = msg.getBuffer() + msg.getBufferPosition();
-	auto messageLength = static_cast<int32_t>(msgLength);
-	int32_t readPos = 0;
-	const std::array<uint32_t, 4> newKey = { key[0], key[1], key[2], key[3] };
-	// TODO: refactor this for not use c-style
-	uint32_t precachedControlSum[32][2];
-	uint32_t sum = 0xC6EF3720;
-	for (int32_t i = 0; i < 32; ++i) {
-		precachedControlSum[i][0] = (sum + newKey[(sum >> 11) & 3]);
-		sum += delta;
-		precachedControlSum[i][1] = (sum + newKey[sum & 3]);
-	}
-	while (readPos < messageLength) {
-		std::array<uint32_t, 2> vData = {};
-		memcpy(vData.data(), buffer + readPos, 8);
-		for (int32_t i = 0; i < 32; ++i) {
-			vData[1] -= ((vData[0] << 4 ^ vData[0] >> 5) + vData[0]) ^ precachedControlSum[i][0];
-			vData[0] -= ((vData[1] << 4 ^ vData[1] >> 5) + vData[1]) ^ precachedControlSum[i][1];
-		}
-		memcpy(buffer + readPos, vData.data(), 8);
-		readPos += 8;
-	}
+	xtea::decrypt(msg.getBuffer() + msg.getBufferPosition(), msgLength, key);
 
 	uint16_t innerLength = msg.get<uint16_t>();
 	if (std::cmp_greater(innerLength, msgLength - 2)) {
@@ -197,41 +153,118 @@ uint32_t Protocol::getIP() const {
 	return 0;
 }
 
-bool Protocol::compression(OutputMessage &msg) const {
+namespace {
+	// Compression metrics are summed per network thread and reported once per second.
+	struct CompressionStats {
+		uint64_t bytesSaved = 0;
+		std::chrono::nanoseconds cpuTime {};
+		std::chrono::steady_clock::time_point lastReport = std::chrono::steady_clock::now();
+
+		void add(uint32_t inputSize, uint32_t outputSize, std::chrono::nanoseconds elapsed) {
+			bytesSaved += inputSize > outputSize ? inputSize - outputSize : 0;
+			cpuTime += elapsed;
+
+			const auto now = std::chrono::steady_clock::now();
+			if (now - lastReport < std::chrono::seconds(1)) {
+				return;
+			}
+
+			lastReport = now;
+			g_metrics().addCounter("compression_bytes_saved", static_cast<double>(bytesSaved));
+			g_metrics().addCounter("compression_cpu_us", std::chrono::duration<double, std::micro>(cpuTime).count());
+			bytesSaved = 0;
+			cpuTime = {};
+		}
+	};
+
+	thread_local CompressionStats compressionStats;
+	thread_local std::array<char, NETWORKMESSAGE_MAXSIZE> compressionBuffer;
+}
+
+void Protocol::updateCompressionRatio(uint32_t inputSize, uint32_t outputSize) {
+	auto &state = compressionState;
+	state.ratio = state.ratio * 0.75f + (static_cast<float>(outputSize) / inputSize) * 0.25f;
+	if (state.ratio > CompressionState::MAX_RATIO) {
+		state.skip = CompressionState::SKIPPED_PACKETS;
+		// Probed again after the skipped packets, a few bad ones are enough to skip again
+		state.ratio = 0.9f;
+	}
+}
+
+bool Protocol::compression(OutputMessage &msg) {
 	if (checksumMethod != CHECKSUM_METHOD_SEQUENCE) {
 		return false;
 	}
 
-	static const thread_local auto &compress = std::make_unique<ZStream>();
-	if (!compress->stream) {
+	auto &state = compressionState;
+	static const bool useStream = g_configManager().getBoolean(TOGGLE_COMPRESSION_STREAMING, __FUNCTION__);
+	// The client inflates one stream, a message compressed on its own would end it
+	if (state.streamingFailed) {
 		return false;
 	}
 
 	const auto outputMessageSize = msg.getLength();
-	if (outputMessageSize > NETWORKMESSAGE_MAXSIZE) {
-		g_logger().error("[NetworkMessage::compression] - Exceded NetworkMessage max size: {}, actually size: {}", NETWORKMESSAGE_MAXSIZE, outputMessageSize);
+	if (outputMessageSize < (useStream ? CompressionState::MIN_STREAMING_SIZE : CompressionState::MIN_SIZE)) {
 		return false;
 	}
 
-	compress->stream->next_in = msg.getOutputBuffer();
-	compress->stream->avail_in = outputMessageSize;
-	compress->stream->next_out = reinterpret_cast<Bytef*>(compress->buffer.data());
-	compress->stream->avail_out = NETWORKMESSAGE_MAXSIZE;
+	if (state.skip > 0) {
+		--state.skip;
+		return false;
+	}
 
-	const int32_t ret = deflate(compress->stream.get(), Z_FINISH);
-	if (ret != Z_OK && ret != Z_STREAM_END) {
+	if (outputMessageSize > NETWORKMESSAGE_MAXSIZE) {
+		g_logger().error("[NetworkMessage::compression] - Exceded NetworkMessage max size: {}, actually size: {}", NETWORKMESSAGE_MAXSIZE, outputMessageSize);
 		return false;
 	}
 
-	const auto totalSize = compress->stream->total_out;
-	deflateReset(compress->stream.get());
+	ZStream* compress;
+	if (useStream) {
+		if (!state.stream) {
+			state.stream = std::make_unique<ZStream>(CompressionState::STREAMING_WINDOW_BITS, CompressionState::STREAMING_MEM_LEVEL);
+		}
+		compress = state.stream.get();
+	} else {
+		static const thread_local auto &messageStream = std::make_unique<ZStream>();
+		compress = messageStream.get();
+	}
 
-	if (totalSize == 0) {
+	if (!compress->stream) {
 		return false;
 	}
 
+	const auto start = std::chrono::steady_clock::now();
+	z_stream* stream = compress->stream.get();
+	stream->next_in = msg.getOutputBuffer();
+	stream->avail_in = outputMessageSize;
+	stream->next_out = reinterpret_cast<Bytef*>(compressionBuffer.data());
+	stream->avail_out = NETWORKMESSAGE_MAXSIZE;
+
+	const int32_t ret = deflate(stream, useStream ? Z_SYNC_FLUSH : Z_FINISH);
+	const uint32_t totalSize = NETWORKMESSAGE_MAXSIZE - stream->avail_out;
+
+	if (useStream) {
+		if (ret != Z_OK || stream->avail_in != 0 || stream->avail_out == 0) {
+			// The client never gets these bytes, so nothing can be compressed on this stream anymore
+			g_logger().error("[Protocol::compression] - Streaming deflate failed ({}), the connection is no longer compressed", ret);
+			state.streamingFailed = true;
+			state.stream.reset();
+			return false;
+		}
+	} else {
+		deflateReset(stream);
+		if ((ret != Z_OK && ret != Z_STREAM_END) || totalSize == 0 || totalSize >= outputMessageSize) {
+			// Doesn't pay off, each message is compressed on its own so it can be sent as it is
+			updateCompressionRatio(outputMessageSize, outputMessageSize);
+			return false;
+		}
+	}
+
+	updateCompressionRatio(outputMessageSize, totalSize);
+	compressionStats.add(outputMessageSize, totalSize, std::chrono::steady_clock::now() - start);
+
 	msg.reset();
-	msg.addBytes(compress->buffer.data(), totalSize);
+	msg.addBytes(compressionBuffer.data(), totalSize);
 
 	return true;
 }
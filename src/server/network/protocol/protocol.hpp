@@ -82,7 +82,7 @@ protected:
 
 private:
 	struct ZStream {
-		ZStream() noexcept {
+		explicit ZStream(int32_t windowBits = -15, int32_t memLevel = 9) noexcept {
 			const int32_t compressionLevel = g_configManager().getNumber(COMPRESSION_LEVEL, __FUNCTION__);
 			if (compressionLevel <= 0) {
 				return;
@@ -93,28 +93,60 @@ private:
 			stream->zfree = nullptr;
 			stream->opaque = nullptr;
 
-			if (deflateInit2(stream.get(), compressionLevel, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
-				stream.reset();
+			if (deflateInit2(stream.get(), compressionLevel, Z_DEFLATED, windowBits, memLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
 				g_logger().error("[Protocol::enableCompression()] - Zlib deflateInit2 error: {}", (stream->msg ? stream->msg : " unknown error"));
+				stream.reset();
 			}
 		}
 
 		~ZStream() {
-			deflateEnd(stream.get());
+			if (stream) {
+				deflateEnd(stream.get());
+			}
 		}
 
 		std::unique_ptr<z_stream> stream;
-		std::array<char, NETWORKMESSAGE_MAXSIZE> buffer {};
+	};
+
+	/**
+	 * Per connection compression state.
+	 *
+	 * In streaming mode the connection owns its deflate stream and flushes it with Z_SYNC_FLUSH,
+	 * so the window (the previous packets) is kept and even small packets compress well. Once a
+	 * packet was compressed in that mode it must be sent compressed, the client stream would
+	 * miss its bytes otherwise.
+	 *
+	 * The ratio of the last compressed packets is tracked: when compression stops paying off
+	 * (already compressed or random data), it is skipped for a while and probed again later.
+	 */
+	struct CompressionState {
+		// Packets smaller than this are sent as they are
+		static constexpr uint16_t MIN_SIZE = 128;
+		static constexpr uint16_t MIN_STREAMING_SIZE = 32;
+		// A smaller window than the message mode, each connection keeps its own stream
+		static constexpr int32_t STREAMING_WINDOW_BITS = -13;
+		static constexpr int32_t STREAMING_MEM_LEVEL = 7;
+		// Compressed / original size above which compressing is not worth the CPU
+		static constexpr float MAX_RATIO = 0.95f;
+		static constexpr uint16_t SKIPPED_PACKETS = 64;
+
+		std::unique_ptr<ZStream> stream;
+		float ratio = 0.5f;
+		uint16_t skip = 0;
+		// Set once the stream broke, nothing is compressed on the connection afterwards
+		bool streamingFailed = false;
 	};
 
 	void XTEA_encrypt(OutputMessage &msg) const;
 	bool XTEA_decrypt(NetworkMessage &msg) const;
-	bool compression(OutputMessage &msg) const;
+	bool compression(OutputMessage &msg);
+	void updateCompressionRatio(uint32_t inputSize, uint32_t outputSize);
 
 	OutputMessage_ptr outputBuffer;
 
 	const ConnectionWeak_ptr connectionPtr;
 	std::array<uint32_t, 4> key = {};
+	CompressionState compressionState;
 	uint32_t serverSequenceNumber = 0;
 	uint32_t clientSequenceNumber = 0;
 	std::underlying_type_t<ChecksumMethods_t> checksumMethod = CHECKSUM_METHOD_NONE;
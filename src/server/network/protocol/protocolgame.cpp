@@ -49,6 +49,10 @@
 // This "getIteration" function will allow us to get the total number of iterations that run within a specific map
 // Very useful to send the total amount in certain bytes in the ProtocolGame class
 namespace {
+	uint8_t getHealthPercent(const std::shared_ptr<Creature> &creature) {
+		return static_cast<uint8_t>(std::min<double>(100, std::ceil((static_cast<double>(creature->getHealth()) / std::max<int32_t>(creature->getMaxHealth(), 1)) * 100)));
+	}
+
 	template <typename T>
 	uint16_t getIterationIncreaseCount(T &map) {
 		uint16_t totalIterationCount = 0;
@@ -571,46 +575,18 @@ void ProtocolGame::login(const std::string &name, uint32_t accountId, OperatingS
 			return;
 		}
 
-		if (!IOLoginData::loadPlayerById(player, player->getGUID(), false)) {
-			g_game().removePlayerUniqueLogin(player);
-			disconnectClient("Your character could not be loaded.");
-			g_logger().warn("Player {} could not be loaded", player->getName());
-			return;
-		}
-
-		player->setOperatingSystem(operatingSystem);
-
-		const auto tile = g_game().map.getOrCreateTile(player->getLoginPosition());
-		// moving from a pz tile to a non-pz tile
-		if (maxOnline > 1 && player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER && !tile->hasFlag(TILESTATE_PROTECTIONZONE)) {
-			auto maxOutsizePZ = g_configManager().getNumber(MAX_PLAYERS_OUTSIDE_PZ_PER_ACCOUNT, __FUNCTION__);
-			auto accountPlayers = g_game().getPlayersByAccount(player->getAccount());
-			int countOutsizePZ = 0;
-			for (const auto &accountPlayer : accountPlayers) {
-				if (accountPlayer != player && accountPlayer->getTile() && !accountPlayer->getTile()->hasFlag(TILESTATE_PROTECTIONZONE)) {
-					++countOutsizePZ;
-				}
+		// The dispatcher keeps running while the player tables are read, the login goes on in onPlayerLoaded
+		IOLoginData::loadPlayerAsync(
+			player,
+			[self = getThis(), loadingPlayer = player] { return self->isLoginPending(loadingPlayer); },
+			[self = getThis(), loadingPlayer = player, operatingSystem](bool success) {
+				self->onPlayerLoaded(loadingPlayer, operatingSystem, success);
 			}
-			if (countOutsizePZ >= maxOutsizePZ) {
-				g_game().removePlayerUniqueLogin(player);
-				disconnectClient(fmt::format("You can only have {} character{} from your account outside of a protection zone.", maxOutsizePZ == 1 ? "one" : std::to_string(maxOutsizePZ), maxOutsizePZ > 1 ? "s" : ""));
-				return;
-			}
-		}
-
-		if (!g_game().placeCreature(player, player->getLoginPosition()) && !g_game().placeCreature(player, player->getTemplePosition(), false, true)) {
-			g_game().removePlayerUniqueLogin(player);
-			disconnectClient("Temple position is wrong. Please, contact the administrator.");
-			g_logger().warn("Player {} temple position is wrong", player->getName());
-			return;
-		}
-
-		player->lastIP = player->getIP();
-		player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
-		acceptPackets = true;
+		);
+		return;
 	} else {
-		if (eventConnect != 0 || !g_configManager().getBoolean(REPLACE_KICK_ON_LOGIN, __FUNCTION__)) {
-			// Already trying to connect
+		if (eventConnect != 0 || !foundPlayer->getTile() || !g_configManager().getBoolean(REPLACE_KICK_ON_LOGIN, __FUNCTION__)) {
+			// Already trying to connect, or the player is still being loaded
 			disconnectClient("You are already logged in.");
 			return;
 		}
@@ -631,6 +607,67 @@ void ProtocolGame::login(const std::string &name, uint32_t accountId, OperatingS
 	sendBosstiaryCooldownTimer();
 }
 
+bool ProtocolGame::isLoginPending(const std::shared_ptr<Player> &loadingPlayer) const {
+	return !isConnectionExpired() && player == loadingPlayer;
+}
+
+void ProtocolGame::onPlayerLoaded(const std::shared_ptr<Player> &loadedPlayer, OperatingSystem_t operatingSystem, bool success) {
+	if (!isLoginPending(loadedPlayer)) {
+		// The client left while the player was being loaded
+		g_game().removePlayerUniqueLogin(loadedPlayer);
+		return;
+	}
+
+	if (!success) {
+		g_game().removePlayerUniqueLogin(player);
+		disconnectClient("Your character could not be loaded.");
+		g_logger().warn("Player {} could not be loaded", player->getName());
+		return;
+	}
+
+	player->setOperatingSystem(operatingSystem);
+
+	// Other characters of the account may have logged in while this one was loading
+	const auto maxOnline = g_configManager().getNumber(MAX_PLAYERS_PER_ACCOUNT, __FUNCTION__);
+	if (player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER && g_game().getPlayersByAccount(player->getAccount()).size() >= maxOnline) {
+		g_game().removePlayerUniqueLogin(player);
+		disconnectClient(fmt::format("You may only login with {} character{}\nof your account at the same time.", maxOnline, maxOnline > 1 ? "s" : ""));
+		return;
+	}
+
+	const auto tile = g_game().map.getOrCreateTile(player->getLoginPosition());
+	// moving from a pz tile to a non-pz tile
+	if (maxOnline > 1 && player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER && !tile->hasFlag(TILESTATE_PROTECTIONZONE)) {
+		auto maxOutsizePZ = g_configManager().getNumber(MAX_PLAYERS_OUTSIDE_PZ_PER_ACCOUNT, __FUNCTION__);
+		auto accountPlayers = g_game().getPlayersByAccount(player->getAccount());
+		int countOutsizePZ = 0;
+		for (const auto &accountPlayer : accountPlayers) {
+			if (accountPlayer != player && accountPlayer->getTile() && !accountPlayer->getTile()->hasFlag(TILESTATE_PROTECTIONZONE)) {
+				++countOutsizePZ;
+			}
+		}
+		if (countOutsizePZ >= maxOutsizePZ) {
+			g_game().removePlayerUniqueLogin(player);
+			disconnectClient(fmt::format("You can only have {} character{} from your account outside of a protection zone.", maxOutsizePZ == 1 ? "one" : std::to_string(maxOutsizePZ), maxOutsizePZ > 1 ? "s" : ""));
+			return;
+		}
+	}
+
+	if (!g_game().placeCreature(player, player->getLoginPosition()) && !g_game().placeCreature(player, player->getTemplePosition(), false, true)) {
+		g_game().removePlayerUniqueLogin(player);
+		disconnectClient("Temple position is wrong. Please, contact the administrator.");
+		g_logger().warn("Player {} temple position is wrong", player->getName());
+		return;
+	}
+
+	player->lastIP = player->getIP();
+	player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
+	acceptPackets = true;
+
+	OutputMessagePool::getInstance().addProtocolToAutosend(shared_from_this());
+	sendBosstiaryCooldownTimer();
+}
+
 void ProtocolGame::connect(const std::string &playerName, OperatingSystem_t operatingSystem) {
 	eventConnect = 0;
 
@@ -885,6 +922,75 @@ void ProtocolGame::writeToOutputBuffer(const NetworkMessage &msg) {
 	out->append(msg);
 }
 
+void ProtocolGame::writeToOutputBuffer(const PacketFragment &fragment) {
+	auto out = getOutputBuffer(fragment.getLength());
+	out->append(fragment);
+}
+
+BroadcastPacket ProtocolGame::magicEffectPacket(const Position &pos, uint16_t type) {
+	return BroadcastPacket([pos, type](PacketFragment &msg, bool oldProtocol) { encodeMagicEffect(msg, pos, type, oldProtocol); });
+}
+
+BroadcastPacket ProtocolGame::distanceShootPacket(const Position &from, const Position &to, uint16_t type) {
+	return BroadcastPacket([from, to, type](PacketFragment &msg, bool oldProtocol) { encodeDistanceShoot(msg, from, to, type, oldProtocol); });
+}
+
+BroadcastPacket ProtocolGame::creatureHealthPacket(const std::shared_ptr<Creature> &creature) {
+	const uint32_t creatureId = creature->getID();
+	const uint8_t healthPercent = getHealthPercent(creature);
+	return BroadcastPacket([creatureId, healthPercent](PacketFragment &msg, bool) { encodeCreatureHealth(msg, creatureId, healthPercent); });
+}
+
+BroadcastPacket ProtocolGame::changeSpeedPacket(const std::shared_ptr<Creature> &creature, uint16_t speed) {
+	const uint32_t creatureId = creature->getID();
+	const uint16_t baseSpeed = creature->getBaseSpeed();
+	return BroadcastPacket([creatureId, baseSpeed, speed](PacketFragment &msg, bool) { encodeChangeSpeed(msg, creatureId, baseSpeed, speed); });
+}
+
+void ProtocolGame::encodeMagicEffect(PacketFragment &msg, const Position &pos, uint16_t type, bool oldProtocol) {
+	if (oldProtocol) {
+		msg.addByte(0x83);
+		msg.addPosition(pos);
+		msg.addByte(static_cast<uint8_t>(type));
+	} else {
+		msg.addByte(0x83);
+		msg.addPosition(pos);
+		msg.addByte(MAGIC_EFFECTS_CREATE_EFFECT);
+		msg.add<uint16_t>(type);
+		msg.addByte(MAGIC_EFFECTS_END_LOOP);
+	}
+}
+
+void ProtocolGame::encodeDistanceShoot(PacketFragment &msg, const Position &from, const Position &to, uint16_t type, bool oldProtocol) {
+	if (oldProtocol) {
+		msg.addByte(0x85);
+		msg.addPosition(from);
+		msg.addPosition(to);
+		msg.addByte(static_cast<uint8_t>(type));
+	} else {
+		msg.addByte(0x83);
+		msg.addPosition(from);
+		msg.addByte(MAGIC_EFFECTS_CREATE_DISTANCEEFFECT);
+		msg.add<uint16_t>(type);
+		msg.addByte(static_cast<uint8_t>(static_cast<int8_t>(static_cast<int32_t>(to.x) - static_cast<int32_t>(from.x))));
+		msg.addByte(static_cast<uint8_t>(static_cast<int8_t>(static_cast<int32_t>(to.y) - static_cast<int32_t>(from.y))));
+		msg.addByte(MAGIC_EFFECTS_END_LOOP);
+	}
+}
+
+void ProtocolGame::encodeCreatureHealth(PacketFragment &msg, uint32_t creatureId, uint8_t healthPercent) {
+	msg.addByte(0x8C);
+	msg.add<uint32_t>(creatureId);
+	msg.addByte(healthPercent);
+}
+
+void ProtocolGame::encodeChangeSpeed(PacketFragment &msg, uint32_t creatureId, uint16_t baseSpeed, uint16_t speed) {
+	msg.addByte(0x8F);
+	msg.add<uint32_t>(creatureId);
+	msg.add<uint16_t>(baseSpeed);
+	msg.add<uint16_t>(speed);
+}
+
 void ProtocolGame::parsePacket(NetworkMessage &msg) {
 	if (!acceptPackets || g_game().getGameState() == GAME_STATE_SHUTDOWN || msg.getLength() <= 0) {
 		return;
@@ -5850,14 +5956,15 @@ void ProtocolGame::sendCancelTarget() {
 }
 
 void ProtocolGame::sendChangeSpeed(std::shared_ptr<Creature> creature, uint16_t speed) {
-	NetworkMessage msg;
-	msg.addByte(0x8F);
-	msg.add<uint32_t>(creature->getID());
-	msg.add<uint16_t>(creature->getBaseSpeed());
-	msg.add<uint16_t>(speed);
+	PacketFragment msg;
+	encodeChangeSpeed(msg, creature->getID(), creature->getBaseSpeed(), speed);
 	writeToOutputBuffer(msg);
 }
 
+void ProtocolGame::sendChangeSpeed(BroadcastPacket &packet) {
+	writeToOutputBuffer(packet.get(oldProtocol));
+}
+
 void ProtocolGame::sendCancelWalk() {
 	if (player) {
 		NetworkMessage msg;
@@ -5891,24 +5998,18 @@ void ProtocolGame::sendDistanceShoot(const Position &from, const Position &to, u
 	if (oldProtocol && type > 0xFF) {
 		return;
 	}
-	NetworkMessage msg;
-	if (oldProtocol) {
-		msg.addByte(0x85);
-		msg.addPosition(from);
-		msg.addPosition(to);
-		msg.addByte(static_cast<uint8_t>(type));
-	} else {
-		msg.addByte(0x83);
-		msg.addPosition(from);
-		msg.addByte(MAGIC_EFFECTS_CREATE_DISTANCEEFFECT);
-		msg.add<uint16_t>(type);
-		msg.addByte(static_cast<uint8_t>(static_cast<int8_t>(static_cast<int32_t>(to.x) - static_cast<int32_t>(from.x))));
-		msg.addByte(static_cast<uint8_t>(static_cast<int8_t>(static_cast<int32_t>(to.y) - static_cast<int32_t>(from.y))));
-		msg.addByte(MAGIC_EFFECTS_END_LOOP);
-	}
+	PacketFragment msg;
+	encodeDistanceShoot(msg, from, to, type, oldProtocol);
 	writeToOutputBuffer(msg);
 }
 
+void ProtocolGame::sendDistanceShoot(const Position &, const Position &, uint16_t type, BroadcastPacket &packet) {
+	if (oldProtocol && type > 0xFF) {
+		return;
+	}
+	writeToOutputBuffer(packet.get(oldProtocol));
+}
+
 void ProtocolGame::sendRestingStatus(uint8_t protection) {
 	if (oldProtocol || !player) {
 		return;
@@ -5959,21 +6060,18 @@ void ProtocolGame::sendMagicEffect(const Position &pos, uint16_t type) {
 		return;
 	}
 
-	NetworkMessage msg;
-	if (oldProtocol) {
-		msg.addByte(0x83);
-		msg.addPosition(pos);
-		msg.addByte(static_cast<uint8_t>(type));
-	} else {
-		msg.addByte(0x83);
-		msg.addPosition(pos);
-		msg.addByte(MAGIC_EFFECTS_CREATE_EFFECT);
-		msg.add<uint16_t>(type);
-		msg.addByte(MAGIC_EFFECTS_END_LOOP);
-	}
+	PacketFragment msg;
+	encodeMagicEffect(msg, pos, type, oldProtocol);
 	writeToOutputBuffer(msg);
 }
 
+void ProtocolGame::sendMagicEffect(const Position &pos, uint16_t type, BroadcastPacket &packet) {
+	if (!canSee(pos) || (oldProtocol && type > 0xFF)) {
+		return;
+	}
+	writeToOutputBuffer(packet.get(oldProtocol));
+}
+
 void ProtocolGame::removeMagicEffect(const Position &pos, uint16_t type) {
 	if (oldProtocol && type > 0xFF) {
 		return;
@@ -5994,16 +6092,17 @@ void ProtocolGame::sendCreatureHealth(std::shared_ptr<Creature> creature) {
 		return;
 	}
 
-	NetworkMessage msg;
-	msg.addByte(0x8C);
-	msg.add<uint32_t>(creature->getID());
+	PacketFragment msg;
+	encodeCreatureHealth(msg, creature->getID(), getHealthPercent(creature));
+	writeToOutputBuffer(msg);
+}
+
+void ProtocolGame::sendCreatureHealth(std::shared_ptr<Creature> creature, BroadcastPacket &packet) {
 	if (creature->isHealthHidden()) {
-		msg.addByte(0x00);
-	} else {
-		msg.addByte(static_cast<uint8_t>(std::min<double>(100, std::ceil((static_cast<double>(creature->getHealth()) / std::max<int32_t>(creature->getMaxHealth(), 1)) * 100))));
+		return;
 	}
 
-	writeToOutputBuffer(msg);
+	writeToOutputBuffer(packet.get(oldProtocol));
 }
 
 void ProtocolGame::sendPartyCreatureUpdate(std::shared_ptr<Creature> target) {
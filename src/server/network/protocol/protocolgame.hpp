@@ -13,6 +13,7 @@
 #include "creatures/interactions/chat.hpp"
 #include "creatures/creature.hpp"
 #include "enums/forge_conversion.hpp"
+#include "server/network/message/packet_fragment.hpp"
 
 class NetworkMessage;
 class Player;
@@ -72,13 +73,28 @@ public:
 		return version;
 	}
 
+	// Packets encoded once for every spectator of an event
+	static BroadcastPacket magicEffectPacket(const Position &pos, uint16_t type);
+	static BroadcastPacket distanceShootPacket(const Position &from, const Position &to, uint16_t type);
+	static BroadcastPacket creatureHealthPacket(const std::shared_ptr<Creature> &creature);
+	static BroadcastPacket changeSpeedPacket(const std::shared_ptr<Creature> &creature, uint16_t speed);
+
 private:
 	ProtocolGame_ptr getThis() {
 		return std::static_pointer_cast<ProtocolGame>(shared_from_this());
 	}
+	// Whether the client is still connected and waiting for this player to be loaded.
+	bool isLoginPending(const std::shared_ptr<Player> &loadingPlayer) const;
+	void onPlayerLoaded(const std::shared_ptr<Player> &loadedPlayer, OperatingSystem_t operatingSystem, bool success);
 	void connect(const std::string &playerName, OperatingSystem_t operatingSystem);
 	void disconnectClient(const std::string &message) const;
 	void writeToOutputBuffer(const NetworkMessage &msg);
+	void writeToOutputBuffer(const PacketFragment &fragment);
+
+	static void encodeMagicEffect(PacketFragment &msg, const Position &pos, uint16_t type, bool oldProtocol);
+	static void encodeDistanceShoot(PacketFragment &msg, const Position &from, const Position &to, uint16_t type, bool oldProtocol);
+	static void encodeCreatureHealth(PacketFragment &msg, uint32_t creatureId, uint8_t healthPercent);
+	static void encodeChangeSpeed(PacketFragment &msg, uint32_t creatureId, uint16_t baseSpeed, uint16_t speed);
 
 	void release() override;
 
@@ -273,10 +289,13 @@ private:
 
 	void sendAllowBugReport();
 	void sendDistanceShoot(const Position &from, const Position &to, uint16_t type);
+	void sendDistanceShoot(const Position &from, const Position &to, uint16_t type, BroadcastPacket &packet);
 	void sendMagicEffect(const Position &pos, uint16_t type);
+	void sendMagicEffect(const Position &pos, uint16_t type, BroadcastPacket &packet);
 	void removeMagicEffect(const Position &pos, uint16_t type);
 	void sendRestingStatus(uint8_t protection);
 	void sendCreatureHealth(std::shared_ptr<Creature> creature);
+	void sendCreatureHealth(std::shared_ptr<Creature> creature, BroadcastPacket &packet);
 	void sendPartyCreatureUpdate(std::shared_ptr<Creature> target);
 	void sendPartyCreatureShield(std::shared_ptr<Creature> target);
 	void sendPartyCreatureSkull(std::shared_ptr<Creature> target);
@@ -296,6 +315,7 @@ private:
 
 	void sendCancelWalk();
 	void sendChangeSpeed(std::shared_ptr<Creature> creature, uint16_t speed);
+	void sendChangeSpeed(BroadcastPacket &packet);
 	void sendCancelTarget();
 	void sendCreatureOutfit(std::shared_ptr<Creature> creature, const Outfit_t &outfit);
 	void sendStats();
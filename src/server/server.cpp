@@ -89,7 +89,8 @@ void ServicePort::accept() {
 	}
 
 	auto connection = ConnectionManager::getInstance().createConnection(io_service, shared_from_this());
-	acceptor->async_accept(connection->getSocket(), [self = shared_from_this(), connection](const std::error_code &error) { self->onAccept(connection, error); });
+	// Completed on the connection strand, socket operations of the connection never run concurrently
+	acceptor->async_accept(connection->getSocket(), asio::bind_executor(connection->strand, [self = shared_from_this(), connection](const std::error_code &error) { self->onAccept(connection, error); }));
 }
 
 void ServicePort::onAccept(Connection_ptr connection, const std::error_code &error) {
@@ -98,6 +99,7 @@ void ServicePort::onAccept(Connection_ptr connection, const std::error_code &err
 			return;
 		}
 
+		connection->readRemoteIP();
 		auto remote_ip = connection->getIP();
 		if (remote_ip != 0 && inject<Ban>().acceptConnection(remote_ip)) {
 			Service_ptr service = services.front();
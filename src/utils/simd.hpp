@@ -64,3 +64,76 @@ __forceinline unsigned int _mm_ctz(unsigned int value) {
 #else
 	#define _mm_ctz __builtin_ctz
 #endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define SIMD_X86 1
+#endif
+
+// Lets a function use instructions the whole build isn't compiled for, it must only run after checking getSimdLevel().
+#if defined(SIMD_X86) && !defined(_MSC_VER)
+	#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+	#define SIMD_TARGET(isa)
+#endif
+
+enum class SimdLevel : uint8_t {
+	Scalar,
+	NEON,
+	SSE2,
+	AVX2,
+	AVX512,
+};
+
+// Best instruction set supported by the running CPU.
+inline SimdLevel detectSimdLevel() {
+#if defined(__DISABLE_VECTORIZATION__)
+	return SimdLevel::Scalar;
+#elif defined(__NEON__) || defined(__aarch64__)
+	return SimdLevel::NEON;
+#elif defined(SIMD_X86) && defined(_MSC_VER)
+	int info[4] = {};
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+	__cpuid(info, 1);
+	const bool sse2 = (info[3] & (1 << 26)) != 0;
+	const bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+	if (maxLeaf >= 7 && osSavesAvx) {
+		__cpuidex(info, 7, 0);
+		if ((info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6) {
+			return SimdLevel::AVX512;
+		}
+		if ((info[1] & (1 << 5)) != 0) {
+			return SimdLevel::AVX2;
+		}
+	}
+	return sse2 ? SimdLevel::SSE2 : SimdLevel::Scalar;
+#elif defined(SIMD_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return SimdLevel::AVX512;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return SimdLevel::AVX2;
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		return SimdLevel::SSE2;
+	}
+	return SimdLevel::Scalar;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+inline SimdLevel getSimdLevel() {
+	static const SimdLevel level = detectSimdLevel();
+	return level;
+}
+
+inline bool isSimdLevelSupported(SimdLevel level) {
+	const SimdLevel supported = getSimdLevel();
+	if (level == SimdLevel::Scalar || level == supported) {
+		return true;
+	}
+	// x86 levels include the ones below them
+	return level >= SimdLevel::SSE2 && supported >= SimdLevel::SSE2 && level <= supported;
+}
@@ -0,0 +1,94 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "config/configmanager.hpp"
+#include "creatures/combat/combat.hpp"
+#include "creatures/monsters/monster.hpp"
+#include "creatures/monsters/monsters.hpp"
+#include "game/game.hpp"
+#include "utils/benchmark.hpp"
+
+using namespace boost::ut;
+
+namespace {
+	constexpr size_t CASTS = 2000;
+	constexpr uint32_t AREA_SIZE = 9;
+	const Position CENTER(1000, 1000, 7);
+
+	// A plain 9x9 square, one target on each cell.
+	std::unique_ptr<AreaCombat> createArea() {
+		std::list<uint32_t> cells(AREA_SIZE * AREA_SIZE, 1);
+		*std::next(cells.begin(), cells.size() / 2) = 3;
+
+		auto area = std::make_unique<AreaCombat>();
+		area->setupArea(cells, AREA_SIZE);
+		return area;
+	}
+
+	void loadDefaultConfig() {
+		const auto configFile = std::filesystem::temp_directory_path() / "canary_combat_benchmark.lua";
+		std::ofstream(configFile) << "-- defaults only\n";
+		g_configManager().setConfigFileLua(configFile.string());
+		g_configManager().load();
+	}
+
+	size_t placeTargets() {
+		auto mType = std::make_shared<MonsterType>("benchmark target");
+		mType->info.health = std::numeric_limits<int32_t>::max() / 2;
+		mType->info.healthMax = mType->info.health;
+
+		const int32_t half = AREA_SIZE / 2;
+		size_t targets = 0;
+		for (int32_t dy = -half; dy <= half; ++dy) {
+			for (int32_t dx = -half; dx <= half; ++dx) {
+				const Position pos(CENTER.x + dx, CENTER.y + dy, CENTER.z);
+				g_game().map.getOrCreateTile(pos);
+				targets += g_game().map.placeCreature(pos, std::make_shared<Monster>(mType), false, true);
+			}
+		}
+		return targets;
+	}
+}
+
+suite<"game"> combatAreaBenchmark = [] {
+	test("Combat::doCombatHealth area cast on 81 targets") = [] {
+		loadDefaultConfig();
+		const auto targets = placeTargets();
+		expect(ge(targets, 50u));
+
+		const auto area = createArea();
+
+		CombatParams params;
+		params.combatType = COMBAT_PHYSICALDAMAGE;
+
+		size_t tiles = 0;
+		Benchmark bm;
+		for (size_t i = 0; i < CASTS; ++i) {
+			CombatTileList tileList;
+			Combat::getCombatArea(CENTER, CENTER, area, tileList);
+			tiles += tileList.size();
+		}
+		double duration = bm.duration();
+		fmt::print("[Combat] area lookup: {} casts in {:.2f}ms, {:.1f}us per cast\n", CASTS, duration, duration * 1e3 / CASTS);
+		expect(eq(tiles, CASTS * AREA_SIZE * AREA_SIZE));
+
+		bm.start();
+		for (size_t i = 0; i < CASTS; ++i) {
+			CombatDamage damage;
+			damage.primary.type = COMBAT_PHYSICALDAMAGE;
+			damage.primary.value = -1;
+			Combat::doCombatHealth(nullptr, CENTER, area, damage, params);
+		}
+		duration = bm.duration();
+		fmt::print("[Combat] doCombatHealth: {} casts on {} targets in {:.2f}ms, {:.1f}us per cast\n", CASTS, targets, duration, duration * 1e3 / CASTS);
+	};
+};
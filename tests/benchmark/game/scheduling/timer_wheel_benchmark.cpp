@@ -0,0 +1,137 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "game/scheduling/dispatcher.hpp"
+#include "game/scheduling/timer_wheel.hpp"
+#include "utils/tools.hpp"
+
+using namespace boost::ut;
+
+namespace {
+	constexpr size_t TASKS = 200000;
+	constexpr uint32_t MAX_DELAY = 60000;
+
+	// The scheduled events storage used by the Dispatcher before the timer wheel.
+	class HeapScheduler {
+	public:
+		uint64_t schedule(Task &&task) {
+			const auto eventId = ++lastEventId;
+			const auto &ptr = scheduledTasks.emplace(std::make_shared<Task>(std::move(task)));
+			scheduledTasksRef.emplace(eventId, *ptr);
+			return eventId;
+		}
+
+		void cancel(uint64_t eventId) {
+			const auto it = scheduledTasksRef.find(eventId);
+			if (it != scheduledTasksRef.end()) {
+				it->second->cancel();
+				scheduledTasksRef.erase(it);
+			}
+		}
+
+		void expire(int64_t now) {
+			auto it = scheduledTasks.begin();
+			while (it != scheduledTasks.end() && (*it)->getTime() <= now) {
+				(*it)->execute();
+				++it;
+			}
+			scheduledTasks.erase(scheduledTasks.begin(), it);
+		}
+
+		bool empty() const {
+			return scheduledTasks.empty();
+		}
+
+	private:
+		struct Compare {
+			bool operator()(const std::shared_ptr<Task> &a, const std::shared_ptr<Task> &b) const {
+				return a->getTime() < b->getTime();
+			}
+		};
+
+		phmap::btree_multiset<std::shared_ptr<Task>, Compare> scheduledTasks;
+		phmap::parallel_flat_hash_map_m<uint64_t, std::shared_ptr<Task>> scheduledTasksRef;
+		uint64_t lastEventId = 0;
+	};
+
+	std::vector<uint32_t> generateDelays() {
+		std::mt19937 generator(TASKS);
+		std::uniform_int_distribution<uint32_t> distribution(0, MAX_DELAY);
+
+		std::vector<uint32_t> delays(TASKS);
+		std::ranges::generate(delays, [&] { return distribution(generator); });
+		return delays;
+	}
+
+	// Schedules every task, cancels one of each four and then expires them in SCHEDULER_MINTICKS steps.
+	template <typename Schedule, typename Cancel, typename Expire>
+	double run(const std::vector<uint32_t> &delays, Schedule &&schedule, Cancel &&cancel, Expire &&expire) {
+		const auto start = OTSYS_TIME();
+		std::vector<uint64_t> eventIds;
+		eventIds.reserve(delays.size());
+
+		Benchmark bm;
+		for (const auto delay : delays) {
+			eventIds.emplace_back(schedule(delay));
+		}
+
+		for (size_t i = 0; i < eventIds.size(); i += 4) {
+			cancel(eventIds[i]);
+		}
+
+		for (int64_t now = start; now <= start + MAX_DELAY; now += SCHEDULER_MINTICKS) {
+			expire(now);
+		}
+
+		return bm.duration();
+	}
+}
+
+suite<"scheduling"> timerWheelBenchmark = [] {
+	UPDATE_OTSYS_TIME();
+
+	test("TimerWheel against the heap scheduler") = [] {
+		const auto delays = generateDelays();
+		size_t heapExecuted = 0;
+		size_t wheelExecuted = 0;
+
+		HeapScheduler heap;
+		const double heapDuration = run(
+			delays,
+			[&](uint32_t delay) { return heap.schedule(Task([&heapExecuted] { ++heapExecuted; }, "HeapScheduler", delay, false, false)); },
+			[&](uint64_t eventId) { heap.cancel(eventId); },
+			[&](int64_t now) { heap.expire(now); }
+		);
+
+		TimerWheel wheel { SCHEDULER_MINTICKS };
+		const double wheelDuration = run(
+			delays,
+			[&](uint32_t delay) {
+				const auto eventId = wheel.create(Task([&wheelExecuted] { ++wheelExecuted; }, "TimerWheel", delay, false, false));
+				wheel.insert(eventId, OTSYS_TIME());
+				return eventId;
+			},
+			[&](uint64_t eventId) { wheel.cancel(eventId, true); },
+			[&](int64_t now) {
+				wheel.expire(now, [](Task &task) {
+					task.execute();
+					return false;
+				});
+			}
+		);
+
+		fmt::print("[TimerWheel] {} tasks: heap {:.2f}ms, timer wheel {:.2f}ms\n", TASKS, heapDuration, wheelDuration);
+
+		expect(heap.empty() and wheel.empty());
+		expect(eq(heapExecuted, wheelExecuted));
+	};
+};
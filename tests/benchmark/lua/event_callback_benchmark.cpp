@@ -0,0 +1,62 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "game/zones/zone.hpp"
+#include "lua/callbacks/event_callback.hpp"
+#include "lua/callbacks/events_callbacks.hpp"
+#include "lua/scripts/luascript.hpp"
+#include "utils/benchmark.hpp"
+
+using namespace boost::ut;
+
+namespace {
+	constexpr size_t EVENTS = 100000;
+
+	std::shared_ptr<EventCallback> createHandler(LuaScriptInterface &scriptInterface) {
+		lua_State* L = scriptInterface.getLuaState();
+		luaL_loadstring(L, "return function(zone, creature) return true end");
+		lua_pcall(L, 0, 1, 0);
+
+		auto callback = std::make_shared<EventCallback>(&scriptInterface);
+		callback->setScriptTypeName("benchmark");
+		callback->setType(EventCallback_t::zoneBeforeCreatureEnter);
+		callback->loadCallback();
+		return callback;
+	}
+}
+
+suite<"lua"> eventCallbackBenchmark = [] {
+	test("EventCallback dispatch with 0, 1 and 10 handlers") = [] {
+		LuaScriptInterface scriptInterface("Event Callback Benchmark");
+		expect(scriptInterface.initState());
+
+		for (const size_t handlers : { 0, 1, 10 }) {
+			EventsCallbacks callbacks;
+			for (size_t i = 0; i < handlers; ++i) {
+				callbacks.addCallback(createHandler(scriptInterface));
+			}
+
+			const std::shared_ptr<Zone> zone;
+			const std::shared_ptr<Creature> creature;
+			size_t allowed = 0;
+
+			Benchmark bm;
+			for (size_t i = 0; i < EVENTS; ++i) {
+				allowed += callbacks.checkCallback(EventCallback_t::zoneBeforeCreatureEnter, &EventCallback::zoneBeforeCreatureEnter, zone, creature);
+			}
+			const double duration = bm.duration();
+
+			fmt::print("[EventCallback] {} handlers: {} events in {:.2f}ms, {:.1f}ns per event\n", handlers, EVENTS, duration, duration * 1e6 / EVENTS);
+			expect(eq(allowed, EVENTS));
+		}
+	};
+};
@@ -0,0 +1,55 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "security/xtea.hpp"
+#include "utils/benchmark.hpp"
+
+using namespace boost::ut;
+
+namespace {
+	// Game packets are mostly small, the benchmark encrypts many of them instead of one big buffer.
+	constexpr size_t PACKET_SIZE = 512;
+	constexpr size_t PACKETS = 20000;
+
+	double run(std::vector<uint8_t> &data, const xtea::Key &key, SimdLevel level) {
+		Benchmark bm;
+		for (size_t offset = 0; offset < data.size(); offset += PACKET_SIZE) {
+			xtea::encrypt(data.data() + offset, PACKET_SIZE, key, level);
+		}
+		for (size_t offset = 0; offset < data.size(); offset += PACKET_SIZE) {
+			xtea::decrypt(data.data() + offset, PACKET_SIZE, key, level);
+		}
+		return bm.duration();
+	}
+}
+
+suite<"security"> xteaBenchmark = [] {
+	test("XTEA kernels throughput") = [] {
+		const xtea::Key key = { 0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210 };
+		std::vector<uint8_t> plain(PACKET_SIZE * PACKETS);
+		std::mt19937 generator(11);
+		std::ranges::generate(plain, [&generator] { return static_cast<uint8_t>(generator()); });
+
+		for (const auto level : { SimdLevel::Scalar, SimdLevel::NEON, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+			if (!isSimdLevelSupported(level)) {
+				continue;
+			}
+
+			auto data = plain;
+			const double duration = run(data, key, level);
+			const double megabytes = static_cast<double>(plain.size() * 2) / (1024 * 1024);
+			fmt::print("[XTEA] level {}: {} packets of {} bytes in {:.2f}ms, {:.1f} MB/s\n", static_cast<int>(level), PACKETS, PACKET_SIZE, duration, megabytes / (duration / 1000));
+
+			expect(data == plain);
+		}
+	};
+};
@@ -159,4 +159,19 @@ int main() {
 		// sessionExpires is not saved
 		expect(eq(acc2.sessionExpires, 0));
 	});
+
+	test("Database statements send binary values without escaping") = databaseTest(db, [&db] {
+		const std::string key { "statement-test" };
+		const std::string value { "a'b\0c\\d", 7 };
+		expect(db.executeStatement("INSERT INTO `kv_store` (`key_name`, `timestamp`, `value`) VALUES (?, ?, ?)", { key, uint64_t { 1337 }, value }));
+
+		DBResult_ptr result = db.storeStatement("SELECT `timestamp`, `value` FROM `kv_store` WHERE `key_name` = ?", { key });
+		expect(eq(result != nullptr, true) >> fatal);
+		expect(eq(result->countResults(), size_t { 1 }));
+		expect(eq(result->getNumber<uint64_t>("timestamp"), uint64_t { 1337 }));
+
+		unsigned long size = 0;
+		const char* data = result->getStream("value", size);
+		expect(eq(std::string(data, size), value));
+	});
 }
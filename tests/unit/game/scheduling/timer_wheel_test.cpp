@@ -0,0 +1,123 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "game/scheduling/timer_wheel.hpp"
+#include "utils/tools.hpp"
+
+using namespace boost::ut;
+
+namespace {
+	constexpr uint32_t TICK_MS = 50;
+
+	uint64_t schedule(TimerWheel &wheel, uint32_t delay, std::function<void(void)> &&f) {
+		const auto eventId = wheel.create(Task(std::move(f), "TimerWheelTest", delay, false, false));
+		wheel.insert(eventId, OTSYS_TIME());
+		return eventId;
+	}
+
+	void expire(TimerWheel &wheel, int64_t now) {
+		wheel.expire(now, [](Task &task) {
+			task.execute();
+			return false;
+		});
+	}
+}
+
+suite<"scheduling"> timerWheelTest = [] {
+	UPDATE_OTSYS_TIME();
+
+	test("TimerWheel executes tasks in time order once they are due") = [] {
+		TimerWheel wheel { TICK_MS };
+		const auto start = OTSYS_TIME();
+		std::vector<uint32_t> executed;
+
+		for (const uint32_t delay : { 120u, 10u, 3000u, 0u, 49u, 51u }) {
+			schedule(wheel, delay, [&executed, delay] { executed.emplace_back(delay); });
+		}
+
+		expire(wheel, start + 50);
+		expect(eq(std::vector<uint32_t> { 0, 10, 49 }, executed));
+
+		expire(wheel, start + 3000);
+		expect(eq(std::vector<uint32_t> { 0, 10, 49, 51, 120, 3000 }, executed));
+		expect(wheel.empty());
+	};
+
+	test("TimerWheel cascades tasks scheduled beyond the first level") = [] {
+		TimerWheel wheel { TICK_MS };
+		const auto start = OTSYS_TIME();
+		std::vector<uint32_t> executed;
+
+		for (const uint32_t delay : { 60 * 60 * 1000u, 15 * 60 * 1000u, 20 * 1000u }) {
+			schedule(wheel, delay, [&executed, delay] { executed.emplace_back(delay); });
+		}
+
+		expire(wheel, start + 20 * 1000 - 1);
+		expect(executed.empty());
+
+		for (int64_t now = start; now <= start + 60 * 60 * 1000; now += 1000) {
+			expire(wheel, now);
+		}
+		expect(eq(std::vector<uint32_t> { 20 * 1000, 15 * 60 * 1000, 60 * 60 * 1000 }, executed));
+	};
+
+	test("TimerWheel does not execute cancelled tasks") = [] {
+		TimerWheel wheel { TICK_MS };
+		const auto start = OTSYS_TIME();
+		uint32_t executed = 0;
+
+		const auto ownerCancelled = schedule(wheel, 100, [&executed] { ++executed; });
+		const auto otherThreadCancelled = schedule(wheel, 100, [&executed] { ++executed; });
+		const auto kept = schedule(wheel, 100, [&executed] { ++executed; });
+
+		expect(wheel.cancel(ownerCancelled, true));
+		expect(wheel.cancel(otherThreadCancelled, false));
+		expect(not wheel.cancel(ownerCancelled, true)) << "an event can only be cancelled once";
+
+		expire(wheel, start + 100);
+		expect(eq(1u, executed));
+		expect(not wheel.cancel(kept, true)) << "executed events can't be cancelled";
+	};
+
+	test("TimerWheel reuses entries without accepting stale event ids") = [] {
+		TimerWheel wheel { TICK_MS };
+		const auto start = OTSYS_TIME();
+		uint32_t executed = 0;
+
+		const auto first = schedule(wheel, 0, [&executed] { ++executed; });
+		expire(wheel, start);
+
+		const auto second = schedule(wheel, 0, [&executed] { ++executed; });
+		expect(neq(first, second));
+		expect(not wheel.cancel(first, true));
+
+		expire(wheel, start);
+		expect(eq(2u, executed));
+	};
+
+	test("TimerWheel reschedules cycle tasks") = [] {
+		TimerWheel wheel { TICK_MS };
+		const auto start = OTSYS_TIME();
+		uint32_t executed = 0;
+
+		schedule(wheel, 0, [&executed] { ++executed; });
+		for (int64_t now = start; now < start + 5; ++now) {
+			wheel.expire(now, [](Task &task) {
+				task.execute();
+				return true;
+			});
+		}
+
+		expect(eq(5u, executed));
+		expect(eq(size_t { 1 }, wheel.size()));
+	};
+};
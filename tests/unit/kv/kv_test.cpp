@@ -125,4 +125,38 @@ suite<"kv"> kvTest = [] {
 			  kv.remove("key2");
 			  expect(!kv.get("key2").has_value());
 		  };
+
+	test("Keys by prefix") = [&injectionFixture] {
+		auto [kv] = injectionFixture.get<KVStore>();
+		kv.set("prefix-test.a", 1);
+		kv.set("prefix-test.b", 2);
+		kv.set("prefix-tests.c", 3);
+		kv.remove("prefix-test.b");
+		expect(kv.keys("prefix-test.") == std::unordered_set<std::string> { "a" });
+		expect(kv.scoped("prefix-test")->keys() == std::unordered_set<std::string> { "a" });
+	};
+
+	test("Memory limit unloads least recently used keys") = [&injectionFixture] {
+		auto [kv] = injectionFixture.get<KVStore>();
+		kv.setMemoryLimit(4096);
+		for (int i = 0; i < 100; ++i) {
+			kv.set(fmt::format("memory-test.{}", i), std::string(64, 'x'));
+		}
+		expect(le(kv.getMemoryUsage(), size_t { 4096 }));
+		expect(!kv.get("memory-test.0").has_value());
+		expect(eq(kv.get("memory-test.99")->get<std::string>(), std::string(64, 'x')));
+		kv.setMemoryLimit(KVStore::DEFAULT_MEMORY_LIMIT);
+	};
+
+	test("Key index counts against the memory limit") = [&injectionFixture] {
+		auto [kv] = injectionFixture.get<KVStore>();
+		kv.setMemoryLimit(4096);
+		expect(kv.keys("index-test.").empty());
+		for (int i = 0; i < 100; ++i) {
+			kv.set(fmt::format("index-test.{}", i), i);
+		}
+		expect(le(kv.getMemoryUsage(), size_t { 4096 }));
+		expect(kv.keys("index-test.").contains("99"));
+		kv.setMemoryLimit(KVStore::DEFAULT_MEMORY_LIMIT);
+	};
 };
@@ -0,0 +1,93 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "lua/scripts/lua_worker_pool.hpp"
+
+using namespace boost::ut;
+
+suite<"lua"> luaWorkerPoolTest = [] {
+	test("Worker values round trip through a lua state") = [] {
+		lua_State* L = luaL_newstate();
+
+		const LuaWorkerValues values = {
+			ValueWrapper(true),
+			ValueWrapper(42.5),
+			ValueWrapper(std::string("loot")),
+			ValueWrapper(ArrayType { ValueWrapper(1.0), ValueWrapper(2.0) }),
+			std::nullopt,
+		};
+
+		for (const auto &value : values) {
+			LuaWorkerPool::pushValue(L, value);
+		}
+		expect(eq(lua_gettop(L), static_cast<int>(values.size())));
+
+		for (size_t i = 0; i < values.size(); ++i) {
+			const auto result = LuaWorkerPool::getValue(L, static_cast<int>(i + 1));
+			expect(eq(result.has_value(), values[i].has_value()));
+			if (result && values[i]) {
+				expect(*result == *values[i]);
+			}
+		}
+
+		lua_close(L);
+	};
+
+	test("Worker values keep table fields") = [] {
+		lua_State* L = luaL_newstate();
+		LuaWorkerPool::pushValue(L, ValueWrapper({ { "chance", ValueWrapper(0.25) }, { "name", ValueWrapper(std::string("gold coin")) } }));
+
+		const auto result = LuaWorkerPool::getValue(L, -1);
+		expect(result.has_value());
+		expect(eq(result->get<double>("chance"), 0.25));
+		expect(eq(result->get<std::string>("name"), std::string("gold coin")));
+
+		lua_close(L);
+	};
+
+	test("Worker values convert numeric table keys to strings") = [] {
+		lua_State* L = luaL_newstate();
+		luaL_dostring(L, "return { [10] = 'a', x = 'b' }");
+
+		const auto result = LuaWorkerPool::getValue(L, -1);
+		expect(result.has_value());
+		expect(eq(result->get<std::string>("10"), std::string("a")));
+		expect(eq(result->get<std::string>("x"), std::string("b")));
+
+		lua_close(L);
+	};
+
+	test("Worker values keep both parts of a mixed table") = [] {
+		lua_State* L = luaL_newstate();
+		luaL_dostring(L, "return { 'a', 'b', x = 'c' }");
+
+		const auto result = LuaWorkerPool::getValue(L, -1);
+		expect(result.has_value());
+		expect(eq(result->get<std::string>("1"), std::string("a")));
+		expect(eq(result->get<std::string>("2"), std::string("b")));
+		expect(eq(result->get<std::string>("x"), std::string("c")));
+
+		lua_close(L);
+	};
+
+	test("Worker values convert a table that contains itself as nil") = [] {
+		lua_State* L = luaL_newstate();
+		luaL_dostring(L, "local t = { x = 'a' } t.self = t return t");
+
+		const auto result = LuaWorkerPool::getValue(L, -1);
+		expect(result.has_value());
+		expect(eq(result->get<std::string>("x"), std::string("a")));
+		expect(!result->get("self").has_value());
+
+		lua_close(L);
+	};
+};
@@ -0,0 +1,220 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "map/utils/hpastar.hpp"
+
+using namespace boost::ut;
+
+namespace {
+	// A 64 x 64 floor made of 4 x 4 clusters, nothing outside of it is walkable.
+	struct Floor {
+		static constexpr uint16_t ORIGIN = 1024;
+		static constexpr uint16_t SIZE = 64;
+		static constexpr uint8_t Z = 7;
+
+		std::vector<bool> blocked = std::vector<bool>(SIZE * SIZE, false);
+
+		static Position at(uint16_t x, uint16_t y) {
+			return Position(ORIGIN + x, ORIGIN + y, Z);
+		}
+
+		void setBlocked(const Position &pos, bool value) {
+			blocked[(pos.y - ORIGIN) * SIZE + (pos.x - ORIGIN)] = value;
+		}
+
+		bool isWalkable(uint16_t x, uint16_t y, uint8_t z) const {
+			if (z != Z || x < ORIGIN || y < ORIGIN || x >= ORIGIN + SIZE || y >= ORIGIN + SIZE) {
+				return false;
+			}
+			return !blocked[(y - ORIGIN) * SIZE + (x - ORIGIN)];
+		}
+
+		HPAStar::WalkableCall walkable() const {
+			return [this](uint16_t x, uint16_t y, uint8_t z) {
+				return isWalkable(x, y, z);
+			};
+		}
+
+		// Cheapest walk over the whole floor with the costs of the cluster graph, -1 when unreachable.
+		int32_t getOptimalCost(const Position &startPos, const Position &targetPos) const {
+			std::vector<int32_t> costs(SIZE * SIZE, -1);
+			using QueueEntry = std::pair<int32_t, uint32_t>;
+			std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+
+			const uint32_t start = (startPos.y - ORIGIN) * SIZE + (startPos.x - ORIGIN);
+			const uint32_t target = (targetPos.y - ORIGIN) * SIZE + (targetPos.x - ORIGIN);
+			costs[start] = 0;
+			queue.emplace(0, start);
+
+			while (!queue.empty()) {
+				const auto [cost, cell] = queue.top();
+				queue.pop();
+				if (cell == target) {
+					return cost;
+				}
+				if (cost != costs[cell]) {
+					continue;
+				}
+
+				const int32_t x = cell % SIZE;
+				const int32_t y = cell / SIZE;
+				for (int32_t dy = -1; dy <= 1; ++dy) {
+					for (int32_t dx = -1; dx <= 1; ++dx) {
+						if ((dx == 0 && dy == 0) || !isWalkable(ORIGIN + x + dx, ORIGIN + y + dy, Z)) {
+							continue;
+						}
+
+						const uint32_t neighbor = (y + dy) * SIZE + (x + dx);
+						const int32_t newCost = cost + (dx != 0 && dy != 0 ? 14 : 10);
+						if (costs[neighbor] == -1 || newCost < costs[neighbor]) {
+							costs[neighbor] = newCost;
+							queue.emplace(newCost, neighbor);
+						}
+					}
+				}
+			}
+			return -1;
+		}
+	};
+
+	// Every stretch between waypoints is refined by the bounded A*, so none may be longer than a cluster.
+	bool hasShortStretches(const Position &startPos, const Position &targetPos, const std::vector<Position> &waypoints) {
+		Position current = startPos;
+		for (const auto &waypoint : waypoints) {
+			if (std::max(Position::getDistanceX(current, waypoint), Position::getDistanceY(current, waypoint)) >= HPAStar::CLUSTER_SIZE) {
+				return false;
+			}
+			current = waypoint;
+		}
+		return std::max(Position::getDistanceX(current, targetPos), Position::getDistanceY(current, targetPos)) < HPAStar::CLUSTER_SIZE;
+	}
+
+	// Vertical wall across the floor with a single gap.
+	void buildWall(Floor &floor, uint16_t x, uint16_t gapY) {
+		for (uint16_t y = 0; y < Floor::SIZE; ++y) {
+			floor.setBlocked(Floor::at(x, y), y != gapY);
+		}
+	}
+}
+
+suite<"map"> hpaStarTest = [] {
+	test("HPAStar abstract path on an open floor stays close to the optimal one") = [] {
+		Floor floor;
+		HPAStar hpaStar;
+		std::vector<Position> waypoints;
+
+		for (const auto &[startPos, targetPos] : { std::pair { Floor::at(2, 2), Floor::at(60, 60) }, std::pair { Floor::at(2, 6), Floor::at(61, 9) } }) {
+			const int32_t optimal = floor.getOptimalCost(startPos, targetPos);
+			const int32_t cost = hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints);
+			expect(ge(cost, optimal));
+			expect(le(cost * 10, optimal * 13));
+			expect(hasShortStretches(startPos, targetPos, waypoints));
+		}
+	};
+
+	test("HPAStar abstract path goes through the only gap of a wall") = [] {
+		Floor floor;
+		HPAStar hpaStar;
+		std::vector<Position> waypoints;
+		const Position startPos = Floor::at(5, 5);
+		const Position targetPos = Floor::at(60, 5);
+
+		buildWall(floor, 40, 50);
+		const int32_t cost = hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints);
+		expect(ge(cost, floor.getOptimalCost(startPos, targetPos)));
+		expect(hasShortStretches(startPos, targetPos, waypoints));
+		expect(std::ranges::any_of(waypoints, [](const Position &pos) { return pos.y >= 48 + Floor::ORIGIN; }));
+	};
+
+	test("HPAStar finds no abstract path through a closed wall") = [] {
+		Floor floor;
+		HPAStar hpaStar;
+		std::vector<Position> waypoints;
+
+		buildWall(floor, 40, Floor::SIZE);
+		expect(eq(-1, hpaStar.findWaypoints(floor.walkable(), Floor::at(5, 5), Floor::at(60, 5), waypoints)));
+	};
+
+	test("HPAStar rebuilds the cluster of an invalidated position") = [] {
+		Floor floor;
+		HPAStar hpaStar;
+		std::vector<Position> waypoints;
+		const Position startPos = Floor::at(5, 5);
+		const Position targetPos = Floor::at(60, 5);
+		const Position gap = Floor::at(40, 50);
+
+		buildWall(floor, 40, 50);
+		expect(neq(-1, hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints)));
+
+		// The cached cluster still has the gap until it is invalidated
+		floor.setBlocked(gap, true);
+		expect(neq(-1, hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints)));
+
+		hpaStar.invalidate(gap);
+		expect(eq(-1, hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints)));
+	};
+
+	test("HPAStar drops every cluster once the invalidation suspension ends") = [] {
+		Floor floor;
+		HPAStar hpaStar;
+		std::vector<Position> waypoints;
+		const Position startPos = Floor::at(5, 5);
+		const Position targetPos = Floor::at(60, 5);
+		const Position gap = Floor::at(40, 50);
+
+		buildWall(floor, 40, 50);
+		expect(neq(-1, hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints)));
+
+		{
+			HPAStar::InvalidationSuspension suspension(hpaStar);
+			{
+				HPAStar::InvalidationSuspension nested(hpaStar);
+				floor.setBlocked(gap, true);
+				hpaStar.invalidate(gap);
+			}
+			expect(neq(-1, hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints)));
+		}
+
+		expect(eq(-1, hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints)));
+	};
+
+	test("HPAStar abstract paths match the reachability of the full search") = [] {
+		std::mt19937 rng(7);
+		for (uint32_t i = 0; i < 100; ++i) {
+			Floor floor;
+			for (size_t cell = 0; cell < floor.blocked.size(); ++cell) {
+				floor.blocked[cell] = rng() % 100 < 15;
+			}
+
+			const Position startPos = Floor::at(rng() % Floor::SIZE, rng() % Floor::SIZE);
+			const Position targetPos = Floor::at(rng() % Floor::SIZE, rng() % Floor::SIZE);
+			if (!HPAStar::isLongDistance(startPos, targetPos)) {
+				continue;
+			}
+			floor.setBlocked(startPos, false);
+			floor.setBlocked(targetPos, false);
+
+			HPAStar hpaStar;
+			std::vector<Position> waypoints;
+			const int32_t optimal = floor.getOptimalCost(startPos, targetPos);
+			const int32_t cost = hpaStar.findWaypoints(floor.walkable(), startPos, targetPos, waypoints);
+			if (optimal == -1) {
+				expect(eq(-1, cost));
+				continue;
+			}
+
+			expect(ge(cost, optimal)) << startPos.toString() << " to " << targetPos.toString();
+			expect(le(cost * 10, optimal * 13)) << startPos.toString() << " to " << targetPos.toString();
+			expect(hasShortStretches(startPos, targetPos, waypoints));
+		}
+	};
+};
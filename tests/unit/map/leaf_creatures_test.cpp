@@ -0,0 +1,47 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "creatures/monsters/monster.hpp"
+#include "creatures/monsters/monsters.hpp"
+#include "map/utils/qtreenode.hpp"
+
+using namespace boost::ut;
+
+suite<"map"> leafCreaturesTest = [] {
+	const auto mType = std::make_shared<MonsterType>("leaf test");
+
+	test("LeafCreatures counts creatures per floor") = [&mType] {
+		LeafCreatures leaf;
+		const auto first = std::make_shared<Monster>(mType);
+		const auto second = std::make_shared<Monster>(mType);
+
+		expect(!leaf.hasOnFloors(0, MAP_MAX_LAYERS - 1));
+
+		leaf.add(first, Position(100, 100, 7));
+		leaf.add(second, Position(101, 100, 9));
+		expect(leaf.hasOnFloors(7, 7));
+		expect(leaf.hasOnFloors(8, 9));
+		expect(!leaf.hasOnFloors(0, 6));
+		expect(!leaf.hasOnFloors(10, MAP_MAX_LAYERS - 1));
+
+		leaf.update(second, Position(101, 100, 12));
+		expect(!leaf.hasOnFloors(8, 9));
+		expect(leaf.hasOnFloors(10, 12));
+
+		expect(leaf.remove(first));
+		expect(!leaf.hasOnFloors(0, 7));
+		expect(!leaf.remove(first));
+
+		expect(leaf.remove(second));
+		expect(!leaf.hasOnFloors(0, MAP_MAX_LAYERS - 1));
+	};
+};
@@ -0,0 +1,53 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2024 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#include "pch.hpp"
+
+#include <boost/ut.hpp>
+
+#include "security/xtea.hpp"
+
+using namespace boost::ut;
+
+suite<"security"> xteaTest = [] {
+	const xtea::Key key = { 0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210 };
+
+	test("XTEA vector kernels match the scalar one") = [&key] {
+		std::mt19937 generator(8);
+		for (const auto level : { SimdLevel::NEON, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+			if (!isSimdLevelSupported(level)) {
+				continue;
+			}
+
+			// Lengths that leave blocks for every narrower kernel
+			for (const size_t blocks : { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 100 }) {
+				std::vector<uint8_t> plain(blocks * 8);
+				std::ranges::generate(plain, [&generator] { return static_cast<uint8_t>(generator()); });
+
+				auto expected = plain;
+				xtea::encrypt(expected.data(), expected.size(), key, SimdLevel::Scalar);
+
+				auto data = plain;
+				xtea::encrypt(data.data(), data.size(), key, level);
+				expect(data == expected) << "encrypt, level" << static_cast<int>(level) << "blocks" << blocks;
+
+				xtea::decrypt(data.data(), data.size(), key, level);
+				expect(data == plain) << "decrypt, level" << static_cast<int>(level) << "blocks" << blocks;
+			}
+		}
+	};
+
+	test("XTEA scalar round trip") = [&key] {
+		const std::vector<uint8_t> plain = { 'c', 'a', 'n', 'a', 'r', 'y', 0, 0 };
+		auto data = plain;
+		xtea::encrypt(data.data(), data.size(), key, SimdLevel::Scalar);
+		expect(data != plain);
+		xtea::decrypt(data.data(), data.size(), key, SimdLevel::Scalar);
+		expect(data == plain);
+	};
+};